@@ -5,10 +5,11 @@
 #include "../../src/Obj/VectorObj.hpp"
 #include "../../src/LinearAlgebra/Preconditioner/MultiGrid.hpp"
 #include "../../src/LinearAlgebra/Krylov/GMRES.hpp"
+#include "../../src/LinearAlgebra/Solver/SolverMonitor.hpp"
 #include <cmath>
 #include <functional>
 #include <stdexcept>
-#include <iostream>
+#include <string>
 
 template<typename TNum>
 class VorticityStreamSolver {
@@ -29,13 +30,15 @@ private:
     VectorObj<TNum> u_velocity;
     VectorObj<TNum> v_velocity;
 
-    // Solver components
-    AlgebraicMultiGrid<TNum, VectorObj<TNum>> multigrid;
+    // Solver components: one AMG hierarchy per constant matrix, built once in the constructor
+    AlgebraicMultiGrid<TNum, VectorObj<TNum>> poisson_mg;
+    AlgebraicMultiGrid<TNum, VectorObj<TNum>> diffusion_mg;
     int mg_levels = 7;
     int mg_smoothing_steps = 1000;
     TNum mg_theta = 0.3;
     int mg_max_cycles = 150;
     TNum mg_tolerance = 1e-5;
+    SolverMonitor* monitor = nullptr;
 
     void buildLaplacianMatrix() {
         const int n = nx * ny;
@@ -176,6 +179,18 @@ private:
         return dt * max_vel * std::max(1.0/dx, 1.0/dy);
     }
 
+    // ||w - prev|| / ||w|| of the vorticity over one time step
+    TNum relativeChange(const VectorObj<TNum>& prev) const {
+        TNum l2_err = 0.0;
+        TNum l2_val = 0.0;
+        for (size_t i = 0; i < vorticity.size(); ++i) {
+            const TNum diff = vorticity[i] - prev[i];
+            l2_err += diff * diff;
+            l2_val += vorticity[i] * vorticity[i];
+        }
+        return l2_val > 0.0 ? std::sqrt(l2_err / l2_val) : std::sqrt(l2_err);
+    }
+
     bool checkConvergence(const VectorObj<TNum>& prev) const {
         TNum max_err = 0.0;
         TNum max_val = 1e-10;
@@ -211,10 +226,17 @@ public:
         v_velocity = VectorObj<TNum>(n, 0.0);
 
         buildLaplacianMatrix(); // Builds both laplacian and diffusion_matrix
+        poisson_mg.setup(laplacian, mg_levels, mg_theta);
+        diffusion_mg.setup(diffusion_matrix, mg_levels, mg_theta);
         updateBoundaryConditions();
     }
 
+    // Record the relative vorticity change of every time step into `m` (not owned)
+    void setMonitor(SolverMonitor& m) { monitor = &m; }
+
     bool solve(TNum dt, int max_steps) {
+        TNum change = 0.0;
+        if (monitor) monitor->start();
         VectorObj<TNum> poisson_rhs(nx*ny);
         VectorObj<TNum> residual(nx*ny);
         VectorObj<TNum> convection_term_vec(nx*ny);
@@ -234,8 +256,7 @@ public:
             bool poisson_converged = false;
             int poisson_cycles = 0;
             for (int cycle = 0; cycle < mg_max_cycles; ++cycle) {
-                multigrid.amgVCycle(laplacian, poisson_rhs, streamFunction,
-                                    mg_levels, mg_smoothing_steps, mg_theta);
+                poisson_mg.vcycle(poisson_rhs, streamFunction, mg_smoothing_steps);
                 poisson_cycles++;
 
                 residual = poisson_rhs - (laplacian * streamFunction);
@@ -281,8 +302,7 @@ public:
             bool diffusion_converged = false;
             int diffusion_cycles = 0;
             for (int cycle = 0; cycle < diffusion_mg_max_cycles; ++cycle) {
-                multigrid.amgVCycle(diffusion_matrix, rhs_vorticity, vorticity,
-                                    mg_levels, diffusion_mg_smoothing_steps, mg_theta);
+                diffusion_mg.vcycle(rhs_vorticity, vorticity, diffusion_mg_smoothing_steps);
                 diffusion_cycles++;
 
                 residual = rhs_vorticity - (diffusion_matrix * vorticity);
@@ -304,15 +324,16 @@ public:
             updateBoundaryConditions();
 
             // --- Convergence check ---
-            if (step % 100 == 0) {
-                if (checkConvergence(old_vorticity)) {
-                    std::cout << "Converged after " << step << " steps\n";
-                    return true;
-                }
-                std::cout << "Step " << step << ", CFL = " << cfl
-                          << ", dt = " << dt << std::endl;
+            if (monitor) {
+                change = relativeChange(old_vorticity);
+                monitor->record(SolverMonitor::Event::Iteration, step, change);
+            }
+            if (step % 100 == 0 && checkConvergence(old_vorticity)) {
+                if (monitor) monitor->record(SolverMonitor::Event::Converged, step, change);
+                return true;
             }
         }
+        if (monitor) monitor->record(SolverMonitor::Event::MaxIterations, max_steps, change);
         return false;
     }
 
@@ -325,6 +346,8 @@ public:
     TNum getDy() const noexcept { return dy; }
     int getNx() const noexcept { return nx; }
     int getNy() const noexcept { return ny; }
+    const AlgebraicMultiGrid<TNum, VectorObj<TNum>>& getPoissonHierarchy() const noexcept { return poisson_mg; }
+    const AlgebraicMultiGrid<TNum, VectorObj<TNum>>& getDiffusionHierarchy() const noexcept { return diffusion_mg; }
 };
 
 #endif // VORTICITYSTREAMSOLVER_HPP
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "../application/CFD/VorticityStreamSolver.hpp"
 #include <fstream>
+#include <iostream>
 #include <iomanip>
 #include <sstream>
 #include <string>
@@ -76,6 +77,8 @@ int main() {
 
     // Create solver
     VorticityStreamSolver<double> solver(nx, ny, Re, U, tolerance, cfl_limit);
+    SolverMonitor monitor;
+    solver.setMonitor(monitor);
 
     // Solve and output results periodically
     bool converged = false;
@@ -98,6 +101,10 @@ int main() {
         }
     }
 
+    // Vorticity change per time step of the last solve call
+    std::ofstream history("output/cavity_history.csv");
+    monitor.writeCSV(history);
+
     if (converged) {
         std::cout << "Simulation converged successfully!" << std::endl;
     } else {
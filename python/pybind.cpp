@@ -72,6 +72,12 @@ PYBIND11_MODULE(fastsolver, m) {
     // MultiGrid Solver
     py::class_<AlgebraicMultiGrid<double, VectorObj<double>>>(m, "AlgebraicMultiGrid")
         .def(py::init<>())
+        .def("setup", &AlgebraicMultiGrid<double, VectorObj<double>>::setup,
+             "Build and store the AMG hierarchy for A.",
+             py::arg("A"), py::arg("levels"), py::arg("theta"))
+        .def("vcycle", &AlgebraicMultiGrid<double, VectorObj<double>>::vcycle,
+             "Perform one V-cycle with the stored hierarchy.",
+             py::arg("b"), py::arg("x"), py::arg("smoothingSteps"))
         .def("amgVCycle", &AlgebraicMultiGrid<double, VectorObj<double>>::amgVCycle,
              "Perform one V-cycle of Algebraic MultiGrid.",
              py::arg("A"), py::arg("b"), py::arg("x"), py::arg("levels"), py::arg("smoothingSteps"), py::arg("theta"));
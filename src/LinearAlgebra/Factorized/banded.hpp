@@ -0,0 +1,241 @@
+#ifndef BANDED_HPP
+#define BANDED_HPP
+
+#include <vector>
+#include <queue>
+#include <cmath>
+#include <stdexcept>
+#include <algorithm>
+#include "../../Obj/BandObj.hpp"
+#include "../../Obj/SparseObj.hpp"
+#include "../../Obj/VectorObj.hpp"
+
+/**
+ * @namespace banded
+ * @brief Direct solvers for band matrices stored in a BandObj
+ */
+namespace banded {
+
+    /**
+     * @brief In-place LU factorization with partial pivoting of a band matrix
+     *
+     * Follows LAPACK's gbtf2: L keeps kl sub-diagonals and U grows to kl + ku
+     * super-diagonals, which is exactly the room reserved by BandObj.
+     *
+     * @param A Band matrix; overwritten with the factors
+     * @param P Pivot rows, row j was interchanged with row P[j]
+     * @throws std::runtime_error if the matrix is singular or nearly singular
+     */
+    template <typename TNum>
+    void LU(BandObj<TNum>& A, std::vector<int>& P) {
+        const int n = A.getRows();
+        const int kl = A.getLower();
+        const int kv = A.getLower() + A.getUpper();
+        const int ld = A.ld();
+        TNum* ab = A.data();
+        // Entry (i, j) of the band
+        auto at = [&](int i, int j) -> TNum& { return ab[(kv + i - j) + static_cast<size_t>(j) * ld]; };
+
+        P.resize(n);
+        const TNum epsilon = static_cast<TNum>(1e-12);
+        int ju = 0; // Last column touched by the row interchanges so far
+
+        for (int j = 0; j < n; ++j) {
+            const int km = std::min(kl, n - 1 - j);
+
+            int jp = j;
+            TNum maxVal = std::abs(at(j, j));
+            for (int i = j + 1; i <= j + km; ++i) {
+                if (std::abs(at(i, j)) > maxVal) {
+                    maxVal = std::abs(at(i, j));
+                    jp = i;
+                }
+            }
+            P[j] = jp;
+            if (maxVal < epsilon) {
+                throw std::runtime_error("Matrix is singular or nearly singular and cannot be decomposed.");
+            }
+
+            ju = std::max(ju, std::min(n - 1, jp + A.getUpper()));
+            if (jp != j) {
+                for (int c = j; c <= ju; ++c) {
+                    std::swap(at(j, c), at(jp, c));
+                }
+            }
+
+            const TNum pivot = at(j, j);
+            for (int i = j + 1; i <= j + km; ++i) {
+                at(i, j) /= pivot;
+            }
+            for (int c = j + 1; c <= ju; ++c) {
+                const TNum ujc = at(j, c);
+                if (ujc == TNum(0)) continue;
+                for (int i = j + 1; i <= j + km; ++i) {
+                    at(i, c) -= at(i, j) * ujc;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Solve A x = b using the output of banded::LU
+     * @param LU Factorized band matrix
+     * @param P Pivot rows returned by banded::LU
+     * @param b Right-hand side, overwritten with the solution
+     */
+    template <typename TNum>
+    void LUSolve(const BandObj<TNum>& LU, const std::vector<int>& P, VectorObj<TNum>& b) {
+        const int n = LU.getRows();
+        if (static_cast<int>(b.size()) != n || static_cast<int>(P.size()) != n) {
+            throw std::invalid_argument("Vector size does not match matrix size");
+        }
+        const int kl = LU.getLower();
+        const int kv = LU.getLower() + LU.getUpper();
+        const int ld = LU.ld();
+        const TNum* ab = LU.data();
+        TNum* x = b.element();
+
+        // L y = P b
+        for (int j = 0; j < n; ++j) {
+            if (P[j] != j) std::swap(x[j], x[P[j]]);
+            const TNum* col = ab + static_cast<size_t>(j) * ld + kv - j;
+            for (int i = j + 1; i <= std::min(n - 1, j + kl); ++i) {
+                x[i] -= col[i] * x[j];
+            }
+        }
+        // U x = y
+        for (int j = n - 1; j >= 0; --j) {
+            const TNum* col = ab + static_cast<size_t>(j) * ld + kv - j;
+            x[j] /= col[j];
+            for (int i = std::max(0, j - kv); i < j; ++i) {
+                x[i] -= col[i] * x[j];
+            }
+        }
+    }
+
+    /**
+     * @brief In-place Cholesky factorization A = L L^T of a symmetric positive definite band matrix
+     *
+     * Only the lower band of A is referenced; it is overwritten with L. Runs in
+     * O(n * kl^2) time.
+     *
+     * @throws std::runtime_error if the matrix is not positive definite
+     */
+    template <typename TNum>
+    void Cholesky(BandObj<TNum>& A) {
+        const int n = A.getRows();
+        const int kd = A.getLower();
+        const int kv = A.getLower() + A.getUpper();
+        const int ld = A.ld();
+        TNum* ab = A.data();
+        auto at = [&](int i, int j) -> TNum& { return ab[(kv + i - j) + static_cast<size_t>(j) * ld]; };
+
+        for (int j = 0; j < n; ++j) {
+            TNum ajj = at(j, j);
+            if (ajj <= TNum(0)) {
+                throw std::runtime_error("Matrix is not positive definite");
+            }
+            ajj = std::sqrt(ajj);
+            at(j, j) = ajj;
+
+            const int kn = std::min(kd, n - 1 - j);
+            for (int i = j + 1; i <= j + kn; ++i) {
+                at(i, j) /= ajj;
+            }
+            // Symmetric rank-1 update of the trailing kn x kn block
+            for (int c = j + 1; c <= j + kn; ++c) {
+                const TNum lcj = at(c, j);
+                for (int i = c; i <= j + kn; ++i) {
+                    at(i, c) -= at(i, j) * lcj;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Solve A x = b using the output of banded::Cholesky
+     * @param L Band matrix holding the Cholesky factor in its lower band
+     * @param b Right-hand side, overwritten with the solution
+     */
+    template <typename TNum>
+    void CholeskySolve(const BandObj<TNum>& L, VectorObj<TNum>& b) {
+        const int n = L.getRows();
+        if (static_cast<int>(b.size()) != n) {
+            throw std::invalid_argument("Vector size does not match matrix size");
+        }
+        const int kd = L.getLower();
+        const int kv = L.getLower() + L.getUpper();
+        const int ld = L.ld();
+        const TNum* ab = L.data();
+        TNum* x = b.element();
+
+        for (int j = 0; j < n; ++j) {
+            const TNum* col = ab + static_cast<size_t>(j) * ld + kv - j;
+            x[j] /= col[j];
+            for (int i = j + 1; i <= std::min(n - 1, j + kd); ++i) {
+                x[i] -= col[i] * x[j];
+            }
+        }
+        for (int j = n - 1; j >= 0; --j) {
+            const TNum* col = ab + static_cast<size_t>(j) * ld + kv - j;
+            for (int i = j + 1; i <= std::min(n - 1, j + kd); ++i) {
+                x[j] -= col[i] * x[i];
+            }
+            x[j] /= col[j];
+        }
+    }
+
+    /**
+     * @brief Reverse Cuthill-McKee ordering of a structurally symmetric sparse matrix
+     *
+     * Returns perm such that the matrix B(i, j) = A(perm[i], perm[j]) has a small
+     * bandwidth; pass it to the permuting BandObj constructor. Each connected
+     * component is started from a vertex of minimum degree.
+     */
+    template <typename TNum>
+    std::vector<int> reverseCuthillMcKee(const SparseMatrixCSC<TNum>& A) {
+        const int n = A.getRows();
+        if (n != A.getCols()) {
+            throw std::invalid_argument("Matrix must be square for reordering.");
+        }
+        std::vector<int> degree(n);
+        for (int col = 0; col < n; ++col) {
+            degree[col] = A.col_ptr[col + 1] - A.col_ptr[col];
+        }
+
+        std::vector<int> order;
+        order.reserve(n);
+        std::vector<bool> visited(n, false);
+        std::vector<int> byDegree(n);
+        for (int i = 0; i < n; ++i) byDegree[i] = i;
+        std::stable_sort(byDegree.begin(), byDegree.end(), [&](int a, int b) { return degree[a] < degree[b]; });
+
+        std::vector<int> neighbors;
+        for (int start : byDegree) {
+            if (visited[start]) continue;
+            std::queue<int> queue;
+            queue.push(start);
+            visited[start] = true;
+            while (!queue.empty()) {
+                const int v = queue.front();
+                queue.pop();
+                order.push_back(v);
+                neighbors.clear();
+                for (int k = A.col_ptr[v]; k < A.col_ptr[v + 1]; ++k) {
+                    const int u = A.row_indices[k];
+                    if (!visited[u]) {
+                        visited[u] = true;
+                        neighbors.push_back(u);
+                    }
+                }
+                std::stable_sort(neighbors.begin(), neighbors.end(), [&](int a, int b) { return degree[a] < degree[b]; });
+                for (int u : neighbors) queue.push(u);
+            }
+        }
+        std::reverse(order.begin(), order.end());
+        return order;
+    }
+
+} // namespace banded
+
+#endif // BANDED_HPP
@@ -7,6 +7,7 @@
 #include <stdexcept>
 #include <limits>
 #include "../../Obj/DenseObj.hpp"
+#include "../../Obj/DenseView.hpp"
 #include "../../Obj/VectorObj.hpp"
 #include "../../utils.hpp"
 
@@ -147,10 +148,10 @@ namespace basic {
     }
 
     // QR factorization using Householder reflections
-    template <typename TNum, typename MatrixType>
-    void QR(const MatrixType& A, MatrixType& Q, MatrixType& R) {
+    template <typename TNum, typename MatrixType, typename InputType = MatrixType>
+    void QR(const InputType& A, MatrixType& Q, MatrixType& R) {
         int n = A.getRows(), m = A.getCols();
-        R = A;
+        R = MatrixType(A);
         Q = genUnitMat<TNum, MatrixType>(n);
 
         for (int i = 0; i < std::min(n, m); ++i) {
@@ -184,9 +185,49 @@ namespace basic {
         return x;
     }
 
+    /**
+     * @brief Triangular solve with a block of right-hand sides, T X = B
+     *
+     * Dense counterpart of Substitution for k right-hand sides at once: a single
+     * level-3 BLAS call (trsm), which is blocked and threaded by the BLAS library,
+     * instead of k separate substitutions.
+     *
+     * @param T Square triangular matrix; only the referenced triangle is read
+     * @param B Right-hand sides (n x k), overwritten with the solution X
+     * @param forward True for lower triangular T (forward substitution)
+     * @param unitDiagonal Assume ones on the diagonal of T without reading it
+     * @throws std::invalid_argument if the dimensions do not match
+     * @throws std::runtime_error if T has a zero on its diagonal
+     */
+    template <typename TNum>
+    void TriangularSolve(DenseView<const TNum> T, DenseView<TNum> B, bool forward, bool unitDiagonal = false) {
+        const int n = T.getRows();
+        if (n != T.getCols() || B.getRows() != n) {
+            throw std::invalid_argument("Matrix dimensions do not match for triangular solve.");
+        }
+        if (n == 0 || B.getCols() == 0) return;
+        if (!unitDiagonal) {
+            for (int i = 0; i < n; ++i) {
+                if (T(i, i) == static_cast<TNum>(0)) {
+                    throw std::runtime_error("Division by zero during substitution.");
+                }
+            }
+        }
+        blas::trsm(CblasColMajor, CblasLeft, forward ? CblasLower : CblasUpper, CblasNoTrans,
+                    unitDiagonal ? CblasUnit : CblasNonUnit,
+                    n, B.getCols(), 1.0, T.data(), T.ld(), B.data(), B.ld());
+    }
+
+    template <typename TNum>
+    DenseObj<TNum> TriangularSolve(const DenseObj<TNum>& T, const DenseObj<TNum>& B, bool forward, bool unitDiagonal = false) {
+        DenseObj<TNum> X = B;
+        TriangularSolve<TNum>(T.view(0, 0, T.getRows(), T.getCols()), X.view(0, 0, X.getRows(), X.getCols()), forward, unitDiagonal);
+        return X;
+    }
+
     // Cholesky factorization    
-    template <typename TNum = double , typename MatrixType = DenseObj<TNum>>
-    void Cholesky(const MatrixType& A, MatrixType& L) {
+    template <typename TNum = double , typename MatrixType = DenseObj<TNum>, typename InputType = MatrixType>
+    void Cholesky(const InputType& A, MatrixType& L) {
         int n = A.getRows();
         
         // Check if matrix is square
@@ -281,6 +322,96 @@ namespace basic {
         }
     }
 
+    /**
+     * @brief Right-looking blocked LU factorization with partial pivoting
+     *
+     * Produces the same factors and permutation as PivotLU, but only the narrow
+     * panels are factored column by column; the trailing matrix is updated with
+     * BLAS-3 (trsm and gemm) through views, so no block is ever copied.
+     *
+     * @param A Square matrix view; overwritten with unit-lower L and U
+     * @param P Permutation, P[i] is the original index of row i
+     * @param blockSize Panel width
+     * @throws std::invalid_argument if the matrix is not square or blockSize is not positive
+     * @throws std::runtime_error if the matrix is singular or nearly singular
+     */
+    template <typename TNum>
+    void BlockedLU(DenseView<TNum> A, std::vector<int>& P, int blockSize = 64) {
+        const int n = A.getRows();
+        if (n != A.getCols()) {
+            throw std::invalid_argument("Matrix must be square for LU decomposition.");
+        }
+        if (blockSize <= 0) {
+            throw std::invalid_argument("Block size must be positive.");
+        }
+
+        P.resize(n);
+        for (int i = 0; i < n; ++i) {
+            P[i] = i;
+        }
+
+        const TNum epsilon = static_cast<TNum>(1e-12);
+        TNum* a = A.data();
+        const int lda = A.ld();
+
+        for (int k = 0; k < n; k += blockSize) {
+            const int nb = std::min(blockSize, n - k);
+
+            // Unblocked factorization of the panel A(k:n, k:k+nb)
+            for (int j = k; j < k + nb; ++j) {
+                int maxIndex = j;
+                TNum maxVal = std::abs(a[j + j * lda]);
+                for (int i = j + 1; i < n; ++i) {
+                    if (std::abs(a[i + j * lda]) > maxVal) {
+                        maxVal = std::abs(a[i + j * lda]);
+                        maxIndex = i;
+                    }
+                }
+                if (maxIndex != j) {
+                    A.swapRows(j, maxIndex);
+                    std::swap(P[j], P[maxIndex]);
+                }
+                if (maxVal < epsilon) {
+                    throw std::runtime_error("Matrix is singular or nearly singular and cannot be decomposed.");
+                }
+
+                const TNum pivot = a[j + j * lda];
+                for (int i = j + 1; i < n; ++i) {
+                    a[i + j * lda] /= pivot;
+                }
+                if (j + 1 < k + nb && j + 1 < n) {
+                    blas::ger(CblasColMajor, n - j - 1, k + nb - j - 1, -1.0,
+                               a + (j + 1) + j * lda, 1,
+                               a + j + (j + 1) * lda, lda,
+                               a + (j + 1) + (j + 1) * lda, lda);
+                }
+            }
+
+            const int rest = n - k - nb;
+            if (rest > 0) {
+                DenseView<TNum> L11 = A.view(k, k, nb, nb);
+                DenseView<TNum> A12 = A.view(k, k + nb, nb, rest);
+                DenseView<TNum> L21 = A.view(k + nb, k, rest, nb);
+                DenseView<TNum> A22 = A.view(k + nb, k + nb, rest, rest);
+
+                // U12 = L11^{-1} A12
+                blas::trsm(CblasColMajor, CblasLeft, CblasLower, CblasNoTrans, CblasUnit,
+                            nb, rest, 1.0, L11.data(), L11.ld(), A12.data(), A12.ld());
+                // A22 -= L21 U12
+                blas::gemm(CblasColMajor, CblasNoTrans, CblasNoTrans,
+                            rest, rest, nb, -1.0,
+                            L21.data(), L21.ld(),
+                            A12.data(), A12.ld(),
+                            1.0, A22.data(), A22.ld());
+            }
+        }
+    }
+
+    template <typename TNum>
+    void BlockedLU(DenseObj<TNum>& A, std::vector<int>& P, int blockSize = 64) {
+        BlockedLU<TNum>(A.view(0, 0, A.getRows(), A.getCols()), P, blockSize);
+    }
+
     /**
      * @brief Singular Value Decomposition (SVD) of matrix A = U*S*V^T
      * @param A Input matrix (m x n)
@@ -289,8 +420,8 @@ namespace basic {
      * @param V Output right singular vectors (n x n)
      * @throws std::invalid_argument if matrix dimensions are invalid
      */
-    template <typename TNum, typename MatrixType>
-    void SVD(const MatrixType& A, MatrixType& U, MatrixType& S, MatrixType& V) {
+    template <typename TNum, typename MatrixType, typename InputType = MatrixType>
+    void SVD(const InputType& A, MatrixType& U, MatrixType& S, MatrixType& V) {
         const int m = A.getRows();
         const int n = A.getCols();
         
@@ -321,9 +452,9 @@ namespace basic {
         }
         
         // Compute A^T * A and A * A^T for eigendecomposition
-        MatrixType At = A.Transpose();
-        MatrixType AtA = At * A;  // For right singular vectors
-        MatrixType AAt = A * At;  // For left singular vectors
+        MatrixType At = MatrixType(A.Transpose());
+        MatrixType AtA = MatrixType(At * A);  // For right singular vectors
+        MatrixType AAt = MatrixType(A * At);  // For left singular vectors
         
         std::vector<VectorObj<TNum>> eigenVectorsV(n);
         std::vector<VectorObj<TNum>> eigenVectorsU(m);
@@ -0,0 +1,497 @@
+#ifndef BATCHED_HPP
+#define BATCHED_HPP
+
+#include <vector>
+#include <cmath>
+#include <string>
+#include <stdexcept>
+#include <algorithm>
+#include "../../Obj/BatchedDenseObj.hpp"
+
+/**
+ * @namespace batched
+ * @brief Factorizations and solves for many small, independent dense systems
+ *
+ * All routines operate on a BatchedDenseObj, whose interleaved layout keeps the
+ * same entry of consecutive systems contiguous. Every kernel runs the textbook
+ * algorithm once for a chunk of systems, with the innermost loop over the batch
+ * (vectorized), and the chunks are distributed over OpenMP threads.
+ */
+namespace batched {
+
+    namespace detail {
+        // Number of systems processed together by one thread. Chosen so that a
+        // chunk of n x m matrices stays within roughly 256 KB of cache.
+        template <typename TNum>
+        int chunkSize(int n, int m) {
+            const int entries = std::max(1, n * m);
+            int lanes = static_cast<int>((256 * 1024 / sizeof(TNum)) / entries);
+            lanes = std::max(8, (lanes / 8) * 8);
+            return std::min(lanes, 2048);
+        }
+
+        template <typename Kernel>
+        void forEachChunk(int batch, int lanes, Kernel kernel) {
+            const int chunks = (batch + lanes - 1) / lanes;
+            #pragma omp parallel for schedule(static)
+            for (int c = 0; c < chunks; ++c) {
+                kernel(c * lanes, std::min(batch, (c + 1) * lanes));
+            }
+        }
+
+        // Raise the error for the first failed system after the parallel region
+        inline void checkInfo(const std::vector<int>& info, const char* message) {
+            for (size_t k = 0; k < info.size(); ++k) {
+                if (info[k] != 0) {
+                    throw std::runtime_error(std::string(message) + " (system " + std::to_string(k) + ")");
+                }
+            }
+        }
+
+        template <typename TNum>
+        void checkRHS(int n, int batch, const BatchedDenseObj<TNum>& B) {
+            if (B.getRows() != n || B.getBatch() != batch) {
+                throw std::invalid_argument("Right-hand side batch does not match the factorization.");
+            }
+        }
+    } // namespace detail
+
+    /**
+     * @brief In-place LU factorization with partial pivoting of every matrix in the batch
+     * @param A Batch of square matrices; overwritten with unit-lower L and U
+     * @param P Pivot rows, P[j * batch + k] is the row swapped with row j of system k
+     * @throws std::invalid_argument if the matrices are not square
+     * @throws std::runtime_error if any system is singular or nearly singular
+     */
+    template <typename TNum>
+    void LU(BatchedDenseObj<TNum>& A, std::vector<int>& P) {
+        const int n = A.getRows();
+        const int bs = A.getBatch();
+        if (n != A.getCols()) {
+            throw std::invalid_argument("Matrices must be square for batched LU decomposition.");
+        }
+        P.assign(static_cast<size_t>(n) * bs, 0);
+        std::vector<int> info(bs, 0);
+        const TNum epsilon = static_cast<TNum>(1e-12);
+
+        detail::forEachChunk(bs, detail::chunkSize<TNum>(n, n), [&](int k0, int k1) {
+            const int len = k1 - k0;
+            std::vector<TNum> maxVal(len);
+            std::vector<int> maxIdx(len);
+
+            for (int j = 0; j < n; ++j) {
+                // Pivot search, independently per system
+                const TNum* cj = A.lane(j, j) + k0;
+                #pragma omp simd
+                for (int k = 0; k < len; ++k) {
+                    maxVal[k] = std::abs(cj[k]);
+                    maxIdx[k] = j;
+                }
+                for (int i = j + 1; i < n; ++i) {
+                    const TNum* ci = A.lane(i, j) + k0;
+                    #pragma omp simd
+                    for (int k = 0; k < len; ++k) {
+                        const TNum v = std::abs(ci[k]);
+                        const bool larger = v > maxVal[k];
+                        maxVal[k] = larger ? v : maxVal[k];
+                        maxIdx[k] = larger ? i : maxIdx[k];
+                    }
+                }
+
+                int* pj = P.data() + static_cast<size_t>(j) * bs + k0;
+                for (int k = 0; k < len; ++k) {
+                    pj[k] = maxIdx[k];
+                    if (maxVal[k] < epsilon) {
+                        info[k0 + k] = j + 1;
+                    }
+                    if (maxIdx[k] != j) {
+                        for (int c = 0; c < n; ++c) {
+                            std::swap(A.lane(j, c)[k0 + k], A.lane(maxIdx[k], c)[k0 + k]);
+                        }
+                    }
+                }
+
+                // Multipliers
+                const TNum* diag = A.lane(j, j) + k0;
+                for (int i = j + 1; i < n; ++i) {
+                    TNum* lij = A.lane(i, j) + k0;
+                    #pragma omp simd
+                    for (int k = 0; k < len; ++k) {
+                        lij[k] /= diag[k];
+                    }
+                }
+
+                // Rank-1 update of the trailing matrix
+                for (int c = j + 1; c < n; ++c) {
+                    const TNum* ujc = A.lane(j, c) + k0;
+                    for (int i = j + 1; i < n; ++i) {
+                        const TNum* lij = A.lane(i, j) + k0;
+                        TNum* aic = A.lane(i, c) + k0;
+                        #pragma omp simd
+                        for (int k = 0; k < len; ++k) {
+                            aic[k] -= lij[k] * ujc[k];
+                        }
+                    }
+                }
+            }
+        });
+
+        detail::checkInfo(info, "Matrix is singular or nearly singular and cannot be decomposed.");
+    }
+
+    /**
+     * @brief Solve A X = B for every system of the batch using the output of batched::LU
+     * @param LU Factorized batch
+     * @param P Pivot rows returned by batched::LU
+     * @param B Right-hand sides (n x nrhs per system), overwritten with the solutions
+     */
+    template <typename TNum>
+    void LUSolve(const BatchedDenseObj<TNum>& LU, const std::vector<int>& P, BatchedDenseObj<TNum>& B) {
+        const int n = LU.getRows();
+        const int bs = LU.getBatch();
+        const int nrhs = B.getCols();
+        detail::checkRHS(n, bs, B);
+        if (P.size() != static_cast<size_t>(n) * bs) {
+            throw std::invalid_argument("Pivot vector does not match the factorization.");
+        }
+
+        detail::forEachChunk(bs, detail::chunkSize<TNum>(n, n + nrhs), [&](int k0, int k1) {
+            const int len = k1 - k0;
+            for (int r = 0; r < nrhs; ++r) {
+                // Apply the row interchanges
+                for (int j = 0; j < n; ++j) {
+                    const int* pj = P.data() + static_cast<size_t>(j) * bs + k0;
+                    TNum* bj = B.lane(j, r) + k0;
+                    for (int k = 0; k < len; ++k) {
+                        if (pj[k] != j) {
+                            std::swap(bj[k], B.lane(pj[k], r)[k0 + k]);
+                        }
+                    }
+                }
+
+                // Forward substitution with unit-lower L
+                for (int j = 0; j < n; ++j) {
+                    const TNum* bj = B.lane(j, r) + k0;
+                    for (int i = j + 1; i < n; ++i) {
+                        const TNum* lij = LU.lane(i, j) + k0;
+                        TNum* bi = B.lane(i, r) + k0;
+                        #pragma omp simd
+                        for (int k = 0; k < len; ++k) {
+                            bi[k] -= lij[k] * bj[k];
+                        }
+                    }
+                }
+
+                // Back substitution with U
+                for (int j = n - 1; j >= 0; --j) {
+                    const TNum* ujj = LU.lane(j, j) + k0;
+                    TNum* bj = B.lane(j, r) + k0;
+                    #pragma omp simd
+                    for (int k = 0; k < len; ++k) {
+                        bj[k] /= ujj[k];
+                    }
+                    for (int i = 0; i < j; ++i) {
+                        const TNum* uij = LU.lane(i, j) + k0;
+                        TNum* bi = B.lane(i, r) + k0;
+                        #pragma omp simd
+                        for (int k = 0; k < len; ++k) {
+                            bi[k] -= uij[k] * bj[k];
+                        }
+                    }
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief In-place Cholesky factorization A = L L^T of every matrix in the batch
+     * @param A Batch of symmetric positive definite matrices; overwritten with L
+     *          (the strictly upper part is set to zero)
+     * @throws std::runtime_error if any system is not positive definite
+     */
+    template <typename TNum>
+    void Cholesky(BatchedDenseObj<TNum>& A) {
+        const int n = A.getRows();
+        const int bs = A.getBatch();
+        if (n != A.getCols()) {
+            throw std::invalid_argument("Matrices must be square for batched Cholesky decomposition");
+        }
+        std::vector<int> info(bs, 0);
+
+        detail::forEachChunk(bs, detail::chunkSize<TNum>(n, n), [&](int k0, int k1) {
+            const int len = k1 - k0;
+            for (int j = 0; j < n; ++j) {
+                // Diagonal element
+                TNum* ljj = A.lane(j, j) + k0;
+                for (int p = 0; p < j; ++p) {
+                    const TNum* ljp = A.lane(j, p) + k0;
+                    #pragma omp simd
+                    for (int k = 0; k < len; ++k) {
+                        ljj[k] -= ljp[k] * ljp[k];
+                    }
+                }
+                for (int k = 0; k < len; ++k) {
+                    if (ljj[k] <= TNum(0)) {
+                        info[k0 + k] = j + 1;
+                        ljj[k] = TNum(1);
+                    }
+                }
+                #pragma omp simd
+                for (int k = 0; k < len; ++k) {
+                    ljj[k] = std::sqrt(ljj[k]);
+                }
+
+                // Column below the diagonal
+                for (int p = 0; p < j; ++p) {
+                    const TNum* ljp = A.lane(j, p) + k0;
+                    for (int i = j + 1; i < n; ++i) {
+                        const TNum* lip = A.lane(i, p) + k0;
+                        TNum* lij = A.lane(i, j) + k0;
+                        #pragma omp simd
+                        for (int k = 0; k < len; ++k) {
+                            lij[k] -= lip[k] * ljp[k];
+                        }
+                    }
+                }
+                for (int i = j + 1; i < n; ++i) {
+                    TNum* lij = A.lane(i, j) + k0;
+                    #pragma omp simd
+                    for (int k = 0; k < len; ++k) {
+                        lij[k] /= ljj[k];
+                    }
+                }
+
+                // Clear the strictly upper part of column j
+                for (int i = 0; i < j; ++i) {
+                    std::fill(A.lane(i, j) + k0, A.lane(i, j) + k1, TNum(0));
+                }
+            }
+        });
+
+        detail::checkInfo(info, "Matrix is not positive definite");
+    }
+
+    /**
+     * @brief Solve A X = B for every system of the batch using the output of batched::Cholesky
+     * @param L Batch of lower Cholesky factors
+     * @param B Right-hand sides (n x nrhs per system), overwritten with the solutions
+     */
+    template <typename TNum>
+    void CholeskySolve(const BatchedDenseObj<TNum>& L, BatchedDenseObj<TNum>& B) {
+        const int n = L.getRows();
+        const int bs = L.getBatch();
+        const int nrhs = B.getCols();
+        detail::checkRHS(n, bs, B);
+
+        detail::forEachChunk(bs, detail::chunkSize<TNum>(n, n + nrhs), [&](int k0, int k1) {
+            const int len = k1 - k0;
+            for (int r = 0; r < nrhs; ++r) {
+                // L y = b
+                for (int j = 0; j < n; ++j) {
+                    const TNum* ljj = L.lane(j, j) + k0;
+                    TNum* bj = B.lane(j, r) + k0;
+                    #pragma omp simd
+                    for (int k = 0; k < len; ++k) {
+                        bj[k] /= ljj[k];
+                    }
+                    for (int i = j + 1; i < n; ++i) {
+                        const TNum* lij = L.lane(i, j) + k0;
+                        TNum* bi = B.lane(i, r) + k0;
+                        #pragma omp simd
+                        for (int k = 0; k < len; ++k) {
+                            bi[k] -= lij[k] * bj[k];
+                        }
+                    }
+                }
+                // L^T x = y
+                for (int j = n - 1; j >= 0; --j) {
+                    const TNum* ljj = L.lane(j, j) + k0;
+                    TNum* bj = B.lane(j, r) + k0;
+                    for (int i = j + 1; i < n; ++i) {
+                        const TNum* lij = L.lane(i, j) + k0;
+                        const TNum* bi = B.lane(i, r) + k0;
+                        #pragma omp simd
+                        for (int k = 0; k < len; ++k) {
+                            bj[k] -= lij[k] * bi[k];
+                        }
+                    }
+                    #pragma omp simd
+                    for (int k = 0; k < len; ++k) {
+                        bj[k] /= ljj[k];
+                    }
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief In-place Householder QR factorization of every matrix in the batch
+     *
+     * On output the upper triangle holds R and the part below the diagonal holds
+     * the Householder vectors (with an implicit unit leading entry), as in LAPACK's geqrf.
+     *
+     * @param A Batch of m x n matrices with m >= n
+     * @param tau Householder scalars, tau[j * batch + k] belongs to column j of system k
+     */
+    template <typename TNum>
+    void QR(BatchedDenseObj<TNum>& A, std::vector<TNum>& tau) {
+        const int m = A.getRows();
+        const int n = A.getCols();
+        const int bs = A.getBatch();
+        if (m < n) {
+            throw std::invalid_argument("Batched QR requires at least as many rows as columns.");
+        }
+        tau.assign(static_cast<size_t>(n) * bs, TNum(0));
+
+        detail::forEachChunk(bs, detail::chunkSize<TNum>(m, n), [&](int k0, int k1) {
+            const int len = k1 - k0;
+            std::vector<TNum> w(len);
+
+            for (int j = 0; j < n; ++j) {
+                // Generate the reflector that annihilates A(j+1:m, j)
+                std::fill(w.begin(), w.end(), TNum(0));
+                for (int i = j + 1; i < m; ++i) {
+                    const TNum* aij = A.lane(i, j) + k0;
+                    #pragma omp simd
+                    for (int k = 0; k < len; ++k) {
+                        w[k] += aij[k] * aij[k];
+                    }
+                }
+                TNum* ajj = A.lane(j, j) + k0;
+                TNum* tj = tau.data() + static_cast<size_t>(j) * bs + k0;
+                #pragma omp simd
+                for (int k = 0; k < len; ++k) {
+                    const TNum alpha = ajj[k];
+                    const bool trivial = w[k] == TNum(0);
+                    const TNum norm = std::sqrt(alpha * alpha + w[k]);
+                    const TNum beta = alpha >= TNum(0) ? -norm : norm;
+                    tj[k] = trivial ? TNum(0) : (beta - alpha) / beta;
+                    w[k] = trivial ? TNum(0) : TNum(1) / (alpha - beta);
+                    ajj[k] = trivial ? alpha : beta;
+                }
+                for (int i = j + 1; i < m; ++i) {
+                    TNum* aij = A.lane(i, j) + k0;
+                    #pragma omp simd
+                    for (int k = 0; k < len; ++k) {
+                        aij[k] *= w[k];
+                    }
+                }
+
+                // Apply H = I - tau v v^T to the trailing columns
+                for (int c = j + 1; c < n; ++c) {
+                    TNum* ajc = A.lane(j, c) + k0;
+                    #pragma omp simd
+                    for (int k = 0; k < len; ++k) {
+                        w[k] = ajc[k];
+                    }
+                    for (int i = j + 1; i < m; ++i) {
+                        const TNum* vi = A.lane(i, j) + k0;
+                        const TNum* aic = A.lane(i, c) + k0;
+                        #pragma omp simd
+                        for (int k = 0; k < len; ++k) {
+                            w[k] += vi[k] * aic[k];
+                        }
+                    }
+                    #pragma omp simd
+                    for (int k = 0; k < len; ++k) {
+                        w[k] *= tj[k];
+                        ajc[k] -= w[k];
+                    }
+                    for (int i = j + 1; i < m; ++i) {
+                        const TNum* vi = A.lane(i, j) + k0;
+                        TNum* aic = A.lane(i, c) + k0;
+                        #pragma omp simd
+                        for (int k = 0; k < len; ++k) {
+                            aic[k] -= w[k] * vi[k];
+                        }
+                    }
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief Least-squares solve min ||A X - B|| for every system using the output of batched::QR
+     * @param QR Factorized batch (m x n per system)
+     * @param tau Householder scalars returned by batched::QR
+     * @param B Right-hand sides (m x nrhs per system); on output the first n rows hold the solutions
+     * @throws std::runtime_error if any R factor has a zero diagonal element
+     */
+    template <typename TNum>
+    void QRSolve(const BatchedDenseObj<TNum>& QR, const std::vector<TNum>& tau, BatchedDenseObj<TNum>& B) {
+        const int m = QR.getRows();
+        const int n = QR.getCols();
+        const int bs = QR.getBatch();
+        const int nrhs = B.getCols();
+        detail::checkRHS(m, bs, B);
+        if (tau.size() != static_cast<size_t>(n) * bs) {
+            throw std::invalid_argument("Householder scalars do not match the factorization.");
+        }
+        std::vector<int> info(bs, 0);
+
+        detail::forEachChunk(bs, detail::chunkSize<TNum>(m, n + nrhs), [&](int k0, int k1) {
+            const int len = k1 - k0;
+            std::vector<TNum> w(len);
+            for (int r = 0; r < nrhs; ++r) {
+                // b := Q^T b
+                for (int j = 0; j < n; ++j) {
+                    const TNum* tj = tau.data() + static_cast<size_t>(j) * bs + k0;
+                    TNum* bj = B.lane(j, r) + k0;
+                    #pragma omp simd
+                    for (int k = 0; k < len; ++k) {
+                        w[k] = bj[k];
+                    }
+                    for (int i = j + 1; i < m; ++i) {
+                        const TNum* vi = QR.lane(i, j) + k0;
+                        const TNum* bi = B.lane(i, r) + k0;
+                        #pragma omp simd
+                        for (int k = 0; k < len; ++k) {
+                            w[k] += vi[k] * bi[k];
+                        }
+                    }
+                    #pragma omp simd
+                    for (int k = 0; k < len; ++k) {
+                        w[k] *= tj[k];
+                        bj[k] -= w[k];
+                    }
+                    for (int i = j + 1; i < m; ++i) {
+                        const TNum* vi = QR.lane(i, j) + k0;
+                        TNum* bi = B.lane(i, r) + k0;
+                        #pragma omp simd
+                        for (int k = 0; k < len; ++k) {
+                            bi[k] -= w[k] * vi[k];
+                        }
+                    }
+                }
+
+                // R x = (Q^T b)(0:n)
+                for (int j = n - 1; j >= 0; --j) {
+                    const TNum* rjj = QR.lane(j, j) + k0;
+                    TNum* bj = B.lane(j, r) + k0;
+                    for (int k = 0; k < len; ++k) {
+                        if (rjj[k] == TNum(0)) {
+                            info[k0 + k] = j + 1;
+                        }
+                    }
+                    #pragma omp simd
+                    for (int k = 0; k < len; ++k) {
+                        bj[k] = rjj[k] != TNum(0) ? bj[k] / rjj[k] : TNum(0);
+                    }
+                    for (int i = 0; i < j; ++i) {
+                        const TNum* rij = QR.lane(i, j) + k0;
+                        TNum* bi = B.lane(i, r) + k0;
+                        #pragma omp simd
+                        for (int k = 0; k < len; ++k) {
+                            bi[k] -= rij[k] * bj[k];
+                        }
+                    }
+                }
+            }
+        });
+
+        detail::checkInfo(info, "Matrix is rank deficient and the least-squares problem cannot be solved.");
+    }
+
+} // namespace batched
+
+#endif // BATCHED_HPP
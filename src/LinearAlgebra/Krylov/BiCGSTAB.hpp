@@ -0,0 +1,166 @@
+#ifndef BICGSTAB_HPP
+#define BICGSTAB_HPP
+
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+#include "../../Obj/SparseObj.hpp"
+#include "../../Obj/VectorObj.hpp"
+#include "../Preconditioner/Preconditioner.hpp"
+
+/**
+ * @brief BiCGSTAB(l) for nonsymmetric systems (Sleijpen & Fokkema)
+ *
+ * Each outer iteration performs l BiCG steps followed by a minimal residual
+ * polynomial of degree l, which copes with the nearly imaginary eigenvalues of
+ * convection-dominated operators where BiCGSTAB (l = 1) stagnates. Memory is
+ * fixed at 2(l + 1) + 2 vectors and every outer iteration costs 2l SpMVs.
+ *
+ * A preconditioner is applied from the right, so the residual that is
+ * monitored is the true residual b - A x. It must be a fixed linear operator.
+ */
+template <typename TNum, typename MatrixType = SparseMatrixCSC<TNum>, typename VectorType = VectorObj<TNum>>
+class BiCGSTAB {
+private:
+    int ell;
+    Preconditioner<TNum, VectorType>* preconditioner = nullptr;
+    int iterations = 0;
+    int matVecs = 0;
+    TNum residualNorm = TNum(0);
+
+    // A M^(-1) v
+    VectorType applyOperator(const MatrixType& A, const VectorType& v) {
+        ++matVecs;
+        return preconditioner ? A * preconditioner->apply(v) : A * v;
+    }
+
+public:
+    explicit BiCGSTAB(int ell = 2) : ell(ell) {
+        if (ell < 1) {
+            throw std::invalid_argument("BiCGSTAB(l) requires l >= 1");
+        }
+    }
+    virtual ~BiCGSTAB() = default;
+
+    // The preconditioner is not owned and must outlive the calls to solve
+    void setPreconditioner(Preconditioner<TNum, VectorType>& M) {
+        preconditioner = &M;
+    }
+
+    int getIterations() const { return iterations; }
+    int getMatVecs() const { return matVecs; }
+    TNum getResidualNorm() const { return residualNorm; }
+
+    /**
+     * @brief Solve A x = b starting from the initial guess in x
+     * @param maxIter Maximum number of outer (BiCG + MR) iterations
+     * @param tol Tolerance on the relative residual ||b - A x|| / ||b||
+     * @return true if the tolerance was reached
+     */
+    bool solve(const MatrixType& A, const VectorType& b, VectorType& x, int maxIter, double tol) {
+        const int n = b.size();
+        if (A.getRows() != n || A.getCols() != n) {
+            throw std::invalid_argument("Matrix dimensions must match vector size");
+        }
+        if (static_cast<int>(x.size()) != n) {
+            throw std::invalid_argument("Initial guess vector must match system size");
+        }
+
+        iterations = 0;
+        matVecs = 0;
+        const TNum bNorm = b.L2norm();
+        if (bNorm == TNum(0)) {
+            x = VectorType(n, TNum(0));
+            residualNorm = TNum(0);
+            return true;
+        }
+
+        // r[0] and u[0] are the BiCG residual and search direction, r[j] / u[j]
+        // hold their images under (A M^(-1))^j; y is the preconditioned correction
+        std::vector<VectorType> r(ell + 1, VectorType(n, TNum(0)));
+        std::vector<VectorType> u(ell + 1, VectorType(n, TNum(0)));
+        r[0] = b - A * x;
+        const VectorType rShadow = r[0];
+        VectorType y(n, TNum(0));
+
+        residualNorm = r[0].L2norm();
+        if (residualNorm <= tol * bNorm) {
+            return true;
+        }
+
+        // Reduction coefficients of the MR part (1-based, as in the paper)
+        std::vector<std::vector<TNum>> tau(ell + 1, std::vector<TNum>(ell + 1, TNum(0)));
+        std::vector<TNum> sigma(ell + 1), gamma(ell + 1), gammaP(ell + 1), gammaPP(ell + 1);
+
+        TNum rho0 = TNum(1), alpha = TNum(0), omega = TNum(1);
+        bool converged = false;
+        while (iterations < maxIter && !converged) {
+            rho0 = -omega * rho0;
+
+            // BiCG part
+            for (int j = 0; j < ell; ++j) {
+                const TNum rho1 = r[j] * rShadow;
+                if (rho0 == TNum(0)) {
+                    throw std::runtime_error("BiCGSTAB(l) breakdown: rho = 0");
+                }
+                const TNum beta = alpha * rho1 / rho0;
+                rho0 = rho1;
+                for (int i = 0; i <= j; ++i) {
+                    u[i] = r[i] - u[i] * beta;
+                }
+                u[j + 1] = applyOperator(A, u[j]);
+                const TNum sigmaBiCG = u[j + 1] * rShadow;
+                if (sigmaBiCG == TNum(0)) {
+                    throw std::runtime_error("BiCGSTAB(l) breakdown: (A u, r~) = 0");
+                }
+                alpha = rho0 / sigmaBiCG;
+                for (int i = 0; i <= j; ++i) {
+                    r[i].axpy(-alpha, u[i + 1]);
+                }
+                r[j + 1] = applyOperator(A, r[j]);
+                y.axpy(alpha, u[0]);
+            }
+
+            // MR part: modified Gram-Schmidt on r[1..l]
+            for (int j = 1; j <= ell; ++j) {
+                for (int i = 1; i < j; ++i) {
+                    tau[i][j] = (r[j] * r[i]) / sigma[i];
+                    r[j].axpy(-tau[i][j], r[i]);
+                }
+                sigma[j] = r[j] * r[j];
+                if (sigma[j] == TNum(0)) {
+                    throw std::runtime_error("BiCGSTAB(l) breakdown: dependent residual images");
+                }
+                gammaP[j] = (r[0] * r[j]) / sigma[j];
+            }
+            gamma[ell] = gammaP[ell];
+            omega = gamma[ell];
+            for (int j = ell - 1; j >= 1; --j) {
+                gamma[j] = gammaP[j];
+                for (int i = j + 1; i <= ell; ++i) gamma[j] -= tau[j][i] * gamma[i];
+            }
+            for (int j = 1; j < ell; ++j) {
+                gammaPP[j] = gamma[j + 1];
+                for (int i = j + 1; i < ell; ++i) gammaPP[j] += tau[j][i] * gamma[i + 1];
+            }
+
+            y.axpy(gamma[1], r[0]);
+            r[0].axpy(-gammaP[ell], r[ell]);
+            u[0].axpy(-gamma[ell], u[ell]);
+            for (int j = 1; j < ell; ++j) {
+                u[0].axpy(-gamma[j], u[j]);
+                y.axpy(gammaPP[j], r[j]);
+                r[0].axpy(-gammaP[j], r[j]);
+            }
+
+            ++iterations;
+            residualNorm = r[0].L2norm();
+            converged = residualNorm <= tol * bNorm;
+        }
+
+        x.axpy(TNum(1), preconditioner ? preconditioner->apply(y) : y);
+        return converged;
+    }
+};
+
+#endif // BICGSTAB_HPP
@@ -0,0 +1,148 @@
+#ifndef BLOCKCG_HPP
+#define BLOCKCG_HPP
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include "../../Obj/Blas.hpp"
+#include "../../Obj/DenseObj.hpp"
+#include "../../Obj/SparseObj.hpp"
+#include "../../Obj/VectorObj.hpp"
+#include "../Factorized/basic.hpp"
+#include "../Preconditioner/Preconditioner.hpp"
+#include "KrylovSubspace.hpp"
+
+/**
+ * @brief Block conjugate gradient for A X = B with k right-hand sides (O'Leary)
+ *
+ * All columns share one Krylov space: every iteration applies A to a block of
+ * search directions with a single SpMM and computes the k x k step matrices
+ * with gemm. The search directions are re-orthonormalized every iteration and
+ * directions that became linearly dependent (e.g. because some columns have
+ * converged) are dropped, so the block size shrinks instead of breaking down.
+ */
+template <typename TNum, typename MatrixType = SparseMatrixCSC<TNum>>
+class BlockCG {
+private:
+    Preconditioner<TNum, VectorObj<TNum>>* preconditioner = nullptr;
+    int iterations = 0;
+    std::vector<TNum> residualNorms;
+
+    // Z = M^(-1) R, column by column
+    DenseObj<TNum> precondition(const DenseObj<TNum>& R) {
+        if (!preconditioner) return R;
+        DenseObj<TNum> Z(R.getRows(), R.getCols());
+        for (int j = 0; j < R.getCols(); ++j) {
+            VectorObj<TNum> z = preconditioner->apply(R.getColumn(j));
+            std::copy(z.element(), z.element() + R.getRows(), Z.data() + static_cast<size_t>(j) * R.getRows());
+        }
+        return Z;
+    }
+
+    // Solve G Y = C for the symmetric positive definite p x p matrix G
+    static DenseObj<TNum> spdSolve(const DenseObj<TNum>& G, const DenseObj<TNum>& C) {
+        DenseObj<TNum> L;
+        basic::Cholesky<TNum, DenseObj<TNum>>(G, L);
+        DenseObj<TNum> Y = basic::TriangularSolve(L, C, true);
+        return basic::TriangularSolve(L.Transpose(), Y, false);
+    }
+
+    // C = op(A) * B with op = transpose when trans is set
+    static DenseObj<TNum> gemm(const DenseObj<TNum>& A, const DenseObj<TNum>& B, bool trans) {
+        const int m = trans ? A.getCols() : A.getRows();
+        DenseObj<TNum> C(m, B.getCols());
+        blas::gemm(CblasColMajor, trans ? CblasTrans : CblasNoTrans, CblasNoTrans,
+                    m, B.getCols(), B.getRows(), 1.0, A.data(), std::max(1, A.getRows()),
+                    B.data(), std::max(1, B.getRows()), 0.0, C.data(), std::max(1, m));
+        return C;
+    }
+
+    // D = D + alpha * A * B
+    static void gemmUpdate(DenseObj<TNum>& D, TNum alpha, const DenseObj<TNum>& A, const DenseObj<TNum>& B) {
+        blas::gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, D.getRows(), D.getCols(), A.getCols(),
+                    alpha, A.data(), std::max(1, A.getRows()), B.data(), std::max(1, B.getRows()),
+                    1.0, D.data(), std::max(1, D.getRows()));
+    }
+
+    // Orthonormal basis of the columns of W, dependent columns dropped
+    static DenseObj<TNum> orthonormalBasis(DenseObj<TNum> W) {
+        const int n = W.getRows(), k = W.getCols();
+        DenseObj<TNum> R(k, k);
+        const int rank = Krylov::orthonormalizeBlock(W.data(), n, k, n, R.data(), k, TNum(1e-10));
+        DenseObj<TNum> Q(n, rank);
+        std::copy(W.data(), W.data() + static_cast<size_t>(n) * rank, Q.data());
+        return Q;
+    }
+
+public:
+    BlockCG() = default;
+    virtual ~BlockCG() = default;
+
+    // SPD preconditioner applied to every column; not owned
+    void setPreconditioner(Preconditioner<TNum, VectorObj<TNum>>& M) {
+        preconditioner = &M;
+    }
+
+    int getIterations() const { return iterations; }
+    // Final residual norm ||B(:, j) - A X(:, j)|| of every column
+    const std::vector<TNum>& getResidualNorms() const { return residualNorms; }
+
+    /**
+     * @brief Solve A X = B starting from the initial guess in X
+     * @param tol Tolerance on the relative residual of every column
+     * @return true if all columns reached the tolerance
+     */
+    bool solve(const MatrixType& A, const DenseObj<TNum>& B, DenseObj<TNum>& X, int maxIter, double tol) {
+        const int n = B.getRows();
+        const int k = B.getCols();
+        if (A.getRows() != n || A.getCols() != n) {
+            throw std::invalid_argument("Matrix dimensions must match the right-hand sides");
+        }
+        if (X.getRows() != n || X.getCols() != k) {
+            throw std::invalid_argument("Initial guess must match the right-hand sides");
+        }
+
+        std::vector<TNum> bNorms(k);
+        for (int j = 0; j < k; ++j) {
+            bNorms[j] = blas::nrm2(n, B.data() + static_cast<size_t>(j) * n, 1);
+        }
+        auto converged = [&](const DenseObj<TNum>& R) {
+            bool done = true;
+            for (int j = 0; j < k; ++j) {
+                residualNorms[j] = blas::nrm2(n, R.data() + static_cast<size_t>(j) * n, 1);
+                done = done && residualNorms[j] <= tol * bNorms[j];
+            }
+            return done;
+        };
+
+        iterations = 0;
+        residualNorms.assign(k, TNum(0));
+        DenseObj<TNum> R = B - A * X;
+        if (converged(R)) {
+            return true;
+        }
+
+        DenseObj<TNum> P = orthonormalBasis(precondition(R));
+        while (iterations < maxIter && P.getCols() > 0) {
+            DenseObj<TNum> Q = A * P;                        // SpMM
+            DenseObj<TNum> G = gemm(P, Q, true);             // P^T A P
+            DenseObj<TNum> alpha = spdSolve(G, gemm(P, R, true));
+            gemmUpdate(X, TNum(1), P, alpha);
+            gemmUpdate(R, TNum(-1), Q, alpha);
+            ++iterations;
+            if (converged(R)) {
+                return true;
+            }
+
+            // Next directions Z + P beta, A-conjugate to P
+            DenseObj<TNum> Z = precondition(R);
+            DenseObj<TNum> beta = spdSolve(G, gemm(Q, Z, true));
+            gemmUpdate(Z, TNum(-1), P, beta);
+            P = orthonormalBasis(std::move(Z));
+        }
+        return false;
+    }
+};
+
+#endif // BLOCKCG_HPP
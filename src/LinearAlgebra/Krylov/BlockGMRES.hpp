@@ -0,0 +1,186 @@
+#ifndef BLOCKGMRES_HPP
+#define BLOCKGMRES_HPP
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include "../../Obj/Blas.hpp"
+#include "../../Obj/DenseObj.hpp"
+#include "../../Obj/SparseObj.hpp"
+#include "../Factorized/basic.hpp"
+#include "KrylovSubspace.hpp"
+
+/**
+ * @brief Restarted block GMRES for A X = B with k right-hand sides
+ *
+ * Builds one block Krylov space span{R0, A R0, ..., A^(m-1) R0} for all
+ * columns: the operator is applied with a single SpMM per step and the block
+ * is orthogonalized against the basis with two gemm passes (block CGS2). The
+ * block Hessenberg matrix has k sub-diagonals, which are eliminated with
+ * Givens rotations so that the residual norm of every column is known at every
+ * step without forming the iterate.
+ */
+template <typename TNum, typename MatrixType = SparseMatrixCSC<TNum>>
+class BlockGMRES {
+private:
+    struct Rotation {
+        int row;  // Acts on rows row and row + 1
+        TNum cs, sn;
+    };
+
+    int iterations = 0;
+    std::vector<TNum> residualNorms;
+
+    static void applyRotation(const Rotation& rot, TNum* col) {
+        Krylov::applyGivensRotation(col[rot.row], col[rot.row + 1], rot.cs, rot.sn);
+    }
+
+public:
+    BlockGMRES() = default;
+    virtual ~BlockGMRES() = default;
+
+    // Total number of block steps and final residual norm of every column
+    int getIterations() const { return iterations; }
+    const std::vector<TNum>& getResidualNorms() const { return residualNorms; }
+
+    /**
+     * @brief Solve A X = B starting from the initial guess in X
+     * @param maxIter Maximum number of restart cycles
+     * @param KrylovDim Number of block steps per cycle
+     * @param tol Tolerance on the relative residual of every column
+     * @return true if all columns reached the tolerance
+     */
+    bool solve(const MatrixType& A, const DenseObj<TNum>& B, DenseObj<TNum>& X, int maxIter, int KrylovDim, double tol) {
+        const int n = B.getRows();
+        const int k = B.getCols();
+        if (A.getRows() != n || A.getCols() != n) {
+            throw std::invalid_argument("Matrix dimensions must match the right-hand sides");
+        }
+        if (X.getRows() != n || X.getCols() != k) {
+            throw std::invalid_argument("Initial guess must match the right-hand sides");
+        }
+        if (KrylovDim <= 0) {
+            throw std::invalid_argument("Invalid Krylov subspace dimension");
+        }
+
+        std::vector<TNum> bNorms(k);
+        for (int j = 0; j < k; ++j) {
+            bNorms[j] = blas::nrm2(n, B.data() + static_cast<size_t>(j) * n, 1);
+        }
+        iterations = 0;
+        residualNorms.assign(k, TNum(0));
+
+        for (int cycle = 0; cycle < maxIter; ++cycle) {
+            DenseObj<TNum> R = B - A * X;
+            bool done = true;
+            for (int j = 0; j < k; ++j) {
+                residualNorms[j] = blas::nrm2(n, R.data() + static_cast<size_t>(j) * n, 1);
+                done = done && residualNorms[j] <= tol * bNorms[j];
+            }
+            if (done) {
+                return true;
+            }
+
+            // V_0 S = R; columns that are already (nearly) dependent shrink the block
+            const int mMax = std::min(KrylovDim, std::max(1, n / k));
+            DenseObj<TNum> V(n, (mMax + 1) * k);
+            std::copy(R.data(), R.data() + static_cast<size_t>(n) * k, V.data());
+            DenseObj<TNum> S(k, k);
+            const int p = Krylov::orthonormalizeBlock(V.data(), n, k, n, S.data(), k, TNum(1e-12));
+            if (p == 0) {
+                return false;
+            }
+
+            // Least-squares right-hand side G = E1 S and block Hessenberg H
+            const int ldh = (mMax + 1) * p;
+            DenseObj<TNum> G(ldh, k);
+            for (int j = 0; j < k; ++j) {
+                for (int i = 0; i < p; ++i) G(i, j) = S(i, j);
+            }
+            DenseObj<TNum> H(ldh, mMax * p);
+            std::vector<Rotation> rotations;
+
+            int steps = 0;
+            for (int j = 0; j < mMax; ++j) {
+                const int rows = (j + 1) * p;  // Basis vectors so far
+                TNum* Vj = V.data() + static_cast<size_t>(j) * p * n;
+                TNum* W = V.data() + static_cast<size_t>(rows) * n;
+
+                // W = A V_j
+                DenseObj<TNum> Vblock(n, p);
+                std::copy(Vj, Vj + static_cast<size_t>(n) * p, Vblock.data());
+                DenseObj<TNum> AV = A * Vblock;
+                std::copy(AV.data(), AV.data() + static_cast<size_t>(n) * p, W);
+                ++iterations;
+
+                // Block CGS2 against V(:, 0:rows)
+                TNum* Hj = H.data() + static_cast<size_t>(j) * p * ldh;
+                DenseObj<TNum> C(rows, p);
+                for (int pass = 0; pass < 2; ++pass) {
+                    blas::gemm(CblasColMajor, CblasTrans, CblasNoTrans, rows, p, n, 1.0,
+                                V.data(), n, W, n, 0.0, C.data(), rows);
+                    blas::gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, n, p, rows, -1.0,
+                                V.data(), n, C.data(), rows, 1.0, W, n);
+                    for (int c = 0; c < p; ++c) {
+                        for (int i = 0; i < rows; ++i) Hj[i + static_cast<size_t>(c) * ldh] += C(i, c);
+                    }
+                }
+                // W = V_(j+1) H_(j+1, j)
+                DenseObj<TNum> Rsub(p, p);
+                const int rank = Krylov::orthonormalizeBlock(W, n, p, n, Rsub.data(), p, TNum(1e-12));
+                for (int c = 0; c < p; ++c) {
+                    for (int i = 0; i < p; ++i) Hj[rows + i + static_cast<size_t>(c) * ldh] = Rsub(i, c);
+                }
+
+                // Bring the new block column to upper triangular form: rotations of the
+                // previous steps first, then new ones that also act on the later columns
+                for (int c = 0; c < p; ++c) {
+                    for (const Rotation& rot : rotations) applyRotation(rot, Hj + static_cast<size_t>(c) * ldh);
+                }
+                for (int c = 0; c < p; ++c) {
+                    TNum* col = Hj + static_cast<size_t>(c) * ldh;
+                    const int diag = j * p + c;
+                    for (int r = diag + p; r > diag; --r) {
+                        Rotation rot{r - 1, TNum(1), TNum(0)};
+                        TNum rho;
+                        Krylov::generateGivensRotation(col[r - 1], col[r], rot.cs, rot.sn, rho);
+                        col[r - 1] = rho;
+                        col[r] = TNum(0);
+                        for (int c2 = c + 1; c2 < p; ++c2) applyRotation(rot, Hj + static_cast<size_t>(c2) * ldh);
+                        for (int q = 0; q < k; ++q) applyRotation(rot, G.data() + static_cast<size_t>(q) * ldh);
+                        rotations.push_back(rot);
+                    }
+                }
+                steps = j + 1;
+
+                // Residual norm of column q is the norm of G((j+1)p : (j+2)p, q)
+                done = true;
+                for (int q = 0; q < k; ++q) {
+                    const TNum* gq = G.data() + static_cast<size_t>(q) * ldh + rows;
+                    residualNorms[q] = blas::nrm2(p, gq, 1);
+                    done = done && residualNorms[q] <= tol * bNorms[q];
+                }
+                if (done || rank < p) {
+                    break;  // Converged or the block Krylov space became invariant
+                }
+            }
+
+            // Y = H^(-1) G on the leading block, then X += V Y
+            const int m = steps * p;
+            DenseObj<TNum> Y(m, k);
+            for (int q = 0; q < k; ++q) {
+                for (int i = 0; i < m; ++i) Y(i, q) = G(i, q);
+            }
+            basic::TriangularSolve<TNum>(H.view(0, 0, m, m), Y.view(0, 0, m, k), false);
+            blas::gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, n, k, m, 1.0,
+                        V.data(), n, Y.data(), m, 1.0, X.data(), n);
+            if (done) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+#endif // BLOCKGMRES_HPP
@@ -0,0 +1,321 @@
+#ifndef CAGMRES_HPP
+#define CAGMRES_HPP
+
+#include <vector>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include "../../Obj/Blas.hpp"
+#include "../../Obj/DenseObj.hpp"
+#include "../../Obj/SparseObj.hpp"
+#include "../../Obj/VectorObj.hpp"
+#include "KrylovSubspace.hpp"
+#include "MatrixPowers.hpp"
+
+namespace Krylov {
+    // Polynomial bases for s-step Krylov methods
+    enum class Basis {
+        Monomial,  // A^j v scaled by the spectral radius; ill-conditioned beyond small s
+        Newton,    // prod (A - theta_i) v with Leja-ordered Ritz values as shifts
+        Chebyshev  // Scaled Chebyshev polynomials on the real interval spanned by the Ritz values
+    };
+}
+
+/**
+ * @brief Communication-avoiding (s-step) GMRES, CA-GMRES(s, t) of Hoemmen
+ *
+ * A restart cycle of length m = s t is built in t blocks. Each block produces
+ * s basis vectors with one call of the matrix-powers kernel, orthogonalizes
+ * them against the previous blocks with two gemm passes and among themselves
+ * with TSQR, and recovers the Arnoldi Hessenberg matrix from the change of
+ * basis. Per block this is one pass over A and two global reductions instead
+ * of s SpMVs and O(s^2) dot products. The first cycle is a standard Arnoldi
+ * cycle whose Ritz values provide the Newton shifts or the Chebyshev interval.
+ */
+template <typename TNum>
+class CAGMRES {
+private:
+    int s;
+    int t;
+    Krylov::Basis basis;
+    size_t cacheBytes = size_t(1) << 20;
+    std::vector<TNum> alpha, theta, beta;  // Recurrence v_(j+1) = alpha_j (A - theta_j) v_j - beta_j v_(j-1)
+    int iterations = 0;
+    TNum residualNorm = TNum(0);
+
+    // Modified Leja ordering that keeps complex conjugate pairs adjacent (positive imaginary part first)
+    static std::vector<std::complex<TNum>> lejaOrder(std::vector<std::complex<TNum>> z) {
+        std::vector<std::complex<TNum>> ordered;
+        std::vector<bool> used(z.size(), false);
+        while (ordered.size() < z.size()) {
+            int best = -1;
+            TNum bestScore = -std::numeric_limits<TNum>::infinity();
+            for (size_t i = 0; i < z.size(); ++i) {
+                if (used[i] || z[i].imag() < TNum(0)) continue;
+                TNum score = TNum(0);
+                if (ordered.empty()) {
+                    score = std::abs(z[i]);
+                } else {
+                    for (const auto& w : ordered) score += std::log(std::abs(z[i] - w) + std::numeric_limits<TNum>::min());
+                }
+                if (score > bestScore) {
+                    bestScore = score;
+                    best = static_cast<int>(i);
+                }
+            }
+            if (best < 0) break;
+            used[best] = true;
+            ordered.push_back(z[best]);
+            if (z[best].imag() > TNum(0)) {
+                ordered.push_back(std::conj(z[best]));
+                for (size_t i = 0; i < z.size(); ++i) {
+                    if (!used[i] && z[i] == std::conj(z[best])) {
+                        used[i] = true;
+                        break;
+                    }
+                }
+            }
+        }
+        return ordered;
+    }
+
+    // Basis coefficients from the Ritz values of the first Arnoldi cycle
+    void setBasis(const DenseObj<TNum>& H, int k) {
+        std::vector<std::complex<TNum>> ritz = Krylov::hessenbergEigenvalues(H.data(), H.getRows(), k);
+        TNum rho = TNum(0), lo = std::numeric_limits<TNum>::max(), hi = -std::numeric_limits<TNum>::max();
+        for (const auto& z : ritz) {
+            rho = std::max(rho, std::abs(z));
+            lo = std::min(lo, z.real());
+            hi = std::max(hi, z.real());
+        }
+        if (rho == TNum(0)) rho = TNum(1);
+
+        alpha.assign(s, TNum(1) / rho);
+        theta.assign(s, TNum(0));
+        beta.assign(s, TNum(0));
+        if (basis == Krylov::Basis::Newton) {
+            const std::vector<std::complex<TNum>> shifts = lejaOrder(ritz);
+            for (int j = 0; j < s; ++j) {
+                const std::complex<TNum> z = shifts[j % shifts.size()];
+                theta[j] = z.real();
+                // Second member of a conjugate pair: (A - a)^2 + b^2 in real arithmetic
+                if (j > 0 && z.imag() < TNum(0) && shifts[(j - 1) % shifts.size()] == std::conj(z)) {
+                    beta[j] = -z.imag() * z.imag() / (rho * rho);
+                }
+            }
+        } else if (basis == Krylov::Basis::Chebyshev) {
+            const TNum c = TNum(0.5) * (lo + hi);
+            TNum d = TNum(0.5) * (hi - lo);
+            if (d < std::sqrt(std::numeric_limits<TNum>::epsilon()) * rho) d = rho;
+            for (int j = 0; j < s; ++j) {
+                theta[j] = c;
+                alpha[j] = (j == 0 ? TNum(1) : TNum(2)) / d;
+                beta[j] = j == 0 ? TNum(0) : TNum(1);
+            }
+        }
+    }
+
+    // Givens reduction of column col of H into Rg; returns the new residual estimate
+    static TNum reduceColumn(const DenseObj<TNum>& H, DenseObj<TNum>& Rg, std::vector<TNum>& g,
+                             std::vector<TNum>& cs, std::vector<TNum>& sn, int col) {
+        const int ld = H.getRows();
+        const TNum* hc = H.data() + static_cast<size_t>(col) * ld;
+        TNum* rc = Rg.data() + static_cast<size_t>(col) * ld;
+        std::copy(hc, hc + col + 2, rc);
+        for (int i = 0; i < col; ++i) {
+            Krylov::applyGivensRotation(rc[i], rc[i + 1], cs[i], sn[i]);
+        }
+        TNum rho;
+        Krylov::generateGivensRotation(rc[col], rc[col + 1], cs[col], sn[col], rho);
+        rc[col] = rho;
+        rc[col + 1] = TNum(0);
+        Krylov::applyGivensRotation(g[col], g[col + 1], cs[col], sn[col]);
+        return std::abs(g[col + 1]);
+    }
+
+    // One standard Arnoldi cycle; returns the number of Hessenberg columns
+    int arnoldiCycle(const MatrixPowers<TNum>& mpk, DenseObj<TNum>& Q, DenseObj<TNum>& H, DenseObj<TNum>& Rg,
+                     std::vector<TNum>& g, std::vector<TNum>& cs, std::vector<TNum>& sn, TNum target) {
+        const int n = Q.getRows();
+        const int m = H.getCols();
+        const TNum one = TNum(1), zero = TNum(0);
+        for (int j = 0; j < m; ++j) {
+            // Q(:, j+1) = A Q(:, j)
+            mpk.compute(Q.data() + static_cast<size_t>(j) * n, n, 1, &one, &zero, &zero);
+            ++iterations;
+            TNum* w = Q.data() + static_cast<size_t>(j + 1) * n;
+            TNum* hj = H.data() + static_cast<size_t>(j) * (m + 1);
+            const TNum norm = Krylov::orthogonalize(Krylov::Orthogonalization::CGS2, Q.data(), n, j + 1, n, w, hj);
+            hj[j + 1] = norm;
+            const TNum estimate = reduceColumn(H, Rg, g, cs, sn, j);
+            if (norm <= std::numeric_limits<TNum>::epsilon() * std::abs(g[0]) || estimate <= target) {
+                return j + 1;
+            }
+            for (int i = 0; i < n; ++i) w[i] /= norm;
+        }
+        return m;
+    }
+
+    // One s-step cycle; returns the number of Hessenberg columns
+    int sStepCycle(const MatrixPowers<TNum>& mpk, DenseObj<TNum>& Q, DenseObj<TNum>& H, DenseObj<TNum>& Rg,
+                   std::vector<TNum>& g, std::vector<TNum>& cs, std::vector<TNum>& sn, TNum target) {
+        const int n = Q.getRows();
+        const int m = H.getCols();
+        const int ldh = m + 1;
+        int base = 0;  // Q(:, 0:base+1) is orthonormal, H(:, 0:base) is known
+        while (base < m) {
+            const int sb = std::min(s, m - base);
+
+            // V = [q_base, p_1(A) q_base, ..., p_sb(A) q_base] written into Q(:, base:base+sb+1)
+            mpk.compute(Q.data() + static_cast<size_t>(base) * n, n, sb, alpha.data(), theta.data(), beta.data());
+            iterations += sb;
+
+            // Block CGS2 against Q(:, 0:base+1), then TSQR of the remainder
+            const int kb = base + 1;
+            TNum* W = Q.data() + static_cast<size_t>(kb) * n;
+            DenseObj<TNum> Rtop(kb, sb), C(kb, sb);
+            for (int pass = 0; pass < 2; ++pass) {
+                blas::gemm(CblasColMajor, CblasTrans, CblasNoTrans, kb, sb, n, 1.0, Q.data(), n, W, n, 0.0, C.data(), kb);
+                blas::gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, n, sb, kb, -1.0, Q.data(), n, C.data(), kb, 1.0, W, n);
+                Rtop = Rtop + C;
+            }
+            DenseObj<TNum> Rnew(sb, sb);
+            Krylov::tsqr(W, n, sb, n, Rnew.data(), sb);
+
+            // Keep the leading columns that are numerically independent
+            int se = 0;
+            while (se < sb) {
+                TNum colNorm = TNum(0);
+                for (int i = 0; i < kb; ++i) colNorm += Rtop(i, se) * Rtop(i, se);
+                for (int i = 0; i <= se; ++i) colNorm += Rnew(i, se) * Rnew(i, se);
+                if (std::abs(Rnew(se, se)) <= TNum(1e-12) * std::sqrt(colNorm)) break;
+                ++se;
+            }
+            if (se == 0) {
+                return base;  // A q_base lies in span(Q): invariant subspace
+            }
+
+            // V(:, 0:se+1) = Q(:, 0:base+se+1) Rb
+            const int rows = base + se + 1;
+            DenseObj<TNum> Rb(rows, se + 1);
+            Rb(base, 0) = TNum(1);
+            for (int j = 1; j <= se; ++j) {
+                for (int i = 0; i < kb; ++i) Rb(i, j) = Rtop(i, j - 1);
+                for (int i = 0; i < j; ++i) Rb(kb + i, j) = Rnew(i, j - 1);
+            }
+            // Change of basis: A V(:, 0:se) = V(:, 0:se+1) B
+            DenseObj<TNum> B(se + 1, se);
+            for (int j = 0; j < se; ++j) {
+                B(j + 1, j) = TNum(1) / alpha[j];
+                B(j, j) = theta[j];
+                if (j > 0) B(j - 1, j) = beta[j] / alpha[j];
+            }
+
+            // H(:, base:base+se) = (Rb B - [H_old Rb(0:base, 0:se); 0]) Rb(base:base+se, 0:se)^(-1)
+            DenseObj<TNum> T(rows, se);
+            blas::gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, rows, se, se + 1, 1.0, Rb.data(), rows,
+                        B.data(), se + 1, 0.0, T.data(), rows);
+            if (base > 0) {
+                blas::gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, base + 1, se, base, -1.0, H.data(), ldh,
+                            Rb.data(), rows, 1.0, T.data(), rows);
+            }
+            blas::trsm(CblasColMajor, CblasRight, CblasUpper, CblasNoTrans, CblasNonUnit, rows, se, 1.0,
+                        Rb.data() + base, rows, T.data(), rows);
+            for (int j = 0; j < se; ++j) {
+                std::copy(T.data() + static_cast<size_t>(j) * rows, T.data() + static_cast<size_t>(j + 1) * rows,
+                          H.data() + static_cast<size_t>(base + j) * ldh);
+            }
+
+            for (int col = base; col < base + se; ++col) {
+                if (reduceColumn(H, Rg, g, cs, sn, col) <= target) {
+                    return col + 1;
+                }
+            }
+            base += se;
+        }
+        return m;
+    }
+
+public:
+    /**
+     * @param s Basis vectors per matrix-powers call
+     * @param t Blocks per restart cycle (restart length s t)
+     */
+    explicit CAGMRES(int s = 5, int t = 6, Krylov::Basis basis = Krylov::Basis::Newton)
+        : s(s), t(t), basis(basis) {
+        if (s < 1 || t < 1) {
+            throw std::invalid_argument("CA-GMRES requires s >= 1 and t >= 1");
+        }
+    }
+    virtual ~CAGMRES() = default;
+
+    // Cache budget handed to the matrix-powers kernel
+    void setCacheBytes(size_t bytes) { cacheBytes = bytes; }
+
+    // Number of SpMVs (matrix-powers levels included) and final residual norm of the last solve
+    int getIterations() const { return iterations; }
+    TNum getResidualNorm() const { return residualNorm; }
+
+    /**
+     * @brief Solve A x = b starting from the initial guess in x
+     * @param maxIter Maximum number of restart cycles
+     * @param tol Tolerance on the relative residual ||b - A x|| / ||b||
+     * @return true if the tolerance was reached
+     */
+    bool solve(const SparseMatrixCSC<TNum>& A, const VectorObj<TNum>& b, VectorObj<TNum>& x, int maxIter, double tol) {
+        const int n = b.size();
+        const int m = s * t;
+        if (A.getRows() != n || A.getCols() != n) {
+            throw std::invalid_argument("Matrix dimensions must match vector size");
+        }
+        if (static_cast<int>(x.size()) != n) {
+            throw std::invalid_argument("Initial guess vector must match system size");
+        }
+        if (m > n) {
+            throw std::invalid_argument("Restart length s t exceeds the system size");
+        }
+
+        const MatrixPowers<TNum> mpk(A, cacheBytes);
+        iterations = 0;
+        const TNum bNorm = b.L2norm();
+        const TNum target = tol * (bNorm > TNum(0) ? bNorm : TNum(1));
+        VectorObj<TNum> r = b - A * x;
+        residualNorm = r.L2norm();
+        if (residualNorm <= target) {
+            return true;
+        }
+
+        DenseObj<TNum> Q(n, m + 1), H(m + 1, m), Rg(m + 1, m);
+        std::vector<TNum> cs(m), sn(m), g(m + 1);
+        for (int cycle = 0; cycle < maxIter; ++cycle) {
+            H.zero();
+            Rg.zero();
+            std::fill(g.begin(), g.end(), TNum(0));
+            g[0] = residualNorm;
+            const TNum* rp = r.element();
+            for (int i = 0; i < n; ++i) Q(i, 0) = rp[i] / residualNorm;
+
+            const int k = cycle == 0 ? arnoldiCycle(mpk, Q, H, Rg, g, cs, sn, target)
+                                     : sStepCycle(mpk, Q, H, Rg, g, cs, sn, target);
+            if (k == 0) {
+                return false;  // No progress possible
+            }
+            std::vector<TNum> y = Krylov::hessenbergSolve(Rg.data(), m + 1, g, k);
+            blas::gemv(CblasColMajor, CblasNoTrans, n, k, 1.0, Q.data(), n, y.data(), 1, 1.0, x.element(), 1);
+
+            r = b - A * x;
+            residualNorm = r.L2norm();
+            if (residualNorm <= target) {
+                return true;
+            }
+            if (cycle == 0) {
+                setBasis(H, k);
+            }
+        }
+        return false;
+    }
+};
+
+#endif // CAGMRES_HPP
@@ -2,11 +2,29 @@
 #define CONJUGATEGRADIENT_HPP
 
 #include "../../Obj/VectorObj.hpp"
+#include "../Preconditioner/Preconditioner.hpp"
+#include "../Solver/SolverMonitor.hpp"
 #include <vector>
+#include <deque>
 #include <cmath>
 #include <stdexcept>
-#include <iostream> // For debugging logs
 
+namespace Krylov {
+    // Convergence tests for the conjugate gradient method
+    enum class StoppingCriterion {
+        Relative,   // ||r|| <= tol * ||b||
+        Absolute,   // ||r|| <= tol
+        EnergyNorm  // Estimated ||x - x*||_A <= tol * ||x*||_A (Hestenes-Stiefel estimate with a delay)
+    };
+}
+
+/**
+ * @brief Preconditioned conjugate gradient for symmetric positive definite systems
+ *
+ * Any Preconditioner (Jacobi, IC, AMG, ...) can be attached with setPreconditioner;
+ * it must be symmetric positive definite. solve starts from x = 0 and performs no I/O;
+ * attach a SolverMonitor to record the residual history.
+ */
 template <typename TNum, typename MatrixType, typename VectorType>
 class ConjugateGrad {
 public:
@@ -16,71 +34,175 @@ public:
     MatrixType A;          // Coefficient matrix
     VectorType b;          // Right-hand side vector
 
+private:
+    Preconditioner<TNum, VectorType>* preconditioner = nullptr;
+    SolverMonitor* monitor = nullptr;
+    Krylov::StoppingCriterion criterion = Krylov::StoppingCriterion::Relative;
+    int replacementPeriod = 0;
+    int energyDelay = 5;
+    int iterations = 0;
+    TNum residualNorm = TNum(0);
+
+public:
     // Default constructor
     ConjugateGrad() = default;
 
     // Parameterized constructor
     explicit ConjugateGrad(const MatrixType& A, const VectorType& b, int maxIter, double tol)
-        : A(std::move(A)), b(std::move(b)), _tol(tol), _maxIter(maxIter) {
-        // Initialize x to zero vector
-        x = VectorType(b.size(), 0.0);
-
-        // Compute initial residual and search direction
-        r = b - (const_cast<MatrixType&>(A) * x);
-        p = r;
+        : x(b.size(), TNum(0)), _tol(tol), _maxIter(maxIter), A(A), b(b) {
+        if (A.getRows() != A.getCols() || A.getRows() != static_cast<int>(b.size())) {
+            throw std::invalid_argument("Matrix dimensions must match vector size");
+        }
     }
 
     // Virtual destructor
     virtual ~ConjugateGrad() = default;
 
-    void solve(VectorType& x_out) {
-        TNum rs_old = r * r;
-        TNum b_norm = b.L2norm();
-        if (b_norm < 1e-12) {
+    // The preconditioner is not owned and must outlive the calls to solve
+    void setPreconditioner(Preconditioner<TNum, VectorType>& M) {
+        preconditioner = &M;
+    }
+
+    // The monitor is not owned; it records ||r|| after every iteration
+    void setMonitor(SolverMonitor& m) {
+        monitor = &m;
+    }
+
+    // delay: number of iterations looked ahead by the energy-norm error estimate
+    void setStoppingCriterion(Krylov::StoppingCriterion stop, int delay = 5) {
+        if (delay < 1) {
+            throw std::invalid_argument("Energy-norm estimate delay must be positive");
+        }
+        criterion = stop;
+        energyDelay = delay;
+    }
+
+    // Replace the recursive residual by b - A x every `period` iterations (0 disables)
+    void setResidualReplacement(int period) {
+        if (period < 0) {
+            throw std::invalid_argument("Residual replacement period must be non-negative");
+        }
+        replacementPeriod = period;
+    }
+
+    int getIterations() const { return iterations; }
+    TNum getResidualNorm() const { return residualNorm; }
+
+    // Returns true if the stopping criterion was met within _maxIter iterations
+    bool solve(VectorType& x_out) {
+        const int n = b.size();
+        iterations = 0;
+        x = VectorType(n, TNum(0));
+        r = b;
+        const TNum b_norm = b.L2norm();
+        residualNorm = b_norm;
+        if (monitor) {
+            monitor->start();
+            monitor->record(SolverMonitor::Event::Iteration, 0, residualNorm);
+        }
+        if (b_norm == TNum(0)) {
+            if (monitor) monitor->record(SolverMonitor::Event::Converged, 0, residualNorm);
             x_out = x; // Solution is zero for zero RHS
-            return;
+            return true;
         }
 
-        // if (std::sqrt(rs_old) / b_norm < _tol) {
-        //     x_out = x; // Already converged
-        //     return;
-        // }
+        VectorType z = preconditioner ? preconditioner->apply(r) : r;
+        p = z;
+        TNum rz = r * z;
 
-        for (int i = 0; i < _maxIter; ++i) {
-            VectorType Ap = A * p;
-            TNum pAp = p * Ap;
+        // Terms alpha_k (r_k, z_k): their sum over all k is ||x*||_A^2 (x0 = 0), and the
+        // sum over the last `energyDelay` terms estimates ||x - x*||_A^2 at that point
+        std::deque<TNum> energyTerms;
+        TNum energyWindow = TNum(0), energyTotal = TNum(0);
 
-            if (std::abs(pAp) < 1e-12) {
-                x_out = x;
-                return;
-                // throw std::runtime_error("Breakdown: Division by near-zero in CG.");
+        bool converged = false;
+        while (iterations < _maxIter) {
+            converged = isConverged(b_norm, energyWindow, energyTotal, energyTerms.size());
+            if (converged) {
+                break;
             }
 
-            TNum alpha = rs_old / pAp;
-            x = x + p * alpha;
-            r = r - Ap * alpha;
-
-            TNum rs_new = r * r;
+            VectorType Ap = A * p;
+            const TNum pAp = p * Ap;
+            if (!(pAp > TNum(0))) {
+                throw std::runtime_error("CG breakdown: matrix is not positive definite");
+            }
+            const TNum alpha = rz / pAp;
+            x.axpy(alpha, p);
+            r.axpy(-alpha, Ap);
+            ++iterations;
+
+            energyTerms.push_back(alpha * rz);
+            energyWindow += alpha * rz;
+            energyTotal += alpha * rz;
+            if (static_cast<int>(energyTerms.size()) > energyDelay) {
+                energyWindow -= energyTerms.front();
+                energyTerms.pop_front();
+            }
 
-            // Debugging logs
-            std::cout << "Iteration " << i << ":\n"
-                      << "  Residual norm: " << std::sqrt(rs_new) << "\n"
-                      << "  Alpha: " << alpha << "\n"
-                      << "  Solution: [";
-            for (int j = 0; j < x.size(); ++j) {
-                std::cout << x[j] << (j + 1 < x.size() ? ", " : "");
+            if (replacementPeriod > 0 && iterations % replacementPeriod == 0) {
+                r = b - A * x;
             }
-            std::cout << "]\n";
 
-            // if (std::sqrt(rs_new) / b_norm < _tol) {
-            //     break;
-            // }
+            TNum rzNew, rr;
+            if (preconditioner) {
+                z = preconditioner->apply(r);
+                dot2(r, z, rzNew, rr);
+            } else {
+                rzNew = rr = r * r;
+            }
+            residualNorm = std::sqrt(rr);
+            if (monitor) monitor->record(SolverMonitor::Event::Iteration, iterations, residualNorm);
+            if (rr == TNum(0)) {
+                converged = true;
+                break;
+            }
 
-            p = r + p * (rs_new / rs_old);
-            rs_old = rs_new;
+            // p = z + beta p
+            const TNum beta = rzNew / rz;
+            const VectorType& dir = preconditioner ? z : r;
+            TNum* pp = p.element();
+            const TNum* zp = dir.element();
+            for (int i = 0; i < n; ++i) pp[i] = zp[i] + beta * pp[i];
+            rz = rzNew;
+        }
+        if (!converged) {
+            converged = isConverged(b_norm, energyWindow, energyTotal, energyTerms.size());
+        }
+        if (monitor) {
+            monitor->record(converged ? SolverMonitor::Event::Converged : SolverMonitor::Event::MaxIterations,
+                            iterations, residualNorm);
         }
 
         x_out = x;
+        return converged;
+    }
+
+private:
+    bool isConverged(TNum b_norm, TNum energyWindow, TNum energyTotal, size_t terms) const {
+        switch (criterion) {
+            case Krylov::StoppingCriterion::Absolute:
+                return residualNorm <= _tol;
+            case Krylov::StoppingCriterion::EnergyNorm:
+                // The estimate is only available once `energyDelay` terms have been seen
+                return static_cast<int>(terms) >= energyDelay && energyWindow <= _tol * _tol * energyTotal;
+            case Krylov::StoppingCriterion::Relative:
+            default:
+                return residualNorm <= _tol * b_norm;
+        }
+    }
+
+    // (r, z) and (r, r) in one pass
+    static void dot2(const VectorType& r, const VectorType& z, TNum& rz, TNum& rr) {
+        const TNum* rp = r.element();
+        const TNum* zp = z.element();
+        const int n = r.size();
+        rz = TNum(0);
+        rr = TNum(0);
+        for (int i = 0; i < n; ++i) {
+            rz += rp[i] * zp[i];
+            rr += rp[i] * rp[i];
+        }
     }
 };
 
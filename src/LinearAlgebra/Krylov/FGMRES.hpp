@@ -0,0 +1,138 @@
+#ifndef FGMRES_HPP
+#define FGMRES_HPP
+
+#include <vector>
+#include <cmath>
+#include <stdexcept>
+#include <algorithm>
+#include "../../Obj/DenseObj.hpp"
+#include "../../Obj/SparseObj.hpp"
+#include "../../Obj/VectorObj.hpp"
+#include "../Preconditioner/Preconditioner.hpp"
+#include "KrylovSubspace.hpp"
+
+/**
+ * @brief Flexible GMRES(m) with right preconditioning
+ *
+ * The preconditioned vectors z_j = M_j^(-1) v_j are stored next to the Arnoldi
+ * basis and the update is x += Z y, so the preconditioner may change from one
+ * iteration to the next (AMG cycles, inner Krylov solves, ...). The residual
+ * minimized is the true residual b - A x. Without a preconditioner this is
+ * plain right-preconditioned GMRES with M = I.
+ */
+template <typename TNum, typename MatrixType = SparseMatrixCSC<TNum>, typename VectorType = VectorObj<TNum>>
+class FGMRES {
+private:
+    Preconditioner<TNum, VectorType>* preconditioner = nullptr;
+    Krylov::Orthogonalization orthogonalization = Krylov::Orthogonalization::CGS2;
+    int iterations = 0;
+    TNum residualNorm = TNum(0);
+
+public:
+    FGMRES() = default;
+    virtual ~FGMRES() = default;
+
+    // The preconditioner is not owned and must outlive the calls to solve
+    void setPreconditioner(Preconditioner<TNum, VectorType>& M) {
+        preconditioner = &M;
+    }
+
+    void setOrthogonalization(Krylov::Orthogonalization method) {
+        orthogonalization = method;
+    }
+
+    // Total number of inner iterations and final residual norm of the last solve
+    int getIterations() const { return iterations; }
+    TNum getResidualNorm() const { return residualNorm; }
+
+    /**
+     * @brief Solve A x = b starting from the initial guess in x
+     * @param maxIter Maximum number of restart cycles
+     * @param KrylovDim Restart length m
+     * @param tol Absolute tolerance on ||b - A x||
+     * @return true if the tolerance was reached
+     */
+    bool solve(const MatrixType& A, const VectorType& b, VectorType& x, int maxIter, int KrylovDim, double tol) {
+        const int n = b.size();
+        if (A.getRows() != n || A.getCols() != n) {
+            throw std::invalid_argument("Matrix dimensions must match vector size");
+        }
+        if (static_cast<int>(x.size()) != n) {
+            throw std::invalid_argument("Initial guess vector must match system size");
+        }
+        if (KrylovDim <= 0 || KrylovDim > n) {
+            throw std::invalid_argument("Invalid Krylov subspace dimension");
+        }
+
+        iterations = 0;
+        VectorType r = b - A * x;
+        TNum beta = r.L2norm();
+        residualNorm = beta;
+        if (beta < tol) {
+            return true;
+        }
+
+        DenseObj<TNum> V(n, KrylovDim + 1);
+        DenseObj<TNum> Z(n, KrylovDim);
+        DenseObj<TNum> H(KrylovDim + 1, KrylovDim);
+        std::vector<TNum> cs(KrylovDim, TNum(1));
+        std::vector<TNum> sn(KrylovDim, TNum(0));
+        std::vector<TNum> g(KrylovDim + 1, TNum(0));
+
+        for (int iter = 0; iter < maxIter; ++iter) {
+            std::fill(g.begin(), g.end(), TNum(0));
+            g[0] = beta;
+            const TNum* rp = r.element();
+            TNum* v0 = V.data();
+            for (int i = 0; i < n; ++i) v0[i] = rp[i] / beta;
+
+            int k = KrylovDim;
+            for (int j = 0; j < KrylovDim; ++j) {
+                ++iterations;
+                VectorType vj(V.data() + static_cast<size_t>(j) * n, n);
+                VectorType zj = preconditioner ? preconditioner->apply(vj) : vj;
+                if (static_cast<int>(zj.size()) != n) {
+                    throw std::runtime_error("Preconditioner returned a vector of the wrong size");
+                }
+                std::copy(zj.element(), zj.element() + n, Z.data() + static_cast<size_t>(j) * n);
+
+                VectorType w = A * zj;
+                TNum* hj = H.data() + static_cast<size_t>(j) * (KrylovDim + 1);
+                const TNum w_norm = Krylov::orthogonalize(orthogonalization, V.data(), n, j + 1, n, w.element(), hj);
+                hj[j + 1] = w_norm;
+
+                for (int i = 0; i < j; ++i) {
+                    Krylov::applyGivensRotation(hj[i], hj[i + 1], cs[i], sn[i]);
+                }
+                TNum rho;
+                Krylov::generateGivensRotation(hj[j], hj[j + 1], cs[j], sn[j], rho);
+                hj[j] = rho;
+                hj[j + 1] = TNum(0);
+                Krylov::applyGivensRotation(g[j], g[j + 1], cs[j], sn[j]);
+
+                if (w_norm < tol || std::abs(g[j + 1]) < tol) {
+                    k = j + 1;
+                    break;
+                }
+                const TNum* wp = w.element();
+                TNum* vnext = V.data() + static_cast<size_t>(j + 1) * n;
+                for (int i = 0; i < n; ++i) vnext[i] = wp[i] / w_norm;
+            }
+
+            // x = x + Z(:, 0:k) y
+            std::vector<TNum> y = Krylov::hessenbergSolve(H.data(), H.getRows(), g, k);
+            blas::gemv(CblasColMajor, CblasNoTrans, n, k, 1.0, Z.data(), n,
+                        y.data(), 1, 1.0, x.element(), 1);
+
+            r = b - A * x;
+            beta = r.L2norm();
+            residualNorm = beta;
+            if (beta < tol) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+#endif // FGMRES_HPP
@@ -0,0 +1,273 @@
+#ifndef GCRODR_HPP
+#define GCRODR_HPP
+
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include "../../Obj/Blas.hpp"
+#include "../../Obj/DenseObj.hpp"
+#include "../../Obj/SparseObj.hpp"
+#include "../../Obj/VectorObj.hpp"
+#include "../Factorized/basic.hpp"
+#include "KrylovSubspace.hpp"
+
+/**
+ * @brief GCRO-DR: GMRES with deflated restarting and subspace recycling (Parks et al. 2006)
+ *
+ * Each cycle of length m keeps k approximate harmonic Ritz vectors U (the
+ * directions GMRES restarts lose, typically the smallest eigenvalues) and runs
+ * m - k Arnoldi steps with A projected onto the complement of C = A U. The
+ * recycle space survives between calls to solve, so a sequence of slowly
+ * changing systems (Newton steps, time steps) starts each solve with the
+ * spectral information of the previous one. Call invalidate() when the
+ * operator changes too much for the old space to help.
+ */
+template <typename TNum, typename MatrixType = SparseMatrixCSC<TNum>, typename VectorType = VectorObj<TNum>>
+class GCRODR {
+private:
+    int m;                 // Cycle length (columns of the search space)
+    int kTarget;           // Requested dimension of the recycle space
+    DenseObj<TNum> U;      // Recycle space, n x k; empty when invalid
+    int iterations = 0;
+    TNum residualNorm = TNum(0);
+
+    // C = op(A) * B for column-major blocks
+    static void gemm(bool transA, int rows, int cols, int inner, const TNum* A, int lda,
+                     const TNum* B, int ldb, TNum* C, int ldc) {
+        blas::gemm(CblasColMajor, transA ? CblasTrans : CblasNoTrans, CblasNoTrans, rows, cols, inner,
+                    1.0, A, lda, B, ldb, 0.0, C, ldc);
+    }
+
+    /**
+     * Recycle space from a cycle with search space W (n x s) and A W = What Gbar:
+     * the harmonic Ritz vectors for the k smallest harmonic Ritz values span the
+     * dominant invariant subspace of (Gbar^T Gbar)^(-1) Gbar^T What^T W, computed
+     * by subspace iteration. Returns the new U and C with C = A U, C^T C = I.
+     */
+    void updateRecycleSpace(const DenseObj<TNum>& What, const DenseObj<TNum>& W, const DenseObj<TNum>& Gbar,
+                            int s, DenseObj<TNum>& Unew, DenseObj<TNum>& Cnew) const {
+        const int n = W.getRows();
+        const int ldg = Gbar.getRows();
+        const int k = std::min(kTarget, s - 1);
+
+        DenseObj<TNum> M1(s, s), WtW(s + 1, s), M2(s, s);
+        gemm(true, s, s, s + 1, Gbar.data(), ldg, Gbar.data(), ldg, M1.data(), s);
+        gemm(true, s + 1, s, n, What.data(), n, W.data(), n, WtW.data(), s + 1);
+        gemm(true, s, s, s + 1, Gbar.data(), ldg, WtW.data(), s + 1, M2.data(), s);
+        DenseObj<TNum> L;
+        basic::Cholesky<TNum, DenseObj<TNum>>(M1, L);
+        const DenseObj<TNum> Lt = L.Transpose();
+
+        // Subspace iteration Z <- orth(M1^(-1) M2 Z)
+        DenseObj<TNum> Z(s, k), R(k, k);
+        for (int j = 0; j < k; ++j) {
+            for (int i = 0; i < s; ++i) Z(i, j) = std::cos(TNum(1 + i) * TNum(1 + j));
+        }
+        int rank = Krylov::orthonormalizeBlock(Z.data(), s, k, s, R.data(), k, TNum(1e-12));
+        for (int it = 0; it < 100 && rank > 0; ++it) {
+            DenseObj<TNum> MZ(s, rank);
+            gemm(false, s, rank, s, M2.data(), s, Z.data(), s, MZ.data(), s);
+            MZ = basic::TriangularSolve(Lt, basic::TriangularSolve(L, MZ, true), false);
+            // Converged when the new block stays in span(Z)
+            DenseObj<TNum> proj(rank, rank);
+            gemm(true, rank, rank, s, Z.data(), s, MZ.data(), s, proj.data(), rank);
+            DenseObj<TNum> Zn(s, rank);
+            std::copy(MZ.data(), MZ.data() + static_cast<size_t>(s) * rank, Zn.data());
+            DenseObj<TNum> Rn(rank, rank);
+            const int newRank = Krylov::orthonormalizeBlock(Zn.data(), s, rank, s, Rn.data(), rank, TNum(1e-12));
+            TNum change = TNum(0);
+            for (int j = 0; j < newRank; ++j) {
+                TNum inSpan = TNum(0);
+                for (int c = 0; c < rank; ++c) {
+                    const TNum d = blas::dot(s, Z.data() + static_cast<size_t>(c) * s, 1, Zn.data() + static_cast<size_t>(j) * s, 1);
+                    inSpan += d * d;
+                }
+                change = std::max(change, TNum(1) - inSpan);
+            }
+            Z = DenseObj<TNum>(s, newRank);
+            std::copy(Zn.data(), Zn.data() + static_cast<size_t>(s) * newRank, Z.data());
+            rank = newRank;
+            if (change < TNum(1e-10)) break;
+        }
+        if (rank == 0) {
+            Unew = DenseObj<TNum>();
+            Cnew = DenseObj<TNum>();
+            return;
+        }
+
+        // Y = W Z, Gbar Z = Q R, C = What Q, U = Y R^(-1)
+        DenseObj<TNum> GZ(s + 1, rank), RQ(rank, rank);
+        gemm(false, s + 1, rank, s, Gbar.data(), ldg, Z.data(), s, GZ.data(), s + 1);
+        const int qRank = Krylov::orthonormalizeBlock(GZ.data(), s + 1, rank, s + 1, RQ.data(), rank, TNum(1e-12));
+        if (qRank < rank) {
+            Unew = DenseObj<TNum>();
+            Cnew = DenseObj<TNum>();
+            return;
+        }
+        Cnew = DenseObj<TNum>(n, rank);
+        gemm(false, n, rank, s + 1, What.data(), n, GZ.data(), s + 1, Cnew.data(), n);
+        Unew = DenseObj<TNum>(n, rank);
+        gemm(false, n, rank, s, W.data(), n, Z.data(), s, Unew.data(), n);
+        blas::trsm(CblasColMajor, CblasRight, CblasUpper, CblasNoTrans, CblasNonUnit,
+                    n, rank, 1.0, RQ.data(), rank, Unew.data(), n);
+    }
+
+public:
+    explicit GCRODR(int m = 30, int k = 10) : m(m), kTarget(k) {
+        if (k < 1 || m <= k) {
+            throw std::invalid_argument("GCRO-DR requires 1 <= k < m");
+        }
+    }
+    virtual ~GCRODR() = default;
+
+    // Drop the recycle space; the next solve starts like plain GMRES(m)
+    void invalidate() { U = DenseObj<TNum>(); }
+    bool hasRecycleSpace() const { return U.getCols() > 0; }
+    int getRecycleDimension() const { return U.getCols(); }
+
+    // Number of SpMVs in the last solve and its final residual norm
+    int getIterations() const { return iterations; }
+    TNum getResidualNorm() const { return residualNorm; }
+
+    /**
+     * @brief Solve A x = b from the initial guess in x, reusing and then updating the recycle space
+     * @param maxIter Maximum number of cycles
+     * @param tol Tolerance on the relative residual ||b - A x|| / ||b||
+     * @return true if the tolerance was reached
+     */
+    bool solve(const MatrixType& A, const VectorType& b, VectorType& x, int maxIter, double tol) {
+        const int n = b.size();
+        if (A.getRows() != n || A.getCols() != n) {
+            throw std::invalid_argument("Matrix dimensions must match vector size");
+        }
+        if (static_cast<int>(x.size()) != n) {
+            throw std::invalid_argument("Initial guess vector must match system size");
+        }
+        if (m > n) {
+            throw std::invalid_argument("Cycle length exceeds the system size");
+        }
+        if (U.getCols() > 0 && U.getRows() != n) {
+            invalidate();  // Recycle space of a system of a different size
+        }
+
+        iterations = 0;
+        const TNum bNorm = b.L2norm();
+        VectorType r = b - A * x;
+        ++iterations;
+        residualNorm = r.L2norm();
+        const TNum target = tol * (bNorm > TNum(0) ? bNorm : TNum(1));
+        if (residualNorm <= target) {
+            return true;
+        }
+
+        // What = [C V] (n x (m+1)), W = [U~ V] (n x m), A W = What Gbar
+        DenseObj<TNum> What(n, m + 1), W(n, m), Gbar(m + 1, m);
+        int k = 0;
+        if (U.getCols() > 0) {
+            // New operator: C = A U orthonormalized, U = U R^(-1)
+            k = U.getCols();
+            DenseObj<TNum> C = A * U;
+            iterations += k;
+            DenseObj<TNum> R(k, k);
+            const int rank = Krylov::orthonormalizeBlock(C.data(), n, k, n, R.data(), k, TNum(1e-12));
+            if (rank < k) {
+                invalidate();
+                k = 0;
+            } else {
+                blas::trsm(CblasColMajor, CblasRight, CblasUpper, CblasNoTrans, CblasNonUnit,
+                            n, k, 1.0, R.data(), k, U.data(), n);
+                std::copy(C.data(), C.data() + static_cast<size_t>(n) * k, What.data());
+                // x += U C^T r, r -= C C^T r
+                std::vector<TNum> c(k);
+                blas::gemv(CblasColMajor, CblasTrans, n, k, 1.0, C.data(), n, r.element(), 1, 0.0, c.data(), 1);
+                blas::gemv(CblasColMajor, CblasNoTrans, n, k, 1.0, U.data(), n, c.data(), 1, 1.0, x.element(), 1);
+                blas::gemv(CblasColMajor, CblasNoTrans, n, k, -1.0, C.data(), n, c.data(), 1, 1.0, r.element(), 1);
+                residualNorm = r.L2norm();
+            }
+        }
+
+        std::vector<TNum> cs(m), sn(m), g(m + 1);
+        DenseObj<TNum> Rg(m + 1, m);  // Gbar reduced to triangular form by Givens rotations
+        for (int cycle = 0; cycle < maxIter && residualNorm > target; ++cycle) {
+            Gbar.zero();
+            Rg.zero();
+            std::fill(g.begin(), g.end(), TNum(0));
+            g[k] = residualNorm;
+
+            // Scaled recycle directions: A (U D) = C D
+            for (int j = 0; j < k; ++j) {
+                const TNum* uj = U.data() + static_cast<size_t>(j) * n;
+                const TNum d = TNum(1) / blas::nrm2(n, uj, 1);
+                TNum* wj = W.data() + static_cast<size_t>(j) * n;
+                for (int i = 0; i < n; ++i) wj[i] = d * uj[i];
+                Gbar(j, j) = d;
+                Rg(j, j) = d;
+                cs[j] = TNum(1);
+                sn[j] = TNum(0);
+            }
+
+            // Arnoldi with (I - C C^T) A, starting from the projected residual
+            TNum* v0 = What.data() + static_cast<size_t>(k) * n;
+            const TNum* rp = r.element();
+            for (int i = 0; i < n; ++i) v0[i] = rp[i] / residualNorm;
+            int s = k;
+            for (int col = k; col < m; ++col) {
+                TNum* vc = What.data() + static_cast<size_t>(col) * n;
+                std::copy(vc, vc + n, W.data() + static_cast<size_t>(col) * n);
+                VectorType w = A * VectorType(vc, n);
+                ++iterations;
+                TNum* gc = Gbar.data() + static_cast<size_t>(col) * (m + 1);
+                const TNum norm = Krylov::orthogonalize(Krylov::Orthogonalization::CGS2, What.data(), n, col + 1, n, w.element(), gc);
+                gc[col + 1] = norm;
+                s = col + 1;
+
+                TNum* rc = Rg.data() + static_cast<size_t>(col) * (m + 1);
+                std::copy(gc, gc + col + 2, rc);
+                for (int i = 0; i < col; ++i) {
+                    Krylov::applyGivensRotation(rc[i], rc[i + 1], cs[i], sn[i]);
+                }
+                TNum rho;
+                Krylov::generateGivensRotation(rc[col], rc[col + 1], cs[col], sn[col], rho);
+                rc[col] = rho;
+                rc[col + 1] = TNum(0);
+                Krylov::applyGivensRotation(g[col], g[col + 1], cs[col], sn[col]);
+
+                if (norm < std::numeric_limits<TNum>::epsilon() * bNorm || std::abs(g[col + 1]) <= target) {
+                    break;
+                }
+                const TNum* wp = w.element();
+                TNum* vn = What.data() + static_cast<size_t>(col + 1) * n;
+                for (int i = 0; i < n; ++i) vn[i] = wp[i] / norm;
+            }
+
+            // x += W y with y the least-squares solution
+            std::vector<TNum> y = Krylov::hessenbergSolve(Rg.data(), m + 1, g, s);
+            blas::gemv(CblasColMajor, CblasNoTrans, n, s, 1.0, W.data(), n, y.data(), 1, 1.0, x.element(), 1);
+            r = b - A * x;
+            ++iterations;
+            residualNorm = r.L2norm();
+
+            // Recycle space for the next cycle (and the next solve)
+            if (s > k || k == 0) {
+                DenseObj<TNum> Unew, Cnew;
+                updateRecycleSpace(What, W, Gbar, s, Unew, Cnew);
+                if (Unew.getCols() > 0) {
+                    U = std::move(Unew);
+                    k = U.getCols();
+                    std::copy(Cnew.data(), Cnew.data() + static_cast<size_t>(n) * k, What.data());
+                    // Keep r orthogonal to C: the new cycle starts from the projected residual
+                    std::vector<TNum> c(k);
+                    blas::gemv(CblasColMajor, CblasTrans, n, k, 1.0, What.data(), n, r.element(), 1, 0.0, c.data(), 1);
+                    blas::gemv(CblasColMajor, CblasNoTrans, n, k, 1.0, U.data(), n, c.data(), 1, 1.0, x.element(), 1);
+                    blas::gemv(CblasColMajor, CblasNoTrans, n, k, -1.0, What.data(), n, c.data(), 1, 1.0, r.element(), 1);
+                    residualNorm = r.L2norm();
+                }
+            }
+        }
+        return residualNorm <= target;
+    }
+};
+
+#endif // GCRODR_HPP
@@ -5,26 +5,49 @@
 #include <cmath>
 #include <type_traits>
 #include <stdexcept>
-#include <iostream>
 #include "../Factorized/basic.hpp"
 #include "../../Obj/SparseObj.hpp"
 #include "../../Obj/VectorObj.hpp"
 #include "../Preconditioner/ILU.hpp"
+#include "../Preconditioner/Preconditioner.hpp"
+#include "KrylovSubspace.hpp"
+#include "../Solver/SolverMonitor.hpp"
 
 template <typename TNum, typename MatrixType = SparseMatrixCSC<TNum>, typename VectorType = VectorObj<TNum>>
 class GMRES {
 private:
     ILUPreconditioner<TNum, MatrixType> preconditioner;
     bool usePreconditioner = false;
+    Preconditioner<TNum, VectorType>* external = nullptr;
+    Krylov::Orthogonalization orthogonalization = Krylov::Orthogonalization::CGS2;
+    SolverMonitor* monitor = nullptr;
 public:
     GMRES() = default;
     virtual ~GMRES() = default;
 
+    // Left preconditioning with an ILU(0) computed from A at every solve
     void enablePreconditioner() {
         usePreconditioner = true;
     }
 
-    void solve(const MatrixType& A, const VectorType& b, VectorType& x, int maxIter, int KrylovDim, double tol) {
+    // Left preconditioning with an already computed M (Jacobi, IC, AMG, ...); it is
+    // not owned, must outlive the calls to solve and replaces the internal ILU
+    void setPreconditioner(Preconditioner<TNum, VectorType>& M) {
+        external = &M;
+    }
+
+    // Select the Gram-Schmidt variant used by the Arnoldi process (CGS2 by default)
+    void setOrthogonalization(Krylov::Orthogonalization method) {
+        orthogonalization = method;
+    }
+
+    // Record residuals and restarts into `m` (not owned); solve performs no I/O
+    void setMonitor(SolverMonitor& m) {
+        monitor = &m;
+    }
+
+    // Returns true if the (preconditioned) residual norm dropped below tol
+    bool solve(const MatrixType& A, const VectorType& b, VectorType& x, int maxIter, int KrylovDim, double tol) {
         const int n = b.size();
         if (A.getRows() != n || A.getCols() != n) {
             throw std::invalid_argument("Matrix dimensions must match vector size");
@@ -36,138 +59,94 @@ public:
             throw std::invalid_argument("Invalid Krylov subspace dimension");
         }
 
-        if (usePreconditioner) {
+        if (usePreconditioner && !external) {
             preconditioner.compute(A);  // Compute ILU factorization once
         }
-        VectorType r = b - A * x;
-        if (usePreconditioner) {
-            r = preconditioner.solve(r);  // Apply M^(-1)(b - Ax)
-        }
+        VectorType r = precondition(b - A * x);  // M^(-1)(b - Ax)
 
         double beta = r.L2norm();
-        std::cout << "Initial residual norm: " << beta << std::endl;
+        if (monitor) {
+            monitor->start();
+            monitor->record(SolverMonitor::Event::Restart, 0, beta);
+        }
         if (beta < tol) {
-            std::cout << "Initial guess is good enough." << std::endl;
-            return; // Initial guess is good enough
+            if (monitor) monitor->record(SolverMonitor::Event::Converged, 0, beta);
+            return true; // Initial guess is good enough
         }
+        int iterations = 0;
 
-        std::vector<VectorType> V(KrylovDim + 1, VectorType(n));
-        MatrixType H(KrylovDim + 1, KrylovDim + 1);
+        // Krylov basis stored column by column so that the block projections
+        // of CGS2/LowSync run as single gemv calls
+        DenseObj<TNum> V(n, KrylovDim + 1);
+        DenseObj<TNum> H(KrylovDim + 1, KrylovDim);
         std::vector<TNum> cs(KrylovDim, TNum(1));
         std::vector<TNum> sn(KrylovDim, TNum(0));
-        std::vector<TNum> rho(KrylovDim, TNum(0));
-        VectorType e1(KrylovDim + 1, TNum(0));
-        e1[0] = beta;
+        std::vector<TNum> e1(KrylovDim + 1, TNum(0));
 
         for (int iter = 0; iter < maxIter; iter++) {
-            V[0] = r / beta;
+            std::fill(e1.begin(), e1.end(), TNum(0));
+            e1[0] = beta;
+            const TNum* rp = r.element();
+            TNum* v0 = V.data();
+            for (int i = 0; i < n; ++i) v0[i] = rp[i] / beta;
+
             int KryUpdate = KrylovDim;
             for (int j = 0; j < KrylovDim; ++j) {
-                VectorType w;
-                if (usePreconditioner) {
-                    w = preconditioner.solve(A * V[j]);  // Apply M^(-1)A to v_j
-                } else {
-                    w = A * V[j];
-                }
+                VectorType w = precondition(A * VectorType(V.data() + static_cast<size_t>(j) * n, n));  // M^(-1)A v_j
+
+                TNum* hj = H.data() + static_cast<size_t>(j) * (KrylovDim + 1);
+                const TNum w_norm = Krylov::orthogonalize(orthogonalization, V.data(), n, j + 1, n, w.element(), hj);
+                hj[j + 1] = w_norm;
 
+                // Apply the previous Givens rotations to the new column, then annihilate H(j+1, j)
                 for (int i = 0; i < j; ++i) {
-                    TNum w_dot_v = V[i] * w;
-                    setMatrixValue(H, i, j, w_dot_v);
-                    w = w - V[i] * w_dot_v;
+                    Krylov::applyGivensRotation(hj[i], hj[i + 1], cs[i], sn[i]);
                 }
-                
-                TNum w_norm = w.L2norm();
-                setMatrixValue(H, j + 1, j, w_norm);
-                if (w_norm < tol) {
-                    KryUpdate = j;
-                    std::cout << "KrylovUpdate : " << KryUpdate << std::endl;
+                TNum rho;
+                Krylov::generateGivensRotation(hj[j], hj[j + 1], cs[j], sn[j], rho);
+                hj[j] = rho;
+                hj[j + 1] = TNum(0);
+                Krylov::applyGivensRotation(e1[j], e1[j + 1], cs[j], sn[j]);
+                ++iterations;
+                if (monitor) monitor->record(SolverMonitor::Event::Iteration, iterations, std::abs(e1[j + 1]));
+
+                // Lucky breakdown or converged within the cycle
+                if (w_norm < tol || std::abs(e1[j + 1]) < tol) {
+                    KryUpdate = j + 1;
                     break;
                 }
-                V[j + 1] = w / H(j + 1, j);
-
-                // Apply Givens rotations
-                for (int i = 0; i < j; ++i) {
-                    applyMatrixGivensRotation(H, i, j, i + 1, j, cs[i], sn[i]);
-                }
-                generateGivensRotation(H(j, j), H(j + 1, j), cs[j], sn[j], rho[j]);
-                setMatrixValue(H, j, j, rho[j]);
-                setMatrixValue(H, j + 1, j, TNum(0));
-                applyGivensRotation(e1[j], e1[j + 1], cs[j], sn[j]);
+                const TNum* wp = w.element();
+                TNum* vj = V.data() + static_cast<size_t>(j + 1) * n;
+                for (int i = 0; i < n; ++i) vj[i] = wp[i] / w_norm;
             }
 
             updateSolution(x, H, V, e1, KryUpdate);
-            r = b - A * x;
-            if (usePreconditioner) {
-                r = preconditioner.solve(r);  // Apply M^(-1) to the residual
-            }
+            r = precondition(b - A * x);
 
             beta = r.L2norm();
-            std::cout << "Residual norm after restart: " << beta << " " << std::endl;
+            if (monitor) monitor->record(SolverMonitor::Event::Restart, iterations, beta);
 
             if (beta < tol) {
-                std::cout << "Converged after restart at iteration " << iter << std::endl;
-                return; // Converged
+                if (monitor) monitor->record(SolverMonitor::Event::Converged, iterations, beta);
+                return true; // Converged
             }
-            e1 = VectorType(KrylovDim + 1, TNum(0));
-            e1[0] = beta;
         }
-        std::cout << "Reached maximum iterations without convergence." << std::endl;
+        if (monitor) monitor->record(SolverMonitor::Event::MaxIterations, iterations, beta);
+        return false;
     }
 
 private:
-    void setMatrixValue(DenseObj<TNum>& H, int i, int j, TNum value) {
-        H(i, j) = value;
-    }
-
-    void setMatrixValue(SparseMatrixCSC<TNum>& H, int i, int j, TNum value) {
-        H.addValue(i, j, value);
-        H.finalize();
-        // printf(" i : %d j : %d H: %f value : %f \n",i, j, H(i, j), value);
-    }
-
-    void applyGivensRotation(TNum& dx, TNum& dy, TNum cs, TNum sn) {
-        TNum temp = dx;
-        dx = cs * temp + sn * dy;
-        dy = -sn * temp + cs * dy;
-    }
-
-    void applyMatrixGivensRotation(MatrixType& H, int i, int j, int ii, int jj, TNum cs, TNum sn) {
-        TNum temp = H(i, j);
-        setMatrixValue(H, i, j,  cs * H(i, j) + sn * H(ii, jj));
-        setMatrixValue(H, ii, jj, -sn * temp + cs * H(ii, jj));
+    VectorType precondition(VectorType v) {
+        if (external) return external->apply(v);
+        if (usePreconditioner) return preconditioner.solve(v);
+        return v;
     }
 
-    void generateGivensRotation(TNum dx, TNum dy, TNum& cs, TNum& sn, TNum& rho) {
-        rho = std::sqrt(dx * dx + dy * dy);
-        // Protect against division by zero
-        if (std::abs(rho) < std::numeric_limits<TNum>::epsilon()) {
-            cs = TNum(1);
-            sn = TNum(0);
-            rho = TNum(0);
-        } else {
-            cs = dx / rho;
-            sn = dy / rho;
-        }
-    }
-
-    void updateSolution(VectorType& x, const MatrixType& H, const std::vector<VectorType>& V, const VectorType& e1, int k) {
-        VectorType y(k, TNum(0));
-        // Back substitution for solving upper triangular system Hy = e1
-        for (int i = k - 1; i >= 0; --i) {
-            y[i] = e1[i];
-            for (int j = i + 1; j < k; ++j) {
-                y[i] = y[i] - H(i, j) * y[j];
-            }
-            // Check for zero diagonal element to avoid division by zero
-            if (std::abs(H(i, i)) < std::numeric_limits<TNum>::epsilon()) {
-                throw std::runtime_error("GMRES updateSolution: Zero diagonal element encountered in H.");
-            }
-            y[i] = y[i] / H(i, i);
-        }
-        // Update solution: x = x + sum_i {V[i] * y[i]}
-        for (int i = 0; i < k; ++i) {
-            x = x + (V[i] * y[i]);
-        }
+    void updateSolution(VectorType& x, const DenseObj<TNum>& H, const DenseObj<TNum>& V, const std::vector<TNum>& e1, int k) {
+        std::vector<TNum> y = Krylov::hessenbergSolve(H.data(), H.getRows(), e1, k);
+        // Update solution: x = x + V(:, 0:k) y
+        blas::gemv(CblasColMajor, CblasNoTrans, V.getRows(), k, 1.0, V.data(), V.getRows(),
+                    y.data(), 1, 1.0, x.element(), 1);
     }
 };
 
@@ -0,0 +1,202 @@
+#ifndef IDR_HPP
+#define IDR_HPP
+
+#include <vector>
+#include <cmath>
+#include <random>
+#include <algorithm>
+#include <stdexcept>
+#include "../../Obj/Blas.hpp"
+#include "../../Obj/DenseObj.hpp"
+#include "../../Obj/SparseObj.hpp"
+#include "../../Obj/VectorObj.hpp"
+#include "../Preconditioner/Preconditioner.hpp"
+
+/**
+ * @brief IDR(s) with biorthogonalization (van Gijzen & Sonneveld, ACM TOMS 913)
+ *
+ * Induced dimension reduction keeps the residuals in a sequence of shrinking
+ * subspaces defined by s random shadow vectors P. It needs 3s + 5 vectors
+ * regardless of the iteration count and at most n + n/s SpMVs in exact
+ * arithmetic; s = 4 is a good default for convection-dominated problems.
+ *
+ * The preconditioner is applied to the update directions (right
+ * preconditioning), so the residual monitored is b - A x.
+ */
+template <typename TNum, typename MatrixType = SparseMatrixCSC<TNum>, typename VectorType = VectorObj<TNum>>
+class IDR {
+private:
+    int s;
+    Preconditioner<TNum, VectorType>* preconditioner = nullptr;
+    int iterations = 0;
+    TNum residualNorm = TNum(0);
+    unsigned int seed = 1234;
+
+    VectorType precondition(const VectorType& v) {
+        return preconditioner ? preconditioner->apply(v) : v;
+    }
+
+    // Random shadow space with orthonormal columns
+    DenseObj<TNum> shadowSpace(int n) {
+        std::mt19937 gen(seed);
+        std::normal_distribution<TNum> dis(TNum(0), TNum(1));
+        DenseObj<TNum> P(n, s);
+        for (int k = 0; k < s; ++k) {
+            TNum* pk = P.data() + static_cast<size_t>(k) * n;
+            for (int i = 0; i < n; ++i) pk[i] = dis(gen);
+            for (int i = 0; i < k; ++i) {
+                const TNum* pi = P.data() + static_cast<size_t>(i) * n;
+                blas::axpy(n, -blas::dot(n, pi, 1, pk, 1), pi, 1, pk, 1);
+            }
+            blas::scal(n, 1.0 / blas::nrm2(n, pk, 1), pk, 1);
+        }
+        return P;
+    }
+
+public:
+    explicit IDR(int s = 4) : s(s) {
+        if (s < 1) {
+            throw std::invalid_argument("IDR(s) requires s >= 1");
+        }
+    }
+    virtual ~IDR() = default;
+
+    // The preconditioner is not owned and must outlive the calls to solve
+    void setPreconditioner(Preconditioner<TNum, VectorType>& M) {
+        preconditioner = &M;
+    }
+
+    // Seed of the random shadow space, for reproducible iteration counts
+    void setSeed(unsigned int value) { seed = value; }
+
+    // Number of SpMVs (one per inner step and one per dimension-reduction step)
+    int getIterations() const { return iterations; }
+    TNum getResidualNorm() const { return residualNorm; }
+
+    /**
+     * @brief Solve A x = b starting from the initial guess in x
+     * @param maxIter Maximum number of SpMVs
+     * @param tol Tolerance on the relative residual ||b - A x|| / ||b||
+     * @return true if the tolerance was reached
+     */
+    bool solve(const MatrixType& A, const VectorType& b, VectorType& x, int maxIter, double tol) {
+        const int n = b.size();
+        if (A.getRows() != n || A.getCols() != n) {
+            throw std::invalid_argument("Matrix dimensions must match vector size");
+        }
+        if (static_cast<int>(x.size()) != n) {
+            throw std::invalid_argument("Initial guess vector must match system size");
+        }
+        if (s > n) {
+            throw std::invalid_argument("Shadow space dimension exceeds the system size");
+        }
+
+        iterations = 0;
+        const TNum bNorm = b.L2norm();
+        if (bNorm == TNum(0)) {
+            x = VectorType(n, TNum(0));
+            residualNorm = TNum(0);
+            return true;
+        }
+
+        VectorType r = b - A * x;
+        residualNorm = r.L2norm();
+        if (residualNorm <= tol * bNorm) {
+            return true;
+        }
+
+        const DenseObj<TNum> P = shadowSpace(n);
+        DenseObj<TNum> G(n, s);   // A U, kept biorthogonal to P
+        DenseObj<TNum> U(n, s);   // Update directions
+        DenseObj<TNum> M(s, s);   // P^T G, lower triangular
+        for (int i = 0; i < s; ++i) M(i, i) = TNum(1);
+        std::vector<TNum> f(s), c(s);
+        TNum omega = TNum(1);
+        const TNum kappa = TNum(0.7); // Angle safeguard for omega
+
+        auto col = [n](DenseObj<TNum>& D, int k) { return D.data() + static_cast<size_t>(k) * n; };
+
+        while (iterations < maxIter) {
+            // f = P^T r
+            blas::gemv(CblasColMajor, CblasTrans, n, s, 1.0, P.data(), n, r.element(), 1, 0.0, f.data(), 1);
+
+            for (int k = 0; k < s; ++k) {
+                // Solve the lower triangular system M(k:s, k:s) c = f(k:s)
+                for (int i = k; i < s; ++i) {
+                    TNum sum = f[i];
+                    for (int j = k; j < i; ++j) sum -= M(i, j) * c[j];
+                    c[i] = sum / M(i, i);
+                }
+
+                // v = M^(-1) (r - G(:, k:s) c)
+                VectorType v = r;
+                blas::gemv(CblasColMajor, CblasNoTrans, n, s - k, -1.0, col(G, k), n, c.data() + k, 1, 1.0, v.element(), 1);
+                v = precondition(v);
+
+                // U(:, k) = U(:, k:s) c + omega v
+                VectorType uk = v * omega;
+                blas::gemv(CblasColMajor, CblasNoTrans, n, s - k, 1.0, col(U, k), n, c.data() + k, 1, 1.0, uk.element(), 1);
+                VectorType gk = A * uk;
+                ++iterations;
+
+                // Make G(:, k) orthogonal to P(:, 0:k)
+                for (int i = 0; i < k; ++i) {
+                    const TNum a = blas::dot(n, P.data() + static_cast<size_t>(i) * n, 1, gk.element(), 1) / M(i, i);
+                    blas::axpy(n, -a, col(G, i), 1, gk.element(), 1);
+                    blas::axpy(n, -a, col(U, i), 1, uk.element(), 1);
+                }
+                std::copy(gk.element(), gk.element() + n, col(G, k));
+                std::copy(uk.element(), uk.element() + n, col(U, k));
+
+                // New column of M = P^T G
+                for (int i = k; i < s; ++i) {
+                    M(i, k) = blas::dot(n, P.data() + static_cast<size_t>(i) * n, 1, gk.element(), 1);
+                }
+                if (M(k, k) == TNum(0)) {
+                    throw std::runtime_error("IDR(s) breakdown: singular projected system");
+                }
+
+                // Make r orthogonal to P(:, 0:k)
+                const TNum beta = f[k] / M(k, k);
+                r.axpy(-beta, gk);
+                x.axpy(beta, uk);
+                residualNorm = r.L2norm();
+                if (residualNorm <= tol * bNorm) {
+                    return true;
+                }
+                for (int i = k + 1; i < s; ++i) f[i] -= beta * M(i, k);
+                if (iterations >= maxIter) {
+                    return false;
+                }
+            }
+
+            // Dimension reduction step: enter the next IDR subspace
+            VectorType v = precondition(r);
+            VectorType t = A * v;
+            ++iterations;
+            const TNum tt = t * t;
+            if (tt == TNum(0)) {
+                throw std::runtime_error("IDR(s) breakdown: A M^(-1) r = 0");
+            }
+            const TNum tr = t * r;
+            // t orthogonal to r (e.g. skew-symmetric A M^(-1)): omega = 0 and the safeguard would divide by rho = 0
+            if (tr == TNum(0)) {
+                throw std::runtime_error("IDR(s) breakdown: omega = 0");
+            }
+            omega = tr / tt;
+            const TNum rho = std::abs(tr) / (std::sqrt(tt) * residualNorm);
+            if (rho < kappa) {
+                omega *= kappa / rho;
+            }
+            r.axpy(-omega, t);
+            x.axpy(omega, v);
+            residualNorm = r.L2norm();
+            if (residualNorm <= tol * bNorm) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+#endif // IDR_HPP
@@ -4,9 +4,484 @@
 #include <iostream>
 #include <vector>
 #include <cmath>
+#include <complex>
 #include <cassert>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include "../../Obj/Blas.hpp"
 
 namespace Krylov {
+    // Orthogonalization schemes for the Arnoldi process
+    enum class Orthogonalization {
+        MGS,     // Modified Gram-Schmidt: k dot products and k updates, one after another
+        CGS2,    // Classical Gram-Schmidt applied twice: two block projections through gemv
+        LowSync  // One fused reduction (projections and norm); a second pass only if cancellation is detected
+    };
+
+    /**
+     * @brief Orthogonalize w against the k orthonormal columns of V
+     * @param V Column-major basis (n x k) with leading dimension ldv
+     * @param w Vector of length n, overwritten with its component orthogonal to V
+     * @param h Output, h[0..k-1] receives the projection coefficients V^T w
+     * @return Norm of the orthogonalized w
+     */
+    template<typename TNum>
+    TNum orthogonalize(Orthogonalization method, const TNum* V, int n, int k, int ldv, TNum* w, TNum* h) {
+        if (k == 0) {
+            return blas::nrm2(n, w, 1);
+        }
+
+        if (method == Orthogonalization::MGS) {
+            for (int i = 0; i < k; ++i) {
+                h[i] = blas::dot(n, V + static_cast<size_t>(i) * ldv, 1, w, 1);
+                blas::axpy(n, -h[i], V + static_cast<size_t>(i) * ldv, 1, w, 1);
+            }
+            return blas::nrm2(n, w, 1);
+        }
+
+        std::vector<TNum> c(k);
+        if (method == Orthogonalization::CGS2) {
+            // h = V^T w, w -= V h, then the same once more to restore orthogonality
+            blas::gemv(CblasColMajor, CblasTrans, n, k, 1.0, V, ldv, w, 1, 0.0, h, 1);
+            blas::gemv(CblasColMajor, CblasNoTrans, n, k, -1.0, V, ldv, h, 1, 1.0, w, 1);
+            blas::gemv(CblasColMajor, CblasTrans, n, k, 1.0, V, ldv, w, 1, 0.0, c.data(), 1);
+            blas::gemv(CblasColMajor, CblasNoTrans, n, k, -1.0, V, ldv, c.data(), 1, 1.0, w, 1);
+            for (int i = 0; i < k; ++i) h[i] += c[i];
+            return blas::nrm2(n, w, 1);
+        }
+
+        // LowSync: V^T w and w^T w in a single pass over memory (one reduction),
+        // the new norm follows from Pythagoras: ||w - V h||^2 = ||w||^2 - ||h||^2
+        std::vector<TNum> red(k + 1, TNum(0));
+        TNum* acc = red.data();
+        const int rowBlock = 512;
+        const int blocks = (n + rowBlock - 1) / rowBlock;
+        #pragma omp parallel for reduction(+:acc[:k + 1])
+        for (int b = 0; b < blocks; ++b) {
+            const int i0 = b * rowBlock;
+            const int i1 = std::min(n, i0 + rowBlock);
+            for (int c0 = 0; c0 < k; ++c0) {
+                const TNum* v = V + static_cast<size_t>(c0) * ldv;
+                TNum sum = TNum(0);
+                for (int i = i0; i < i1; ++i) sum += v[i] * w[i];
+                acc[c0] += sum;
+            }
+            TNum sum = TNum(0);
+            for (int i = i0; i < i1; ++i) sum += w[i] * w[i];
+            acc[k] += sum;
+        }
+
+        TNum hh = TNum(0);
+        for (int i = 0; i < k; ++i) {
+            h[i] = red[i];
+            hh += h[i] * h[i];
+        }
+        blas::gemv(CblasColMajor, CblasNoTrans, n, k, -1.0, V, ldv, h, 1, 1.0, w, 1);
+
+        const TNum normSq = red[k] - hh;
+        if (normSq > TNum(0.5) * red[k]) {
+            return std::sqrt(normSq);
+        }
+        // Severe cancellation (||w|| dropped by more than 1/sqrt(2)): reorthogonalize once
+        blas::gemv(CblasColMajor, CblasTrans, n, k, 1.0, V, ldv, w, 1, 0.0, c.data(), 1);
+        blas::gemv(CblasColMajor, CblasNoTrans, n, k, -1.0, V, ldv, c.data(), 1, 1.0, w, 1);
+        for (int i = 0; i < k; ++i) h[i] += c[i];
+        return blas::nrm2(n, w, 1);
+    }
+
+    // Givens rotation [cs sn; -sn cs] that maps (dx, dy) to (rho, 0)
+    template<typename TNum>
+    void generateGivensRotation(TNum dx, TNum dy, TNum& cs, TNum& sn, TNum& rho) {
+        rho = std::sqrt(dx * dx + dy * dy);
+        // Protect against division by zero
+        if (std::abs(rho) < std::numeric_limits<TNum>::epsilon()) {
+            cs = TNum(1);
+            sn = TNum(0);
+            rho = TNum(0);
+        } else {
+            cs = dx / rho;
+            sn = dy / rho;
+        }
+    }
+
+    template<typename TNum>
+    void applyGivensRotation(TNum& dx, TNum& dy, TNum cs, TNum sn) {
+        TNum temp = dx;
+        dx = cs * temp + sn * dy;
+        dy = -sn * temp + cs * dy;
+    }
+
+    /**
+     * @brief Back substitution R y = g on the leading k x k block of a Givens-reduced Hessenberg matrix
+     * @param R Column-major upper triangular factor with leading dimension ldr
+     */
+    template<typename TNum>
+    std::vector<TNum> hessenbergSolve(const TNum* R, int ldr, const std::vector<TNum>& g, int k) {
+        std::vector<TNum> y(k, TNum(0));
+        for (int i = k - 1; i >= 0; --i) {
+            y[i] = g[i];
+            for (int j = i + 1; j < k; ++j) {
+                y[i] -= R[i + static_cast<size_t>(j) * ldr] * y[j];
+            }
+            const TNum rii = R[i + static_cast<size_t>(i) * ldr];
+            // Check for zero diagonal element to avoid division by zero
+            if (std::abs(rii) < std::numeric_limits<TNum>::epsilon()) {
+                throw std::runtime_error("Zero diagonal element encountered in the Hessenberg factor.");
+            }
+            y[i] /= rii;
+        }
+        return y;
+    }
+
+    // Householder QR of the m x k block A (m >= k): R in the upper triangle, reflectors below it
+    template<typename TNum>
+    void householderQR(TNum* A, int m, int k, int lda, TNum* tau) {
+        for (int j = 0; j < k; ++j) {
+            TNum* aj = A + static_cast<size_t>(j) * lda;
+            const TNum alpha = aj[j];
+            const TNum sigma = blas::nrm2(m - j, aj + j, 1);
+            if (sigma == TNum(0)) {
+                tau[j] = TNum(0);
+                continue;
+            }
+            const TNum beta = alpha > TNum(0) ? -sigma : sigma;
+            // v = (a - beta e1) / (alpha - beta), stored below the diagonal with v[0] = 1
+            const TNum scale = TNum(1) / (alpha - beta);
+            for (int i = j + 1; i < m; ++i) aj[i] *= scale;
+            tau[j] = (beta - alpha) / beta;
+            aj[j] = beta;
+            for (int c = j + 1; c < k; ++c) {
+                TNum* ac = A + static_cast<size_t>(c) * lda;
+                TNum s = ac[j];
+                for (int i = j + 1; i < m; ++i) s += aj[i] * ac[i];
+                s *= tau[j];
+                ac[j] -= s;
+                for (int i = j + 1; i < m; ++i) ac[i] -= s * aj[i];
+            }
+        }
+    }
+
+    // Explicit m x k Q from the reflectors left by householderQR, written to Q with leading dimension ldq
+    template<typename TNum>
+    void householderQ(const TNum* A, int m, int k, int lda, const TNum* tau, TNum* Q, int ldq) {
+        for (int c = 0; c < k; ++c) {
+            TNum* qc = Q + static_cast<size_t>(c) * ldq;
+            std::fill(qc, qc + m, TNum(0));
+            qc[c] = TNum(1);
+        }
+        for (int j = k - 1; j >= 0; --j) {
+            const TNum* aj = A + static_cast<size_t>(j) * lda;
+            for (int c = j; c < k; ++c) {
+                TNum* qc = Q + static_cast<size_t>(c) * ldq;
+                TNum s = qc[j];
+                for (int i = j + 1; i < m; ++i) s += aj[i] * qc[i];
+                s *= tau[j];
+                qc[j] -= s;
+                for (int i = j + 1; i < m; ++i) qc[i] -= s * aj[i];
+            }
+        }
+    }
+
+    /**
+     * @brief Tall-skinny QR: W = Q R with one pass over W
+     *
+     * Row blocks of W are factored independently (in parallel), their R factors
+     * are stacked and factored once more, and the local Q factors are combined
+     * with one small gemm per block. Unlike Gram-Schmidt this needs a single
+     * global reduction and is unconditionally stable.
+     *
+     * @param W Column-major n x k block (n >= k) with leading dimension ldw, overwritten with Q
+     * @param R Output k x k upper triangular factor with leading dimension ldr
+     */
+    template<typename TNum>
+    void tsqr(TNum* W, int n, int k, int ldw, TNum* R, int ldr) {
+        if (k == 0) return;
+        if (n < k) {
+            throw std::invalid_argument("TSQR requires at least as many rows as columns");
+        }
+        const int blocks = std::max(1, std::min(64, n / std::max(4 * k, 2048)));
+        std::vector<int> start(blocks + 1);
+        for (int p = 0; p <= blocks; ++p) start[p] = static_cast<int>(static_cast<long long>(n) * p / blocks);
+
+        // Local factorizations; the R factors are stacked into S
+        const int ls = blocks * k;
+        std::vector<TNum> S(static_cast<size_t>(ls) * k, TNum(0));
+        std::vector<std::vector<TNum>> localQ(blocks);
+        #pragma omp parallel for schedule(static)
+        for (int p = 0; p < blocks; ++p) {
+            const int rows = start[p + 1] - start[p];
+            std::vector<TNum> Ap(static_cast<size_t>(rows) * k), tau(k);
+            for (int c = 0; c < k; ++c) {
+                std::copy(W + start[p] + static_cast<size_t>(c) * ldw, W + start[p + 1] + static_cast<size_t>(c) * ldw,
+                          Ap.begin() + static_cast<size_t>(c) * rows);
+            }
+            householderQR(Ap.data(), rows, k, rows, tau.data());
+            for (int c = 0; c < k; ++c) {
+                for (int i = 0; i <= c; ++i) S[p * k + i + static_cast<size_t>(c) * ls] = Ap[i + static_cast<size_t>(c) * rows];
+            }
+            localQ[p].resize(static_cast<size_t>(rows) * k);
+            householderQ(Ap.data(), rows, k, rows, tau.data(), localQ[p].data(), rows);
+        }
+
+        // Reduction: S = Qs R
+        std::vector<TNum> tau(k), Qs(static_cast<size_t>(ls) * k);
+        householderQR(S.data(), ls, k, ls, tau.data());
+        for (int c = 0; c < k; ++c) {
+            for (int i = 0; i < k; ++i) R[i + static_cast<size_t>(c) * ldr] = i <= c ? S[i + static_cast<size_t>(c) * ls] : TNum(0);
+        }
+        householderQ(S.data(), ls, k, ls, tau.data(), Qs.data(), ls);
+
+        // Q block p = Q_p Qs(p k : (p+1) k, :)
+        #pragma omp parallel for schedule(static)
+        for (int p = 0; p < blocks; ++p) {
+            const int rows = start[p + 1] - start[p];
+            blas::gemm(CblasColMajor, CblasNoTrans, CblasNoTrans, rows, k, k, 1.0, localQ[p].data(), rows,
+                        Qs.data() + p * k, ls, 0.0, W + start[p], ldw);
+        }
+    }
+
+    namespace detail {
+        // Column-by-column CGS2 with dropping, for wide blocks (n < k) that TSQR cannot factor
+        template<typename TNum>
+        int orthonormalizeColumns(TNum* W, int n, int k, int ldw, TNum* R, int ldr, TNum dropTol) {
+            std::vector<TNum> w(n), h(k);
+            int rank = 0;
+            for (int c = 0; c < k; ++c) {
+                std::copy(W + static_cast<size_t>(c) * ldw, W + static_cast<size_t>(c) * ldw + n, w.begin());
+                TNum* rc = R + static_cast<size_t>(c) * ldr;
+                std::fill(rc, rc + k, TNum(0));
+                const TNum norm0 = blas::nrm2(n, w.data(), 1);
+                const TNum norm = orthogonalize(Orthogonalization::CGS2, W, n, rank, ldw, w.data(), h.data());
+                std::copy(h.begin(), h.begin() + rank, rc);
+                if (norm0 == TNum(0) || norm <= dropTol * norm0) {
+                    continue;
+                }
+                rc[rank] = norm;
+                TNum* q = W + static_cast<size_t>(rank) * ldw;
+                for (int i = 0; i < n; ++i) q[i] = w[i] / norm;
+                ++rank;
+            }
+            return rank;
+        }
+    }
+
+    /**
+     * @brief Orthonormalize the k columns of a block in place
+     *
+     * The block is factored as a whole with TSQR, so the work is done by the
+     * blocked local Householder factorizations and gemm rather than by one
+     * projection per column. Column c is treated as linearly dependent on the
+     * columns before it when |R(c, c)| drops below dropTol times its original
+     * norm; in that case the accepted columns are factored once more and R is
+     * formed as Q^T W with a single gemm. The accepted columns are compacted to
+     * the front of W. On return W(:, 0:rank) = Q and the original block equals
+     * Q R(0:rank, :), with a positive diagonal on the accepted columns.
+     *
+     * @param W Column-major n x k block with leading dimension ldw
+     * @param R Output k x k factor with leading dimension ldr, rows past rank are zero
+     * @return rank Number of accepted columns
+     */
+    template<typename TNum>
+    int orthonormalizeBlock(TNum* W, int n, int k, int ldw, TNum* R, int ldr, TNum dropTol) {
+        if (k == 0) return 0;
+        if (n < k) {
+            return detail::orthonormalizeColumns(W, n, k, ldw, R, ldr, dropTol);
+        }
+        std::vector<TNum> W0(static_cast<size_t>(n) * k), Rt(static_cast<size_t>(k) * k);
+        std::vector<TNum> norm0(k);
+        for (int c = 0; c < k; ++c) {
+            std::copy(W + static_cast<size_t>(c) * ldw, W + static_cast<size_t>(c) * ldw + n, W0.begin() + static_cast<size_t>(c) * n);
+            norm0[c] = blas::nrm2(n, W0.data() + static_cast<size_t>(c) * n, 1);
+        }
+        tsqr(W, n, k, ldw, Rt.data(), k);
+
+        // |R(c, c)| is the distance of column c to the span of the columns before it
+        std::vector<int> accepted;
+        for (int c = 0; c < k; ++c) {
+            if (norm0[c] != TNum(0) && std::abs(Rt[c + static_cast<size_t>(c) * k]) > dropTol * norm0[c]) {
+                accepted.push_back(c);
+            }
+        }
+        const int rank = accepted.size();
+        for (int c = 0; c < k; ++c) std::fill(R + static_cast<size_t>(c) * ldr, R + static_cast<size_t>(c) * ldr + k, TNum(0));
+
+        if (rank == k) {
+            for (int c = 0; c < k; ++c) {
+                std::copy(Rt.begin() + static_cast<size_t>(c) * k, Rt.begin() + static_cast<size_t>(c) * k + c + 1,
+                          R + static_cast<size_t>(c) * ldr);
+            }
+        } else if (rank > 0) {
+            // Q from the accepted columns only, then R = Q^T W0 in one gemm
+            for (int p = 0; p < rank; ++p) {
+                std::copy(W0.begin() + static_cast<size_t>(accepted[p]) * n, W0.begin() + static_cast<size_t>(accepted[p] + 1) * n,
+                          W + static_cast<size_t>(p) * ldw);
+            }
+            tsqr(W, n, rank, ldw, Rt.data(), k);
+            blas::gemm(CblasColMajor, CblasTrans, CblasNoTrans, rank, k, n, 1.0, W, ldw, W0.data(), n, 0.0, R, ldr);
+            // Column c only couples to the accepted columns up to and including itself
+            int seen = 0;
+            for (int c = 0; c < k; ++c) {
+                if (seen < rank && accepted[seen] == c) ++seen;
+                TNum* rc = R + static_cast<size_t>(c) * ldr;
+                std::fill(rc + seen, rc + rank, TNum(0));
+            }
+        }
+
+        // Positive diagonal: flip the sign of Q(:, p) and row p of R where needed
+        for (int p = 0; p < rank; ++p) {
+            if (R[p + static_cast<size_t>(accepted[p]) * ldr] < TNum(0)) {
+                blas::scal(n, TNum(-1), W + static_cast<size_t>(p) * ldw, 1);
+                for (int c = 0; c < k; ++c) R[p + static_cast<size_t>(c) * ldr] = -R[p + static_cast<size_t>(c) * ldr];
+            }
+        }
+        return rank;
+    }
+
+    namespace detail {
+        // Householder reflector I - beta u u^T (u[0] = 1) mapping the len-vector v onto a multiple of e1
+        template<typename TNum>
+        bool reflector(const TNum* v, int len, TNum* u, TNum& beta) {
+            TNum sigma = TNum(0);
+            for (int i = 1; i < len; ++i) sigma += v[i] * v[i];
+            if (sigma == TNum(0)) return false;
+            const TNum norm = std::sqrt(v[0] * v[0] + sigma);
+            const TNum u0 = v[0] <= TNum(0) ? v[0] - norm : -sigma / (v[0] + norm);
+            u[0] = TNum(1);
+            for (int i = 1; i < len; ++i) u[i] = v[i] / u0;
+            beta = TNum(2) * u0 * u0 / (sigma + u0 * u0);
+            return true;
+        }
+
+        // Eigenvalues of the real 2 x 2 block [a b; c d], a conjugate pair as (+, -)
+        template<typename TNum>
+        void eigenvalues2x2(TNum a, TNum b, TNum c, TNum d, std::complex<TNum>& e1, std::complex<TNum>& e2) {
+            const TNum mid = TNum(0.5) * (a + d);
+            const TNum half = TNum(0.5) * (a - d);
+            const TNum disc = half * half + b * c;
+            if (disc < TNum(0)) {
+                const TNum im = std::sqrt(-disc);
+                e1 = std::complex<TNum>(mid, im);
+                e2 = std::complex<TNum>(mid, -im);
+                return;
+            }
+            // Larger root by addition, the other one from the determinant to avoid cancellation
+            const TNum root = std::sqrt(disc);
+            const TNum big = mid >= TNum(0) ? mid + root : mid - root;
+            const TNum det = a * d - b * c;
+            e1 = big;
+            e2 = big != TNum(0) ? det / big : mid - (mid >= TNum(0) ? root : -root);
+        }
+    }
+
+    /**
+     * @brief Eigenvalues of the k x k upper Hessenberg matrix H (Francis double-shift QR)
+     *
+     * Implicit double-shift QR sweeps (Golub & Van Loan, Algorithm 7.5.1) on the
+     * active unreduced block, with deflation whenever a subdiagonal entry becomes
+     * negligible relative to its diagonal neighbours. Only the block itself is
+     * transformed since the eigenvectors are not needed. Used for Ritz values of
+     * the Arnoldi matrix, e.g. as shifts of a Newton basis. Complex conjugate
+     * pairs are returned next to each other.
+     */
+    template<typename TNum>
+    std::vector<std::complex<TNum>> hessenbergEigenvalues(const TNum* H, int ldh, int k) {
+        std::vector<TNum> a(static_cast<size_t>(k) * k);
+        auto at = [&](int i, int j) -> TNum& { return a[i + static_cast<size_t>(j) * k]; };
+        for (int j = 0; j < k; ++j) {
+            for (int i = 0; i < k; ++i) at(i, j) = i <= j + 1 ? H[i + static_cast<size_t>(j) * ldh] : TNum(0);
+        }
+        std::vector<std::complex<TNum>> eig(k);
+        const TNum eps = std::numeric_limits<TNum>::epsilon();
+        TNum scale = TNum(0);
+        for (int j = 0; j < k; ++j) {
+            for (int i = 0; i <= std::min(j + 1, k - 1); ++i) scale = std::max(scale, std::abs(at(i, j)));
+        }
+
+        // Apply a reflector acting on rows/columns r..r+len-1 of the active block [lo, hi]
+        auto applyReflector = [&](int r, int len, int lo, int hi, const TNum* u, TNum beta) {
+            for (int j = std::max(lo, r - 1); j <= hi; ++j) {
+                TNum s = TNum(0);
+                for (int i = 0; i < len; ++i) s += u[i] * at(r + i, j);
+                s *= beta;
+                for (int i = 0; i < len; ++i) at(r + i, j) -= s * u[i];
+            }
+            for (int i = lo; i <= std::min(r + len, hi); ++i) {
+                TNum s = TNum(0);
+                for (int j = 0; j < len; ++j) s += at(i, r + j) * u[j];
+                s *= beta;
+                for (int j = 0; j < len; ++j) at(i, r + j) -= s * u[j];
+            }
+        };
+
+        const int maxSweeps = 40 * std::max(k, 1);
+        int hi = k - 1, sweeps = 0, stalled = 0;
+        while (hi >= 0) {
+            // Start of the unreduced block ending at hi
+            int lo = hi;
+            while (lo > 0) {
+                TNum ref = std::abs(at(lo - 1, lo - 1)) + std::abs(at(lo, lo));
+                if (ref == TNum(0)) ref = scale;
+                if (std::abs(at(lo, lo - 1)) <= eps * ref) {
+                    at(lo, lo - 1) = TNum(0);
+                    break;
+                }
+                --lo;
+            }
+            if (lo == hi) {
+                eig[hi] = at(hi, hi);
+                --hi;
+                stalled = 0;
+                continue;
+            }
+            if (lo == hi - 1) {
+                detail::eigenvalues2x2(at(hi - 1, hi - 1), at(hi - 1, hi), at(hi, hi - 1), at(hi, hi), eig[hi - 1], eig[hi]);
+                hi -= 2;
+                stalled = 0;
+                continue;
+            }
+            if (++sweeps > maxSweeps) {
+                throw std::runtime_error("Hessenberg QR iteration did not converge");
+            }
+
+            // Shifts: the eigenvalues of the trailing 2 x 2 block, given by their sum and product.
+            // If the bottom of the block has not deflated for a while, perturb them to break cycles.
+            TNum sum = at(hi - 1, hi - 1) + at(hi, hi);
+            TNum prod = at(hi - 1, hi - 1) * at(hi, hi) - at(hi - 1, hi) * at(hi, hi - 1);
+            if (++stalled % 12 == 0) {
+                const TNum mu = at(hi, hi) + std::abs(at(hi, hi - 1)) + std::abs(at(hi - 1, hi - 2));
+                sum = TNum(2) * mu;
+                prod = mu * mu;
+            }
+
+            // First column of (H - s1 I)(H - s2 I), nonzero in its first three entries only
+            TNum v[3] = {
+                at(lo, lo) * at(lo, lo) + at(lo, lo + 1) * at(lo + 1, lo) - sum * at(lo, lo) + prod,
+                at(lo + 1, lo) * (at(lo, lo) + at(lo + 1, lo + 1) - sum),
+                at(lo + 1, lo) * at(lo + 2, lo + 1)
+            };
+            TNum u[3], beta;
+            // Introduce the bulge at the top of the block and chase it down to hi
+            for (int r = lo; r <= hi - 2; ++r) {
+                if (detail::reflector(v, 3, u, beta)) {
+                    applyReflector(r, 3, lo, hi, u, beta);
+                    if (r > lo) {
+                        at(r + 1, r - 1) = TNum(0);
+                        at(r + 2, r - 1) = TNum(0);
+                    }
+                }
+                v[0] = at(r + 1, r);
+                v[1] = at(r + 2, r);
+                v[2] = r + 3 <= hi ? at(r + 3, r) : TNum(0);
+            }
+            if (detail::reflector(v, 2, u, beta)) {
+                applyReflector(hi - 1, 2, lo, hi, u, beta);
+                at(hi, hi - 2) = TNum(0);
+            }
+        }
+        return eig;
+    }
+
     template<typename TNum, typename MatrixType, typename VectorType>
     void Arnoldi(MatrixType& A, std::vector<VectorType>& Q, MatrixType& H, TNum tol) {
         int m = Q.size();
@@ -0,0 +1,129 @@
+#ifndef MINRES_HPP
+#define MINRES_HPP
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <utility>
+#include <stdexcept>
+#include "../../Obj/SparseObj.hpp"
+#include "../../Obj/VectorObj.hpp"
+#include "../Preconditioner/Preconditioner.hpp"
+
+/**
+ * @brief MINRES for symmetric, possibly indefinite systems (Paige & Saunders)
+ *
+ * Minimizes ||b - A x|| over the Krylov space with a three-term Lanczos
+ * recurrence, so memory is a fixed handful of vectors, unlike GMRES. Works for
+ * saddle-point and shifted operators where CG breaks down. The preconditioner
+ * must be symmetric positive definite; the residual is then measured in the
+ * M^(-1)-norm.
+ */
+template <typename TNum, typename MatrixType = SparseMatrixCSC<TNum>, typename VectorType = VectorObj<TNum>>
+class MINRES {
+private:
+    Preconditioner<TNum, VectorType>* preconditioner = nullptr;
+    int iterations = 0;
+    TNum residualNorm = TNum(0);
+
+    VectorType precondition(const VectorType& v) {
+        return preconditioner ? preconditioner->apply(v) : v;
+    }
+
+public:
+    MINRES() = default;
+    virtual ~MINRES() = default;
+
+    // The preconditioner is not owned and must outlive the calls to solve
+    void setPreconditioner(Preconditioner<TNum, VectorType>& M) {
+        preconditioner = &M;
+    }
+
+    int getIterations() const { return iterations; }
+    // Residual estimate ||b - A x||_{M^(-1)} maintained by the recurrence
+    TNum getResidualNorm() const { return residualNorm; }
+
+    /**
+     * @brief Solve the symmetric system A x = b starting from the initial guess in x
+     * @param tol Tolerance on the relative residual ||r||_{M^(-1)} / ||r0||_{M^(-1)}
+     * @return true if the tolerance was reached
+     */
+    bool solve(const MatrixType& A, const VectorType& b, VectorType& x, int maxIter, double tol) {
+        const int n = b.size();
+        if (A.getRows() != n || A.getCols() != n) {
+            throw std::invalid_argument("Matrix dimensions must match vector size");
+        }
+        if (static_cast<int>(x.size()) != n) {
+            throw std::invalid_argument("Initial guess vector must match system size");
+        }
+
+        iterations = 0;
+        VectorType r1 = b - A * x;
+        VectorType y = precondition(r1);
+        TNum beta1 = r1 * y;
+        if (beta1 < TNum(0)) {
+            throw std::runtime_error("MINRES: preconditioner is not positive definite");
+        }
+        beta1 = std::sqrt(beta1);
+        residualNorm = beta1;
+        if (beta1 == TNum(0)) {
+            return true;
+        }
+
+        VectorType r2 = r1;
+        VectorType w(n, TNum(0)), w1(n, TNum(0)), w2(n, TNum(0));
+        TNum oldb = TNum(0), beta = beta1, dbar = TNum(0), epsln = TNum(0);
+        TNum phibar = beta1, cs = TNum(-1), sn = TNum(0);
+
+        while (iterations < maxIter) {
+            // Lanczos step: v = y / beta, y = A v - alfa r2 / beta - beta r1 / oldb
+            VectorType v = y * (TNum(1) / beta);
+            y = A * v;
+            if (iterations > 0) {
+                y.axpy(-beta / oldb, r1);
+            }
+            const TNum alfa = v * y;
+            y.axpy(-alfa / beta, r2);
+            r1 = std::move(r2);
+            r2 = y;
+            y = precondition(r2);
+            oldb = beta;
+            beta = r2 * y;
+            if (beta < TNum(0)) {
+                throw std::runtime_error("MINRES: preconditioner is not positive definite");
+            }
+            beta = std::sqrt(beta);
+            ++iterations;
+
+            // Apply the previous rotation, then eliminate beta with a new one
+            const TNum oldeps = epsln;
+            const TNum delta = cs * dbar + sn * alfa;
+            const TNum gbar = sn * dbar - cs * alfa;
+            epsln = sn * beta;
+            dbar = -cs * beta;
+            const TNum gamma = std::max(std::hypot(gbar, beta), std::numeric_limits<TNum>::epsilon());
+            cs = gbar / gamma;
+            sn = beta / gamma;
+            const TNum phi = cs * phibar;
+            phibar = sn * phibar;
+
+            // w = (v - oldeps w1 - delta w2) / gamma, x += phi w
+            w1 = std::move(w2);
+            w2 = std::move(w);
+            w = v;
+            w.axpy(-oldeps, w1);
+            w.axpy(-delta, w2);
+            w *= TNum(1) / gamma;
+            x.axpy(phi, w);
+
+            residualNorm = std::abs(phibar);
+            // beta = 0 means an invariant subspace was found and phibar = 0
+            if (residualNorm <= tol * beta1) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+#endif // MINRES_HPP
@@ -0,0 +1,113 @@
+#ifndef MATRIXPOWERS_HPP
+#define MATRIXPOWERS_HPP
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include "../../Obj/SparseObj.hpp"
+
+/**
+ * @brief Matrix-powers kernel: s polynomial basis vectors from one sweep over A
+ *
+ * Computes V(:, j+1) = alpha_j (A - theta_j I) V(:, j) - beta_j V(:, j-1) for
+ * j = 0..s-1, which covers the monomial, Newton and Chebyshev bases. The rows
+ * are split into blocks at least as tall as the bandwidth of A, so level j of a
+ * block only needs level j-1 of the same and the two neighbouring blocks. The
+ * blocks are swept as a wavefront (level j of block b at step b + 2j), which
+ * keeps the window of about 2s blocks that is live at any step in cache: A is
+ * read from memory about once per s levels instead of s times. Matrices whose
+ * bandwidth is too large for blocking fall back to one CSR sweep per level.
+ */
+template <typename TNum>
+class MatrixPowers {
+private:
+    int n;
+    std::vector<int> rowPtr, colIdx;  // CSR copy of A
+    std::vector<TNum> vals;
+    int bandwidth = 0;
+    size_t cacheBytes;
+
+    // Level j (column j+1 of V) on rows [begin, end)
+    void level(TNum* V, int ldv, int j, int begin, int end, TNum alpha, TNum theta, TNum beta) const {
+        const TNum* vIn = V + static_cast<size_t>(j) * ldv;
+        const TNum* vPrev = j > 0 ? V + static_cast<size_t>(j - 1) * ldv : nullptr;
+        TNum* vOut = V + static_cast<size_t>(j + 1) * ldv;
+        for (int r = begin; r < end; ++r) {
+            TNum sum = TNum(0);
+            for (int idx = rowPtr[r]; idx < rowPtr[r + 1]; ++idx) {
+                sum += vals[idx] * vIn[colIdx[idx]];
+            }
+            TNum out = alpha * (sum - theta * vIn[r]);
+            if (vPrev) out -= beta * vPrev[r];
+            vOut[r] = out;
+        }
+    }
+
+public:
+    /**
+     * @param A Square matrix, copied to CSR once
+     * @param cacheBytes Cache budget for the wavefront window, e.g. the L2 size
+     */
+    explicit MatrixPowers(const SparseMatrixCSC<TNum>& A, size_t cacheBytes = size_t(1) << 20)
+        : n(A.getRows()), cacheBytes(cacheBytes) {
+        if (A.getRows() != A.getCols()) {
+            throw std::invalid_argument("Matrix powers require a square matrix");
+        }
+        // The CSC arrays of A^T are the CSR arrays of A
+        const SparseMatrixCSC<TNum> At = A.Transpose();
+        rowPtr = At.col_ptr;
+        colIdx = At.row_indices;
+        vals = At.values;
+        for (int r = 0; r < n; ++r) {
+            for (int idx = rowPtr[r]; idx < rowPtr[r + 1]; ++idx) {
+                bandwidth = std::max(bandwidth, std::abs(colIdx[idx] - r));
+            }
+        }
+    }
+
+    int getSize() const { return n; }
+    int getBandwidth() const { return bandwidth; }
+
+    // Rows per block for s levels; 0 when the wavefront does not apply
+    int blockRows(int s) const {
+        if (n == 0 || s <= 1) return 0;
+        const size_t bytesPerRow = (vals.size() / n + 1) * (sizeof(TNum) + sizeof(int)) + (s + 1) * sizeof(TNum);
+        const int budgetRows = static_cast<int>(cacheBytes / ((2 * s + 2) * bytesPerRow));
+        const int rows = std::max({bandwidth, budgetRows, 1});
+        return n / rows >= 3 ? rows : 0;
+    }
+
+    /**
+     * @brief Compute V(:, 1..s) from V(:, 0)
+     * @param V Column-major n x (s+1) block with leading dimension ldv
+     * @param alpha,theta,beta Recurrence coefficients of each level (length s); beta[0] is unused
+     */
+    void compute(TNum* V, int ldv, int s, const TNum* alpha, const TNum* theta, const TNum* beta) const {
+        const int rows = blockRows(s);
+        if (rows == 0) {
+            const int chunks = std::max(1, n / 1024);
+            for (int j = 0; j < s; ++j) {
+                #pragma omp parallel for schedule(static)
+                for (int c = 0; c < chunks; ++c) {
+                    level(V, ldv, j, static_cast<int>(static_cast<long long>(n) * c / chunks),
+                          static_cast<int>(static_cast<long long>(n) * (c + 1) / chunks), alpha[j], theta[j], beta[j]);
+                }
+            }
+            return;
+        }
+
+        // Wavefront: at step t, level j runs on block t - 2j; those tasks are independent
+        const int blocks = (n + rows - 1) / rows;
+        for (int t = 0; t < blocks + 2 * (s - 1); ++t) {
+            #pragma omp parallel for schedule(static) if (s >= 4)
+            for (int j = 0; j < s; ++j) {
+                const int b = t - 2 * j;
+                if (b < 0 || b >= blocks) continue;
+                level(V, ldv, j, b * rows, std::min(n, (b + 1) * rows), alpha[j], theta[j], beta[j]);
+            }
+        }
+    }
+};
+
+#endif // MATRIXPOWERS_HPP
@@ -0,0 +1,159 @@
+#ifndef SYMMLQ_HPP
+#define SYMMLQ_HPP
+
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <stdexcept>
+#include "../../Obj/SparseObj.hpp"
+#include "../../Obj/VectorObj.hpp"
+#include "../Preconditioner/Preconditioner.hpp"
+
+/**
+ * @brief SYMMLQ for symmetric, possibly indefinite systems (Paige & Saunders)
+ *
+ * Uses the same Lanczos recurrence as MINRES but an LQ factorization of the
+ * tridiagonal matrix, which keeps the error ||x - x*|| monotonically
+ * decreasing instead of the residual. On exit the iterate is moved to the CG
+ * point when that exists. The preconditioner must be symmetric positive definite.
+ */
+template <typename TNum, typename MatrixType = SparseMatrixCSC<TNum>, typename VectorType = VectorObj<TNum>>
+class SYMMLQ {
+private:
+    Preconditioner<TNum, VectorType>* preconditioner = nullptr;
+    int iterations = 0;
+    TNum residualNorm = TNum(0);
+
+    VectorType precondition(const VectorType& v) {
+        return preconditioner ? preconditioner->apply(v) : v;
+    }
+
+public:
+    SYMMLQ() = default;
+    virtual ~SYMMLQ() = default;
+
+    // The preconditioner is not owned and must outlive the calls to solve
+    void setPreconditioner(Preconditioner<TNum, VectorType>& M) {
+        preconditioner = &M;
+    }
+
+    int getIterations() const { return iterations; }
+    // Estimate of ||b - A x||_{M^(-1)} at the CG point
+    TNum getResidualNorm() const { return residualNorm; }
+
+    /**
+     * @brief Solve the symmetric system A x = b starting from the initial guess in x
+     * @param tol Tolerance on the relative CG-point residual ||r||_{M^(-1)} / ||r0||_{M^(-1)}
+     * @return true if the tolerance was reached
+     */
+    bool solve(const MatrixType& A, const VectorType& b, VectorType& x, int maxIter, double tol) {
+        const int n = b.size();
+        if (A.getRows() != n || A.getCols() != n) {
+            throw std::invalid_argument("Matrix dimensions must match vector size");
+        }
+        if (static_cast<int>(x.size()) != n) {
+            throw std::invalid_argument("Initial guess vector must match system size");
+        }
+
+        iterations = 0;
+        // Solve for the correction A d = r0
+        const VectorType r0 = b - A * x;
+        VectorType y = precondition(r0);
+        TNum beta1 = r0 * y;
+        if (beta1 < TNum(0)) {
+            throw std::runtime_error("SYMMLQ: preconditioner is not positive definite");
+        }
+        beta1 = std::sqrt(beta1);
+        residualNorm = beta1;
+        if (beta1 == TNum(0)) {
+            return true;
+        }
+
+        // First Lanczos vector v1 = M^(-1) r0 / beta1; its contribution to the
+        // solution is accumulated in bstep and added at the end
+        const VectorType v1 = y * (TNum(1) / beta1);
+        y = A * v1;
+        const TNum alfa1 = v1 * y;
+        y.axpy(-alfa1 / beta1, r0);
+        VectorType r1 = r0;
+        VectorType r2 = y;
+        y = precondition(r2);
+        TNum oldb = beta1;
+        TNum beta = r2 * y;
+        if (beta < TNum(0)) {
+            throw std::runtime_error("SYMMLQ: preconditioner is not positive definite");
+        }
+        beta = std::sqrt(beta);
+
+        TNum gbar = alfa1, dbar = beta;
+        TNum rhs1 = beta1, rhs2 = TNum(0);
+        TNum bstep = TNum(0), snprod = TNum(1);
+        VectorType w(n, TNum(0)), d(n, TNum(0));
+        iterations = 1;
+
+        bool converged = false;
+        while (beta > TNum(0)) {
+            // CG point residual: beta_(k+1) |zbar_k| with zbar_k = rhs1 / gbar
+            const TNum diag = gbar == TNum(0) ? std::numeric_limits<TNum>::epsilon() : gbar;
+            residualNorm = std::abs(snprod * beta1 * beta / diag);
+            if (residualNorm <= tol * beta1 || iterations >= maxIter) {
+                converged = residualNorm <= tol * beta1;
+                break;
+            }
+
+            // Lanczos step
+            VectorType v = y * (TNum(1) / beta);
+            y = A * v;
+            y.axpy(-beta / oldb, r1);
+            const TNum alfa = v * y;
+            y.axpy(-alfa / beta, r2);
+            r1 = std::move(r2);
+            r2 = y;
+            y = precondition(r2);
+            oldb = beta;
+            beta = r2 * y;
+            if (beta < TNum(0)) {
+                throw std::runtime_error("SYMMLQ: preconditioner is not positive definite");
+            }
+            beta = std::sqrt(beta);
+            ++iterations;
+
+            // Next plane rotation of the LQ factorization
+            const TNum gamma = std::max(std::hypot(gbar, oldb), std::numeric_limits<TNum>::epsilon());
+            const TNum cs = gbar / gamma;
+            const TNum sn = oldb / gamma;
+            const TNum delta = cs * dbar + sn * alfa;
+            gbar = sn * dbar - cs * alfa;
+            const TNum epsln = sn * beta;
+            dbar = -cs * beta;
+
+            // Update the LQ point: d += z (cs w + sn v), w = sn w - cs v
+            const TNum z = rhs1 / gamma;
+            d.axpy(z * cs, w);
+            d.axpy(z * sn, v);
+            w *= sn;
+            w.axpy(-cs, v);
+
+            bstep += snprod * cs * z;
+            snprod *= sn;
+            rhs1 = rhs2 - delta * z;
+            rhs2 = -epsln * z;
+        }
+
+        // Move to the CG point and add the step along v1
+        const TNum diag = gbar == TNum(0) ? std::numeric_limits<TNum>::epsilon() : gbar;
+        const TNum zbar = rhs1 / diag;
+        bstep += snprod * zbar;
+        d.axpy(zbar, w);
+        d.axpy(bstep, v1);
+        if (beta == TNum(0)) {
+            // Invariant subspace: the CG point is exact
+            residualNorm = TNum(0);
+            converged = true;
+        }
+        x.axpy(TNum(1), d);
+        return converged;
+    }
+};
+
+#endif // SYMMLQ_HPP
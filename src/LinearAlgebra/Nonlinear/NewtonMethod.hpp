@@ -1,11 +1,11 @@
 #ifndef NEWTONMETHOD_HPP
 #define NEWTONMETHOD_HPP
 
-#include <iostream>
 #include <cmath>
 #include <functional>
 #include "VectorObj.hpp"
 #include "GMRES.hpp"
+#include "SolverMonitor.hpp"
 
 template<typename T, typename MatrixType, typename VectorType = VectorObj<T>>
 class NewtonMethod {
@@ -14,6 +14,7 @@ private:
     size_t max_iter; // Maximum number of iterations
     T alpha; // Step size for line search (optional)
     GMRES<T, MatrixType, VectorType> linear_solver; // Linear solver for the Newton step
+    SolverMonitor* monitor = nullptr; // Records ||F(x)|| per Newton step when set
 
 public:
     // Constructor with default values
@@ -23,16 +24,23 @@ public:
     // Destructor
     ~NewtonMethod() = default;
 
-    // Solve the nonlinear system F(x) = 0 using Newton's method
-    void solve(VectorType &x, 
+    // Record ||F(x)|| of each Newton step into `m` (not owned)
+    void setMonitor(SolverMonitor& m) { monitor = &m; }
+
+    // Record the inner GMRES residuals into `m` (not owned); each Newton step restarts its history
+    void setLinearSolverMonitor(SolverMonitor& m) { linear_solver.setMonitor(m); }
+
+    // Solve the nonlinear system F(x) = 0 using Newton's method; returns true if ||F(x)|| < tol
+    bool solve(VectorType &x, 
                const std::function<VectorType(const VectorType &)> &F, // Nonlinear function F(x)
                const std::function<MatrixType(const VectorType &)> &J) // Jacobian J(x)
     {
         size_t iter = 0;
         VectorType residual;
         VectorType delta_x;
-        T residual_norm;
+        T residual_norm = T(0);
         // linear_solver.enablePreconditioner();
+        if (monitor) monitor->start();
 
         while (iter < max_iter) {
             // Evaluate the nonlinear function F(x)
@@ -40,9 +48,10 @@ public:
 
             // Check for convergence: stop if ||F(x)|| < tol
             residual_norm = residual.L2norm();
+            if (monitor) monitor->record(SolverMonitor::Event::Iteration, static_cast<int>(iter), residual_norm);
             if (residual_norm < tol) {
-                std::cout << "Converged after " << iter << " iterations." << std::endl;
-                return;
+                if (monitor) monitor->record(SolverMonitor::Event::Converged, static_cast<int>(iter), residual_norm);
+                return true;
             }
 
             // Evaluate the Jacobian matrix J(x)
@@ -62,7 +71,8 @@ public:
         }
 
         // If the loop ends without convergence
-        std::cerr << "NewtonMethod did not converge within " << max_iter << " iterations." << std::endl;
+        if (monitor) monitor->record(SolverMonitor::Event::MaxIterations, static_cast<int>(iter), residual_norm);
+        return false;
     }
 };
 
@@ -0,0 +1,282 @@
+#ifndef APPROXIMATE_INVERSE_HPP
+#define APPROXIMATE_INVERSE_HPP
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include "../../Obj/SparseObj.hpp"
+#include "../../Obj/VectorObj.hpp"
+#include "../Krylov/KrylovSubspace.hpp"
+#include "CSR.hpp"
+#include "Preconditioner.hpp"
+
+namespace sai {
+    /**
+     * @brief Row patterns of S^level, S being the pattern of A plus the diagonal
+     * @param lowerOnly Keep only the columns j <= i of row i
+     */
+    template <typename TNum>
+    void powerPattern(const csr::Matrix<TNum>& A, int level, bool lowerOnly, std::vector<int>& ptr, std::vector<int>& idx) {
+        const int n = A.rows;
+        ptr.assign(n + 1, 0);
+        idx.clear();
+        std::vector<int> marker(n, -1), row, frontier, nextFrontier;
+        for (int i = 0; i < n; ++i) {
+            row.assign(1, i);
+            frontier.assign(1, i);
+            marker[i] = i;
+            for (int l = 0; l < level; ++l) {
+                nextFrontier.clear();
+                for (int k : frontier) {
+                    for (int p = A.rowPtr[k]; p < A.rowPtr[k + 1]; ++p) {
+                        const int j = A.colIdx[p];
+                        if (marker[j] == i) continue;
+                        marker[j] = i;
+                        row.push_back(j);
+                        nextFrontier.push_back(j);
+                    }
+                }
+                frontier.swap(nextFrontier);
+            }
+            std::sort(row.begin(), row.end());
+            for (int j : row) {
+                if (!lowerOnly || j <= i) idx.push_back(j);
+            }
+            ptr[i + 1] = static_cast<int>(idx.size());
+        }
+    }
+}
+
+/**
+ * @brief Factorized sparse approximate inverse G^T G ~= A^(-1) for SPD A (FSAI)
+ *
+ * G is lower triangular with the pattern of the lower triangle of A^level. Row i
+ * only needs the small SPD system A(P_i, P_i) y = e_i on its own pattern P_i,
+ * so the rows are computed independently in parallel; g_i = y / sqrt(y_i)
+ * makes diag(G A G^T) = 1. apply is two SpMVs, z = G^T (G r), with G^T stored
+ * explicitly so that both run row-parallel.
+ */
+template <typename TNum, typename MatrixType = SparseMatrixCSC<TNum>>
+class FSAIPreconditioner : public Preconditioner<TNum, VectorObj<TNum>> {
+private:
+    int level;
+    csr::Matrix<TNum> G, Gt;
+    bool isComputed = false;
+
+public:
+    explicit FSAIPreconditioner(int level = 1) : level(level) {
+        if (level < 1) {
+            throw std::invalid_argument("FSAI pattern level must be at least 1");
+        }
+    }
+
+    void compute(const MatrixType& Matrix) {
+        if (Matrix.getRows() != Matrix.getCols()) {
+            throw std::invalid_argument("Matrix must be square for FSAI");
+        }
+        isComputed = false;
+        const csr::Matrix<TNum> A = csr::fromMatrix<TNum>(Matrix);
+        const int n = A.rows;
+        G.rows = G.cols = n;
+        sai::powerPattern(A, level, true, G.rowPtr, G.colIdx);
+        G.vals.assign(G.colIdx.size(), TNum(0));
+
+        bool failed = false;
+        #pragma omp parallel
+        {
+            std::vector<int> pos(n, -1);
+            std::vector<TNum> M, y;
+            #pragma omp for schedule(dynamic, 32)
+            for (int i = 0; i < n; ++i) {
+                const int begin = G.rowPtr[i], m = G.rowPtr[i + 1] - begin;
+                const int* P = G.colIdx.data() + begin;
+                for (int c = 0; c < m; ++c) pos[P[c]] = c;
+                // Dense A(P, P), then its Cholesky factor in place (lower triangle)
+                M.assign(static_cast<size_t>(m) * m, TNum(0));
+                for (int a = 0; a < m; ++a) {
+                    for (int p = A.rowPtr[P[a]]; p < A.rowPtr[P[a] + 1]; ++p) {
+                        const int c = pos[A.colIdx[p]];
+                        if (c >= 0) M[a + static_cast<size_t>(c) * m] += A.vals[p];
+                    }
+                }
+                for (int c = 0; c < m; ++c) pos[P[c]] = -1;
+
+                bool spd = true;
+                for (int j = 0; j < m && spd; ++j) {
+                    TNum d = M[j + static_cast<size_t>(j) * m];
+                    for (int k = 0; k < j; ++k) d -= M[j + static_cast<size_t>(k) * m] * M[j + static_cast<size_t>(k) * m];
+                    if (!(d > TNum(0))) {
+                        spd = false;
+                        break;
+                    }
+                    d = std::sqrt(d);
+                    M[j + static_cast<size_t>(j) * m] = d;
+                    for (int r = j + 1; r < m; ++r) {
+                        TNum s = M[r + static_cast<size_t>(j) * m];
+                        for (int k = 0; k < j; ++k) s -= M[r + static_cast<size_t>(k) * m] * M[j + static_cast<size_t>(k) * m];
+                        M[r + static_cast<size_t>(j) * m] = s / d;
+                    }
+                }
+                if (!spd) {
+                    #pragma omp atomic write
+                    failed = true;
+                    continue;
+                }
+                // i is the last index of P: solve L L^T y = e_last
+                y.assign(m, TNum(0));
+                y[m - 1] = TNum(1) / M[(m - 1) + static_cast<size_t>(m - 1) * m];
+                for (int r = m - 1; r >= 0; --r) {
+                    TNum s = y[r];
+                    for (int k = r + 1; k < m; ++k) s -= M[k + static_cast<size_t>(r) * m] * y[k];
+                    y[r] = s / M[r + static_cast<size_t>(r) * m];
+                }
+                const TNum scale = TNum(1) / std::sqrt(y[m - 1]);
+                for (int c = 0; c < m; ++c) G.vals[begin + c] = y[c] * scale;
+            }
+        }
+        if (failed) {
+            throw std::runtime_error("FSAI requires a symmetric positive definite matrix");
+        }
+        Gt = csr::transpose(G);
+        isComputed = true;
+    }
+
+    VectorObj<TNum> apply(const VectorObj<TNum>& r) override {
+        if (!isComputed) {
+            throw std::runtime_error("FSAI not computed");
+        }
+        if (static_cast<int>(r.size()) != G.rows) {
+            throw std::invalid_argument("Vector size does not match matrix size");
+        }
+        VectorObj<TNum> t(G.rows), z(G.rows);
+        csr::spmv(G, r.element(), t.element());
+        csr::spmv(Gt, t.element(), z.element());
+        return z;
+    }
+
+    // Stored entries of G
+    size_t getNonZeros() const { return G.vals.size(); }
+};
+
+/**
+ * @brief Sparse approximate inverse M ~= A^(-1) minimizing ||A M - I||_F (SPAI, static pattern)
+ *
+ * Column j of M has the pattern J of column j of A^level, and only the rows I
+ * touched by A(:, J) enter the residual, so each column is an independent
+ * |I| x |J| least-squares problem solved by Householder QR. Columns run in
+ * parallel; apply is one row-parallel SpMV with M. M is meant as a right
+ * preconditioner (A M ~= I), e.g. for FGMRES.
+ */
+template <typename TNum, typename MatrixType = SparseMatrixCSC<TNum>>
+class SPAIPreconditioner : public Preconditioner<TNum, VectorObj<TNum>> {
+private:
+    int level;
+    csr::Matrix<TNum> M;
+    TNum residual = TNum(0);
+    bool isComputed = false;
+
+public:
+    explicit SPAIPreconditioner(int level = 1) : level(level) {
+        if (level < 1) {
+            throw std::invalid_argument("SPAI pattern level must be at least 1");
+        }
+    }
+
+    void compute(const MatrixType& Matrix) {
+        if (Matrix.getRows() != Matrix.getCols()) {
+            throw std::invalid_argument("Matrix must be square for SPAI");
+        }
+        isComputed = false;
+        const csr::Matrix<TNum> A = csr::fromMatrix<TNum>(Matrix);
+        const csr::Matrix<TNum> At = csr::transpose(A);  // Row k of At is column k of A
+        const int n = A.rows;
+
+        // Columns of M are the rows of Mt; their patterns are the rows of (A^T)^level
+        csr::Matrix<TNum> Mt;
+        Mt.rows = Mt.cols = n;
+        sai::powerPattern(At, level, false, Mt.rowPtr, Mt.colIdx);
+        Mt.vals.assign(Mt.colIdx.size(), TNum(0));
+
+        TNum total = TNum(0);
+        #pragma omp parallel reduction(+ : total)
+        {
+            std::vector<int> pos(n, -1), I;
+            std::vector<TNum> D, tau, rhs;
+            #pragma omp for schedule(dynamic, 32)
+            for (int j = 0; j < n; ++j) {
+                const int begin = Mt.rowPtr[j], k = Mt.rowPtr[j + 1] - begin;
+                const int* J = Mt.colIdx.data() + begin;
+                I.clear();
+                for (int c = 0; c < k; ++c) {
+                    for (int p = At.rowPtr[J[c]]; p < At.rowPtr[J[c] + 1]; ++p) {
+                        const int r = At.colIdx[p];
+                        if (pos[r] < 0) {
+                            pos[r] = static_cast<int>(I.size());
+                            I.push_back(r);
+                        }
+                    }
+                }
+                // Dense A(I, J), padded with zero rows so that it is at least square
+                const int m = std::max(static_cast<int>(I.size()), k);
+                D.assign(static_cast<size_t>(m) * k, TNum(0));
+                for (int c = 0; c < k; ++c) {
+                    for (int p = At.rowPtr[J[c]]; p < At.rowPtr[J[c] + 1]; ++p) {
+                        D[pos[At.colIdx[p]] + static_cast<size_t>(c) * m] += At.vals[p];
+                    }
+                }
+                rhs.assign(m, TNum(0));
+                if (pos[j] >= 0) {
+                    rhs[pos[j]] = TNum(1);
+                } else {
+                    total += TNum(1);  // Row j is structurally zero in A(:, J): column j of M is 0, ||e_j|| = 1
+                }
+                for (int r : I) pos[r] = -1;
+
+                // min ||D x - e_j||: QR, then Q^T e_j and back substitution with R
+                tau.assign(k, TNum(0));
+                Krylov::householderQR(D.data(), m, k, m, tau.data());
+                for (int c = 0; c < k; ++c) {
+                    const TNum* v = D.data() + static_cast<size_t>(c) * m;
+                    TNum s = rhs[c];
+                    for (int r = c + 1; r < m; ++r) s += v[r] * rhs[r];
+                    s *= tau[c];
+                    rhs[c] -= s;
+                    for (int r = c + 1; r < m; ++r) rhs[r] -= s * v[r];
+                }
+                TNum res = TNum(0);
+                for (int r = k; r < m; ++r) res += rhs[r] * rhs[r];
+                total += res;
+                for (int c = k - 1; c >= 0; --c) {
+                    TNum s = rhs[c];
+                    for (int q = c + 1; q < k; ++q) s -= D[c + static_cast<size_t>(q) * m] * rhs[q];
+                    const TNum rcc = D[c + static_cast<size_t>(c) * m];
+                    rhs[c] = rcc != TNum(0) ? s / rcc : TNum(0);
+                }
+                for (int c = 0; c < k; ++c) Mt.vals[begin + c] = rhs[c];
+            }
+        }
+        residual = std::sqrt(total);
+        M = csr::transpose(Mt);
+        isComputed = true;
+    }
+
+    VectorObj<TNum> apply(const VectorObj<TNum>& r) override {
+        if (!isComputed) {
+            throw std::runtime_error("SPAI not computed");
+        }
+        if (static_cast<int>(r.size()) != M.rows) {
+            throw std::invalid_argument("Vector size does not match matrix size");
+        }
+        VectorObj<TNum> z(M.rows);
+        csr::spmv(M, r.element(), z.element());
+        return z;
+    }
+
+    // ||A M - I||_F of the computed inverse
+    TNum getResidual() const { return residual; }
+    // Stored entries of M
+    size_t getNonZeros() const { return M.vals.size(); }
+};
+
+#endif // APPROXIMATE_INVERSE_HPP
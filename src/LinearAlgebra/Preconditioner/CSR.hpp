@@ -0,0 +1,159 @@
+#ifndef CSR_HPP
+#define CSR_HPP
+
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include "../../Obj/SparseObj.hpp"
+
+/**
+ * @namespace csr
+ * @brief Row-compressed matrices for the preconditioner setups that work row by row
+ */
+namespace csr {
+    // Rectangular CSR matrix; column indices are sorted within each row
+    template <typename TNum>
+    struct Matrix {
+        int rows = 0, cols = 0;
+        std::vector<int> rowPtr, colIdx;
+        std::vector<TNum> vals;
+    };
+
+    // Row-compressed copy of a matrix; duplicate entries are summed as in SpMV
+    template <typename TNum, typename MatrixType>
+    Matrix<TNum> fromMatrix(const MatrixType& A) {
+        Matrix<TNum> csr;
+        const int n = A.getRows(), m = A.getCols();
+        csr.rows = n;
+        csr.cols = m;
+        csr.rowPtr.assign(n + 1, 0);
+        if constexpr (std::is_same<MatrixType, SparseMatrixCSC<TNum>>::value) {
+            // Counting-sort transpose of the CSC arrays: O(nnz), columns come out sorted
+            const int nnz = A.col_ptr.empty() ? 0 : A.col_ptr[m];
+            for (int idx = 0; idx < nnz; ++idx) ++csr.rowPtr[A.row_indices[idx] + 1];
+            for (int i = 0; i < n; ++i) csr.rowPtr[i + 1] += csr.rowPtr[i];
+            csr.colIdx.resize(nnz);
+            csr.vals.resize(nnz);
+            std::vector<int> next(csr.rowPtr.begin(), csr.rowPtr.end() - 1);
+            for (int j = 0; j < m; ++j) {
+                for (int idx = A.col_ptr[j]; idx < A.col_ptr[j + 1]; ++idx) {
+                    const int pos = next[A.row_indices[idx]]++;
+                    csr.colIdx[pos] = j;
+                    csr.vals[pos] = A.values[idx];
+                }
+            }
+            // Merge duplicates left by repeated addValue calls
+            int out = 0, start = 0;
+            for (int i = 0; i < n; ++i) {
+                const int rowStart = out, end = csr.rowPtr[i + 1];
+                for (int idx = start; idx < end; ++idx) {
+                    if (out > rowStart && csr.colIdx[out - 1] == csr.colIdx[idx]) {
+                        csr.vals[out - 1] += csr.vals[idx];
+                    } else {
+                        csr.colIdx[out] = csr.colIdx[idx];
+                        csr.vals[out++] = csr.vals[idx];
+                    }
+                }
+                start = end;
+                csr.rowPtr[i + 1] = out;
+            }
+            csr.colIdx.resize(out);
+            csr.vals.resize(out);
+        } else {
+            // Dense containers store every entry, so the pattern is full and the
+            // factorization reduces to LU without pivoting
+            csr.colIdx.resize(static_cast<size_t>(n) * m);
+            csr.vals.resize(static_cast<size_t>(n) * m);
+            for (int i = 0; i < n; ++i) {
+                for (int j = 0; j < m; ++j) {
+                    csr.colIdx[static_cast<size_t>(i) * m + j] = j;
+                    csr.vals[static_cast<size_t>(i) * m + j] = A(i, j);
+                }
+                csr.rowPtr[i + 1] = (i + 1) * m;
+            }
+        }
+        return csr;
+    }
+
+    template <typename TNum>
+    SparseMatrixCSC<TNum> toCSC(const Matrix<TNum>& M) {
+        SparseMatrixCSC<TNum> A(M.rows, M.cols);
+        for (int i = 0; i < M.rows; ++i) {
+            for (int p = M.rowPtr[i]; p < M.rowPtr[i + 1]; ++p) A.addValue(i, M.colIdx[p], M.vals[p]);
+        }
+        A.finalize();
+        return A;
+    }
+
+    template <typename TNum>
+    Matrix<TNum> transpose(const Matrix<TNum>& M) {
+        Matrix<TNum> T;
+        T.rows = M.cols;
+        T.cols = M.rows;
+        T.rowPtr.assign(T.rows + 1, 0);
+        for (int c : M.colIdx) ++T.rowPtr[c + 1];
+        for (int i = 0; i < T.rows; ++i) T.rowPtr[i + 1] += T.rowPtr[i];
+        T.colIdx.resize(M.colIdx.size());
+        T.vals.resize(M.vals.size());
+        std::vector<int> next(T.rowPtr.begin(), T.rowPtr.end() - 1);
+        for (int i = 0; i < M.rows; ++i) {
+            for (int p = M.rowPtr[i]; p < M.rowPtr[i + 1]; ++p) {
+                const int q = next[M.colIdx[p]]++;
+                T.colIdx[q] = i;
+                T.vals[q] = M.vals[p];
+            }
+        }
+        return T;
+    }
+
+    // X Y by rows (Gustavson), with a dense accumulator and a marker per column of Y
+    template <typename TNum>
+    Matrix<TNum> multiply(const Matrix<TNum>& X, const Matrix<TNum>& Y) {
+        if (X.cols != Y.rows) {
+            throw std::invalid_argument("Dimension mismatch");
+        }
+        Matrix<TNum> Z;
+        Z.rows = X.rows;
+        Z.cols = Y.cols;
+        Z.rowPtr.assign(Z.rows + 1, 0);
+        std::vector<int> marker(Y.cols, -1), pattern;
+        std::vector<TNum> acc(Y.cols, TNum(0));
+        for (int i = 0; i < X.rows; ++i) {
+            pattern.clear();
+            for (int p = X.rowPtr[i]; p < X.rowPtr[i + 1]; ++p) {
+                const int k = X.colIdx[p];
+                const TNum x = X.vals[p];
+                for (int q = Y.rowPtr[k]; q < Y.rowPtr[k + 1]; ++q) {
+                    const int j = Y.colIdx[q];
+                    if (marker[j] != i) {
+                        marker[j] = i;
+                        acc[j] = TNum(0);
+                        pattern.push_back(j);
+                    }
+                    acc[j] += x * Y.vals[q];
+                }
+            }
+            std::sort(pattern.begin(), pattern.end());
+            for (int j : pattern) {
+                Z.colIdx.push_back(j);
+                Z.vals.push_back(acc[j]);
+            }
+            Z.rowPtr[i + 1] = static_cast<int>(Z.colIdx.size());
+        }
+        return Z;
+    }
+
+    // y = M x, rows in parallel
+    template <typename TNum>
+    void spmv(const Matrix<TNum>& M, const TNum* x, TNum* y) {
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < M.rows; ++i) {
+            TNum sum = TNum(0);
+            for (int p = M.rowPtr[i]; p < M.rowPtr[i + 1]; ++p) sum += M.vals[p] * x[M.colIdx[p]];
+            y[i] = sum;
+        }
+    }
+} // namespace csr
+
+#endif // CSR_HPP
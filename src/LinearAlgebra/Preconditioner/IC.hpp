@@ -0,0 +1,208 @@
+#ifndef IC_HPP
+#define IC_HPP
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include "../../Obj/SparseObj.hpp"
+#include "../../Obj/VectorObj.hpp"
+#include "ILU.hpp"
+#include "TriangularSolve.hpp"
+#include "Preconditioner.hpp"
+
+/**
+ * @brief Incomplete Cholesky A ~= L L^T for symmetric positive definite A
+ *
+ * Only L is stored, by columns (the CSR rows of L^T), with its diagonal kept
+ * inverted. The factorization is left-looking: column j gathers the updates of
+ * the earlier columns k with l_jk != 0, found through per-row linked lists, so
+ * only the pattern is traversed.
+ *
+ * With dropTol = 0 the pattern of L is the lower triangle of A (IC(0)). With
+ * dropTol > 0 fill is allowed (ICT): an entry is dropped when it is below
+ * dropTol times the norm of the column of A, and at most maxFill off-diagonal
+ * entries are kept per column. If a pivot is not positive the factorization is
+ * restarted on A + alpha diag(A) with a growing shift alpha (Manteuffel), so a
+ * preconditioner is always produced for SPD input. A must be symmetric; the
+ * entries A(j, i) with i >= j are read.
+ */
+template <typename TNum, typename MatrixType = SparseMatrixCSC<TNum>>
+class ICPreconditioner : public Preconditioner<TNum, VectorObj<TNum>> {
+private:
+    TNum dropTol;
+    int maxFill;
+    TNum initialShift;
+    TNum shift = TNum(0);
+    int maxShifts = 10;
+    // Strict lower part of L by columns; row indices are sorted within a column
+    std::vector<int> colPtr, rowIdx;
+    std::vector<TNum> vals, diagInv;
+    sptrsv::LevelSets upperLevels;  // Of L^T, for the backward solve
+    sptrsv::Schedule schedule = sptrsv::Schedule::LevelSet;
+    int n = 0;
+    bool isComputed = false;
+
+    // One attempt with diagonal shift alpha; false on a non-positive pivot
+    bool factorize(const csr::Matrix<TNum>& A, TNum alpha) {
+        colPtr.assign(n + 1, 0);
+        rowIdx.clear();
+        vals.clear();
+        diagInv.assign(n, TNum(0));
+
+        std::vector<TNum> w(n, TNum(0));
+        std::vector<int> marker(n, -1), pattern;
+        // Column k is in the list of row r when its next unused entry is in row r
+        std::vector<int> head(n, -1), link(n, -1), next(n, 0);
+
+        for (int j = 0; j < n; ++j) {
+            pattern.clear();
+            marker[j] = j;
+            w[j] = TNum(0);
+            TNum colNorm = TNum(0);
+            for (int idx = A.rowPtr[j]; idx < A.rowPtr[j + 1]; ++idx) {
+                const int i = A.colIdx[idx];
+                if (i < j) continue;
+                const TNum a = A.vals[idx];
+                colNorm += a * a;
+                if (i == j) {
+                    w[j] += a * (TNum(1) + alpha);
+                } else {
+                    if (marker[i] != j) {
+                        marker[i] = j;
+                        w[i] = TNum(0);
+                        pattern.push_back(i);
+                    }
+                    w[i] += a;
+                }
+            }
+            const bool fill = dropTol > TNum(0);
+            const TNum tol = dropTol * std::sqrt(colNorm);
+
+            // Updates from the earlier columns with an entry in row j
+            for (int k = head[j]; k != -1;) {
+                const int nextK = link[k];
+                const int p0 = next[k];
+                const TNum ljk = vals[p0];
+                w[j] -= ljk * ljk;
+                for (int p = p0 + 1; p < colPtr[k + 1]; ++p) {
+                    const int i = rowIdx[p];
+                    if (marker[i] != j) {
+                        if (!fill) continue;  // IC(0): outside the pattern of A
+                        marker[i] = j;
+                        w[i] = TNum(0);
+                        pattern.push_back(i);
+                    }
+                    w[i] -= ljk * vals[p];
+                }
+                // Move column k on to the row of its next entry
+                if (++next[k] < colPtr[k + 1]) {
+                    const int r = rowIdx[next[k]];
+                    link[k] = head[r];
+                    head[r] = k;
+                }
+                k = nextK;
+            }
+
+            if (!(w[j] > TNum(0))) return false;
+            const TNum ljj = std::sqrt(w[j]);
+            diagInv[j] = TNum(1) / ljj;
+
+            if (fill) {
+                pattern.erase(std::remove_if(pattern.begin(), pattern.end(),
+                                             [&](int i) { return std::abs(w[i]) < tol; }), pattern.end());
+                if (maxFill > 0 && static_cast<int>(pattern.size()) > maxFill) {
+                    std::nth_element(pattern.begin(), pattern.begin() + maxFill, pattern.end(),
+                                     [&w](int a, int b) { return std::abs(w[a]) > std::abs(w[b]); });
+                    pattern.resize(maxFill);
+                }
+            }
+            std::sort(pattern.begin(), pattern.end());
+            for (int i : pattern) {
+                rowIdx.push_back(i);
+                vals.push_back(w[i] / ljj);
+            }
+            colPtr[j + 1] = static_cast<int>(rowIdx.size());
+            next[j] = colPtr[j];
+            if (colPtr[j] < colPtr[j + 1]) {
+                const int r = rowIdx[colPtr[j]];
+                link[j] = head[r];
+                head[r] = j;
+            }
+        }
+        return true;
+    }
+
+public:
+    /**
+     * @param dropTol Relative drop tolerance; 0 gives IC(0)
+     * @param maxFill Maximum off-diagonal entries per column of L when dropping (0: unlimited)
+     * @param shift Initial diagonal shift alpha, factorizing A + alpha diag(A)
+     */
+    explicit ICPreconditioner(TNum dropTol = TNum(0), int maxFill = 0, TNum shift = TNum(0))
+        : dropTol(dropTol), maxFill(maxFill), initialShift(shift) {
+        if (dropTol < TNum(0) || maxFill < 0 || shift < TNum(0)) {
+            throw std::invalid_argument("IC requires non-negative drop tolerance, fill and shift");
+        }
+    }
+
+    // Maximum number of shift increases before giving up (0 disables shifting)
+    void setMaxShifts(int count) {
+        if (count < 0) {
+            throw std::invalid_argument("Number of shifts must be non-negative");
+        }
+        maxShifts = count;
+    }
+
+    void setTriangularSchedule(sptrsv::Schedule s) { schedule = s; }
+
+    void compute(const MatrixType& Matrix) {
+        if (Matrix.getRows() != Matrix.getCols()) {
+            throw std::invalid_argument("Matrix must be square for IC factorization");
+        }
+        isComputed = false;
+        const csr::Matrix<TNum> A = csr::fromMatrix<TNum>(Matrix);
+        n = A.rows;
+
+        shift = initialShift;
+        for (int attempt = 0; !factorize(A, shift); ++attempt) {
+            if (attempt >= maxShifts) {
+                throw std::runtime_error("IC breakdown: non-positive pivot, matrix is not positive definite");
+            }
+            shift = std::max(TNum(2) * shift, TNum(1e-3));
+        }
+        upperLevels = sptrsv::analyze(n, colPtr, rowIdx, false);
+        isComputed = true;
+    }
+
+    VectorObj<TNum> solve(const VectorObj<TNum>& b) const {
+        if (!isComputed) {
+            throw std::runtime_error("IC factorization not computed");
+        }
+        if (static_cast<int>(b.size()) != n) {
+            throw std::invalid_argument("Vector size does not match matrix size");
+        }
+        VectorObj<TNum> x = b;
+        TNum* xp = x.element();
+        // L y = b by columns
+        for (int j = 0; j < n; ++j) {
+            const TNum yj = xp[j] * diagInv[j];
+            xp[j] = yj;
+            for (int p = colPtr[j]; p < colPtr[j + 1]; ++p) xp[rowIdx[p]] -= vals[p] * yj;
+        }
+        // L^T x = y: the columns of L are the rows of L^T
+        sptrsv::solve<TNum>(schedule, upperLevels, n, colPtr.data(), rowIdx.data(), vals.data(), diagInv.data(), xp, false);
+        return x;
+    }
+
+    VectorObj<TNum> apply(const VectorObj<TNum>& r) override {
+        return solve(r);
+    }
+
+    // Shift alpha the factorization succeeded with
+    TNum getShift() const { return shift; }
+    // Stored entries of L, including the diagonal
+    size_t getNonZeros() const { return vals.size() + diagInv.size(); }
+};
+
+#endif // IC_HPP
@@ -3,83 +3,240 @@
 
 #include <vector>
 #include <cmath>
+#include <queue>
+#include <limits>
+#include <algorithm>
+#include <functional>
 #include <stdexcept>
 #include "../../Obj/SparseObj.hpp"
 #include "../../Obj/VectorObj.hpp"
 #include "../../utils.hpp"
+#include "Preconditioner.hpp"
+#include "TriangularSolve.hpp"
+#include "CSR.hpp"
 
-template <typename TNum, typename MatrixType = SparseMatrixCSC<TNum>>
-class ILUPreconditioner {
-private:
-    MatrixType L, U;
-    int n;
-    bool isComputed;
+namespace ilu {
+    /**
+     * @brief Compact incomplete factors A ~= L U in CSR
+     *
+     * L is unit lower triangular and stores only its strictly lower part; U stores
+     * its strictly upper part plus the inverted diagonal. analyze caches the level
+     * sets of both patterns, after which each triangular solve touches every
+     * stored entry once and runs in parallel according to `schedule`.
+     */
+    template <typename TNum>
+    struct Factors {
+        int n = 0;
+        std::vector<int> lPtr, lIdx, uPtr, uIdx;
+        std::vector<TNum> lVal, uVal, uDiagInv;
+        sptrsv::LevelSets lowerLevels, upperLevels;
+        sptrsv::Schedule schedule = sptrsv::Schedule::LevelSet;
 
-public:
-    ILUPreconditioner() : isComputed(false), n(0) {}
+        size_t nnz() const { return lVal.size() + uVal.size() + uDiagInv.size(); }
 
-    void compute(const MatrixType& Matrix) {
-        MatrixType A = Matrix;
-        n = A.getRows();
-        if (n != A.getCols()) {
-            throw std::invalid_argument("Matrix must be square for ILU factorization");
+        // Dependency analysis of the current pattern; rerun whenever the pattern changes
+        void analyze() {
+            lowerLevels = sptrsv::analyze(n, lPtr, lIdx, true);
+            upperLevels = sptrsv::analyze(n, uPtr, uIdx, false);
         }
 
-        // Initialize L and U matrices
-        L = MatrixType(n, n);
-        U = MatrixType(n, n);
-        
-        // Temporary storage for column values
-        std::vector<TNum> work(n);
-        const TNum epsilon = static_cast<TNum>(1e-12);
-        
-        // Perform ILU factorization
-        for (int j = 0; j < n; ++j) {
-            // Check for numerical stability
-            if (std::abs(A(j, j)) < epsilon) {
-                throw std::runtime_error("Matrix is numerically singular");
-            }
+        // x = U^(-1) L^(-1) b, in place
+        void solveInPlace(TNum* x) const {
+            sptrsv::solve<TNum>(schedule, lowerLevels, n, lPtr.data(), lIdx.data(), lVal.data(), nullptr, x, true);
+            sptrsv::solve<TNum>(schedule, upperLevels, n, uPtr.data(), uIdx.data(), uVal.data(), uDiagInv.data(), x, false);
+        }
+    };
+
+    /**
+     * @brief Symbolic ILU(k): the pattern of L + U with level of fill at most k
+     *
+     * Row i starts from the pattern of A plus the diagonal at level 0. Eliminating
+     * with row k < i (in increasing k) creates fill (i, j) at level
+     * lev(i, k) + lev(k, j) + 1, kept when it does not exceed the fill level. Only the pattern
+     * is traversed, so the cost is proportional to the number of updates.
+     */
+    template <typename TNum>
+    void symbolic(const csr::Matrix<TNum>& A, int fillLevel, Factors<TNum>& F) {
+        const int n = A.rows;
+        const int none = std::numeric_limits<int>::max();
+        F.n = n;
+        F.lPtr.assign(n + 1, 0);
+        F.uPtr.assign(n + 1, 0);
+        F.lIdx.clear();
+        F.uIdx.clear();
+        std::vector<int> uLev;  // Level of every stored U entry, parallel to uIdx
+        std::vector<int> lev(n, none);
+        std::vector<int> upper;
+        std::priority_queue<int, std::vector<int>, std::greater<int>> lower;
 
-            // Cache column j for better memory access
-            for (int i = j; i < n; ++i) {
-                work[i] = A(i, j);
+        for (int i = 0; i < n; ++i) {
+            upper.clear();
+            for (int idx = A.rowPtr[i]; idx < A.rowPtr[i + 1]; ++idx) {
+                const int j = A.colIdx[idx];
+                if (lev[j] != none) continue;
+                lev[j] = 0;
+                if (j < i) lower.push(j); else if (j > i) upper.push_back(j);
             }
+            lev[i] = 0;
 
-            // Compute multipliers and update matrix
-            for (int i = j + 1; i < n; ++i) {
-                TNum factor = work[i] / work[j];
-                if (std::abs(factor) > epsilon) {
-                    A.addValue(i, j, factor);
-                    
-                    // Update remaining elements using Gaussian elimination
-                    for (int k = j + 1; k < n; ++k) {
-                        TNum update = A(i, k) - factor * A(j, k);
-                        if (std::abs(update) > epsilon) {
-                            A.addValue(i, k, update);
-                        }
+            while (!lower.empty()) {
+                const int k = lower.top();
+                lower.pop();
+                F.lIdx.push_back(k);
+                for (int idx = F.uPtr[k]; idx < F.uPtr[k + 1]; ++idx) {
+                    const int j = F.uIdx[idx];
+                    const int newLev = lev[k] + uLev[idx] + 1;
+                    if (newLev > fillLevel) continue;
+                    if (lev[j] == none) {
+                        if (j < i) lower.push(j); else if (j > i) upper.push_back(j);
+                        lev[j] = newLev;
+                    } else if (newLev < lev[j]) {
+                        lev[j] = newLev;
                     }
                 }
             }
-            A.finalize();
+            F.lPtr[i + 1] = static_cast<int>(F.lIdx.size());
+
+            std::sort(upper.begin(), upper.end());
+            for (int j : upper) {
+                F.uIdx.push_back(j);
+                uLev.push_back(lev[j]);
+            }
+            F.uPtr[i + 1] = static_cast<int>(F.uIdx.size());
+
+            for (int idx = F.lPtr[i]; idx < F.lPtr[i + 1]; ++idx) lev[F.lIdx[idx]] = none;
+            for (int j : upper) lev[j] = none;
+            lev[i] = none;
         }
+        F.lVal.assign(F.lIdx.size(), TNum(0));
+        F.uVal.assign(F.uIdx.size(), TNum(0));
+        F.uDiagInv.assign(n, TNum(0));
+    }
+
+    /**
+     * @brief Numeric IKJ elimination restricted to the pattern in F
+     *
+     * Row i of A is scattered into a dense work row, eliminated with the finished
+     * rows k of U for each k in the L pattern of row i, and gathered back. Updates
+     * falling outside the pattern are dropped.
+     */
+    template <typename TNum>
+    void numeric(const csr::Matrix<TNum>& A, Factors<TNum>& F) {
+        const int n = A.rows;
+        const TNum epsilon = static_cast<TNum>(1e-12);
+        std::vector<TNum> w(n, TNum(0));
+        std::vector<int> inPattern(n, -1);
 
-        // Extract L and U factors
         for (int i = 0; i < n; ++i) {
-            L.addValue(i, i, TNum(1.0)); // Diagonal of L is always 1
-            for (int j = 0; j < n; ++j) {
-                TNum value = A(i, j);
-                if (std::abs(value) > epsilon) {
-                    if (i > j) {
-                        L.addValue(i, j, value);
-                    } else if (i <= j) {
-                        U.addValue(i, j, value);
-                    }
+            for (int idx = F.lPtr[i]; idx < F.lPtr[i + 1]; ++idx) inPattern[F.lIdx[idx]] = i;
+            for (int idx = F.uPtr[i]; idx < F.uPtr[i + 1]; ++idx) inPattern[F.uIdx[idx]] = i;
+            inPattern[i] = i;
+            for (int idx = A.rowPtr[i]; idx < A.rowPtr[i + 1]; ++idx) w[A.colIdx[idx]] += A.vals[idx];
+
+            for (int idx = F.lPtr[i]; idx < F.lPtr[i + 1]; ++idx) {
+                const int k = F.lIdx[idx];
+                const TNum factor = w[k] * F.uDiagInv[k];
+                w[k] = factor;
+                if (factor == TNum(0)) continue;
+                for (int u = F.uPtr[k]; u < F.uPtr[k + 1]; ++u) {
+                    const int j = F.uIdx[u];
+                    if (inPattern[j] == i) w[j] -= factor * F.uVal[u];
                 }
             }
+
+            if (std::abs(w[i]) < epsilon) {
+                throw std::runtime_error("Matrix is numerically singular");
+            }
+            F.uDiagInv[i] = TNum(1) / w[i];
+            for (int idx = F.lPtr[i]; idx < F.lPtr[i + 1]; ++idx) F.lVal[idx] = w[F.lIdx[idx]];
+            for (int idx = F.uPtr[i]; idx < F.uPtr[i + 1]; ++idx) F.uVal[idx] = w[F.uIdx[idx]];
+
+            // Entries of A outside the pattern never reach the factors; clear the whole row
+            for (int idx = A.rowPtr[i]; idx < A.rowPtr[i + 1]; ++idx) w[A.colIdx[idx]] = TNum(0);
+            for (int idx = F.lPtr[i]; idx < F.lPtr[i + 1]; ++idx) w[F.lIdx[idx]] = TNum(0);
+            for (int idx = F.uPtr[i]; idx < F.uPtr[i + 1]; ++idx) w[F.uIdx[idx]] = TNum(0);
+            w[i] = TNum(0);
         }
+    }
+}
+
+/**
+ * @brief ILU(k) preconditioner working only on the sparsity pattern
+ *
+ * compute runs the symbolic level-of-fill phase once per pattern and the
+ * numeric phase on every call; both cost O(nnz(L + U)) times the average row
+ * length instead of the O(n^2) entry lookups of a dense sweep. Level 0 keeps
+ * the pattern of A. For dense containers the pattern is full and ILU is LU
+ * without pivoting. The factors live in compact CSR arrays; getLFactor and
+ * getUFactor assemble MatrixType copies on first use.
+ */
+template <typename TNum, typename MatrixType = SparseMatrixCSC<TNum>>
+class ILUPreconditioner : public Preconditioner<TNum, VectorObj<TNum>> {
+private:
+    int fillLevel;
+    ilu::Factors<TNum> factors;
+    std::vector<int> patternRowPtr, patternColIdx;  // Pattern of A the symbolic phase was run for
+    mutable MatrixType L, U;
+    mutable bool factorsAssembled = false;
+    int n;
+    bool isComputed;
 
+    void assembleFactors() const {
+        L = MatrixType(n, n);
+        U = MatrixType(n, n);
+        for (int i = 0; i < n; ++i) {
+            L.addValue(i, i, TNum(1.0)); // Diagonal of L is always 1
+            for (int idx = factors.lPtr[i]; idx < factors.lPtr[i + 1]; ++idx) {
+                L.addValue(i, factors.lIdx[idx], factors.lVal[idx]);
+            }
+            U.addValue(i, i, TNum(1) / factors.uDiagInv[i]);
+            for (int idx = factors.uPtr[i]; idx < factors.uPtr[i + 1]; ++idx) {
+                U.addValue(i, factors.uIdx[idx], factors.uVal[idx]);
+            }
+        }
         L.finalize();
         U.finalize();
+        factorsAssembled = true;
+    }
+
+public:
+    explicit ILUPreconditioner(int fillLevel = 0) : fillLevel(fillLevel), n(0), isComputed(false) {
+        if (fillLevel < 0) {
+            throw std::invalid_argument("ILU fill level must be non-negative");
+        }
+    }
+
+    // Changing the level forces a new symbolic phase on the next compute
+    void setFillLevel(int level) {
+        if (level < 0) {
+            throw std::invalid_argument("ILU fill level must be non-negative");
+        }
+        if (level != fillLevel) patternRowPtr.clear();
+        fillLevel = level;
+    }
+
+    int getFillLevel() const { return fillLevel; }
+
+    // Parallel schedule of the triangular solves in apply (level sets by default)
+    void setTriangularSchedule(sptrsv::Schedule schedule) { factors.schedule = schedule; }
+
+    void compute(const MatrixType& Matrix) {
+        if (Matrix.getRows() != Matrix.getCols()) {
+            throw std::invalid_argument("Matrix must be square for ILU factorization");
+        }
+        isComputed = false;
+        factorsAssembled = false;
+        const csr::Matrix<TNum> A = csr::fromMatrix<TNum>(Matrix);
+        n = A.rows;
+
+        // Reuse the symbolic factorization while the pattern is unchanged (Newton, time stepping)
+        if (patternRowPtr != A.rowPtr || patternColIdx != A.colIdx) {
+            ilu::symbolic(A, fillLevel, factors);
+            factors.analyze();
+            patternRowPtr = A.rowPtr;
+            patternColIdx = A.colIdx;
+        }
+        ilu::numeric(A, factors);
         isComputed = true;
     }
 
@@ -90,32 +247,28 @@ public:
         if (static_cast<int>(b.size()) != n) {
             throw std::invalid_argument("Vector size does not match matrix size");
         }
+        VectorObj<TNum> x = b;
+        factors.solveInPlace(x.element());
+        return x;
+    }
 
-        // Forward substitution (Ly = b)
-        VectorObj<TNum> y(n);
-        for (int i = 0; i < n; ++i) {
-            TNum sum = TNum(0);
-            for (int j = 0; j < i; ++j) {
-                sum += L(i,j) * y[j];
-            }
-            y[i] = b[i] - sum;
-        }
+    VectorObj<TNum> apply(const VectorObj<TNum>& r) override {
+        return solve(r);
+    }
 
-        // Back substitution (Ux = y)
-        VectorObj<TNum> x(n);
-        for (int i = n - 1; i >= 0; --i) {
-            TNum sum = TNum(0);
-            for (int j = i + 1; j < n; ++j) {
-                sum += U(i,j) * x[j];
-            }
-            x[i] = (y[i] - sum) / U(i,i);
-        }
+    // Stored entries of L + U, including both diagonals
+    size_t getNonZeros() const { return factors.nnz() + n; }
 
-        return x;
-    }
+    const ilu::Factors<TNum>& getFactors() const { return factors; }
 
-    const MatrixType& getLFactor() const { return L; }
-    const MatrixType& getUFactor() const { return U; }
+    const MatrixType& getLFactor() const {
+        if (isComputed && !factorsAssembled) assembleFactors();
+        return L;
+    }
+    const MatrixType& getUFactor() const {
+        if (isComputed && !factorsAssembled) assembleFactors();
+        return U;
+    }
 };
 
-#endif // ILU_HPP
\ No newline at end of file
+#endif // ILU_HPP
@@ -0,0 +1,205 @@
+#ifndef ILUT_HPP
+#define ILUT_HPP
+
+#include <vector>
+#include <cmath>
+#include <queue>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include "../../Obj/SparseObj.hpp"
+#include "../../Obj/VectorObj.hpp"
+#include "ILU.hpp"
+#include "Preconditioner.hpp"
+
+/**
+ * @brief ILUT(tau, p) with dual dropping and optional column pivoting (ILUTP)
+ *
+ * Row i is eliminated in a dense work row, visiting its lower entries in
+ * increasing column order (fill included). A multiplier or an entry is dropped
+ * when it is below tau * ||a_i||_2, and of the survivors only the p largest of
+ * the L part and the p largest of the U part are kept. Every row therefore
+ * stores at most 2p + 1 entries, so the factors never exceed n (2p + 1) values.
+ *
+ * With a pivot tolerance 0 < pivotTol <= 1, the diagonal is swapped with the
+ * largest U entry of the row when |u_ii| < pivotTol * |u_ij|, giving A Q = L U for
+ * a column permutation Q that solve undoes. A zero pivot that survives is
+ * replaced by (1e-4 + tau) ||a_i||_2 instead of aborting the factorization.
+ */
+template <typename TNum, typename MatrixType = SparseMatrixCSC<TNum>>
+class ILUTPreconditioner : public Preconditioner<TNum, VectorObj<TNum>> {
+private:
+    TNum dropTol;
+    int maxFill;
+    TNum pivotTol;
+    ilu::Factors<TNum> factors;
+    std::vector<int> perm;  // perm[k]: original column placed at position k
+    int n = 0;
+    bool isComputed = false;
+
+    // Keep the `keep` entries of largest magnitude in cols (in place), then sort by column
+    static void keepLargest(std::vector<int>& cols, const std::vector<TNum>& w, int keep) {
+        if (static_cast<int>(cols.size()) > keep) {
+            std::nth_element(cols.begin(), cols.begin() + keep, cols.end(),
+                             [&w](int a, int b) { return std::abs(w[a]) > std::abs(w[b]); });
+            cols.resize(keep);
+        }
+        std::sort(cols.begin(), cols.end());
+    }
+
+public:
+    /**
+     * @param dropTol Relative drop tolerance tau
+     * @param maxFill Maximum number of entries p kept in each row of L and of U
+     * @param pivotTol Column pivoting threshold; 0 disables pivoting
+     */
+    explicit ILUTPreconditioner(TNum dropTol = TNum(1e-3), int maxFill = 10, TNum pivotTol = TNum(0))
+        : dropTol(dropTol), maxFill(maxFill), pivotTol(pivotTol) {
+        if (dropTol < TNum(0) || maxFill < 0) {
+            throw std::invalid_argument("ILUT requires a non-negative drop tolerance and fill");
+        }
+        if (pivotTol < TNum(0) || pivotTol > TNum(1)) {
+            throw std::invalid_argument("ILUT pivot tolerance must be in [0, 1]");
+        }
+    }
+
+    // Parallel schedule of the triangular solves in apply (level sets by default)
+    void setTriangularSchedule(sptrsv::Schedule schedule) { factors.schedule = schedule; }
+
+    void compute(const MatrixType& Matrix) {
+        if (Matrix.getRows() != Matrix.getCols()) {
+            throw std::invalid_argument("Matrix must be square for ILUT factorization");
+        }
+        isComputed = false;
+        const csr::Matrix<TNum> A = csr::fromMatrix<TNum>(Matrix);
+        n = A.rows;
+
+        ilu::Factors<TNum>& F = factors;
+        F.n = n;
+        F.lPtr.assign(n + 1, 0);
+        F.uPtr.assign(n + 1, 0);
+        F.lIdx.clear();
+        F.lVal.clear();
+        F.uIdx.clear();
+        F.uVal.clear();
+        F.uDiagInv.assign(n, TNum(0));
+        // The footprint is bounded by the fill limit, so reserve it once
+        const size_t bound = static_cast<size_t>(n) * maxFill;
+        F.lIdx.reserve(bound);
+        F.lVal.reserve(bound);
+        F.uIdx.reserve(bound);
+        F.uVal.reserve(bound);
+
+        perm.resize(n);
+        std::vector<int> iperm(n);
+        for (int k = 0; k < n; ++k) perm[k] = iperm[k] = k;
+
+        // Work row indexed by permuted column; U rows are stored with original
+        // column numbers until the end because later pivots may still move them
+        std::vector<TNum> w(n, TNum(0));
+        std::vector<int> marker(n, -1);
+        std::vector<int> lowerKept, upper;
+        std::priority_queue<int, std::vector<int>, std::greater<int>> lower;
+
+        for (int i = 0; i < n; ++i) {
+            lowerKept.clear();
+            upper.clear();
+            TNum rowNorm = TNum(0);
+            for (int idx = A.rowPtr[i]; idx < A.rowPtr[i + 1]; ++idx) rowNorm += A.vals[idx] * A.vals[idx];
+            rowNorm = std::sqrt(rowNorm);
+            if (rowNorm == TNum(0)) {
+                throw std::runtime_error("Matrix is singular: zero row in ILUT");
+            }
+            const TNum tol = dropTol * rowNorm;
+
+            auto touch = [&](int c) {
+                if (marker[c] == i) return;
+                marker[c] = i;
+                w[c] = TNum(0);
+                if (c < i) lower.push(c); else if (c > i) upper.push_back(c);
+            };
+            touch(i);
+            for (int idx = A.rowPtr[i]; idx < A.rowPtr[i + 1]; ++idx) {
+                const int c = iperm[A.colIdx[idx]];
+                touch(c);
+                w[c] += A.vals[idx];
+            }
+
+            while (!lower.empty()) {
+                const int k = lower.top();
+                lower.pop();
+                const TNum mult = w[k] * F.uDiagInv[k];
+                w[k] = mult;
+                if (std::abs(mult) < tol) continue;
+                lowerKept.push_back(k);
+                for (int u = F.uPtr[k]; u < F.uPtr[k + 1]; ++u) {
+                    const int c = iperm[F.uIdx[u]];
+                    touch(c);
+                    w[c] -= mult * F.uVal[u];
+                }
+            }
+
+            upper.erase(std::remove_if(upper.begin(), upper.end(),
+                                       [&](int c) { return std::abs(w[c]) < tol; }), upper.end());
+
+            if (pivotTol > TNum(0) && !upper.empty()) {
+                const int jmax = *std::max_element(upper.begin(), upper.end(),
+                                                   [&w](int a, int b) { return std::abs(w[a]) < std::abs(w[b]); });
+                if (pivotTol * std::abs(w[jmax]) > std::abs(w[i])) {
+                    // Exchange positions i and jmax: the old diagonal becomes an U entry
+                    std::swap(w[i], w[jmax]);
+                    std::swap(perm[i], perm[jmax]);
+                    iperm[perm[i]] = i;
+                    iperm[perm[jmax]] = jmax;
+                    if (std::abs(w[jmax]) < tol) upper.erase(std::find(upper.begin(), upper.end(), jmax));
+                }
+            }
+
+            keepLargest(lowerKept, w, maxFill);
+            keepLargest(upper, w, maxFill);
+            for (int k : lowerKept) {
+                F.lIdx.push_back(k);
+                F.lVal.push_back(w[k]);
+            }
+            F.lPtr[i + 1] = static_cast<int>(F.lIdx.size());
+            for (int c : upper) {
+                F.uIdx.push_back(perm[c]);
+                F.uVal.push_back(w[c]);
+            }
+            F.uPtr[i + 1] = static_cast<int>(F.uIdx.size());
+
+            const TNum diag = w[i] != TNum(0) ? w[i] : (TNum(1e-4) + dropTol) * rowNorm;
+            F.uDiagInv[i] = TNum(1) / diag;
+        }
+
+        for (int& c : F.uIdx) c = iperm[c];
+        F.analyze();
+        isComputed = true;
+    }
+
+    VectorObj<TNum> solve(const VectorObj<TNum>& b) const {
+        if (!isComputed) {
+            throw std::runtime_error("ILUT factorization not computed");
+        }
+        if (static_cast<int>(b.size()) != n) {
+            throw std::invalid_argument("Vector size does not match matrix size");
+        }
+        // A Q = L U: y = U^(-1) L^(-1) b, x = Q y
+        VectorObj<TNum> y = b;
+        factors.solveInPlace(y.element());
+        VectorObj<TNum> x(n);
+        for (int k = 0; k < n; ++k) x[perm[k]] = y[k];
+        return x;
+    }
+
+    VectorObj<TNum> apply(const VectorObj<TNum>& r) override {
+        return solve(r);
+    }
+
+    // Stored entries of L + U, including the diagonal of U
+    size_t getNonZeros() const { return factors.nnz(); }
+    const ilu::Factors<TNum>& getFactors() const { return factors; }
+    const std::vector<int>& getPermutation() const { return perm; }
+};
+
+#endif // ILUT_HPP
@@ -0,0 +1,273 @@
+#ifndef JACOBI_HPP
+#define JACOBI_HPP
+
+#include <vector>
+#include <map>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include "../../Obj/SparseObj.hpp"
+#include "../../Obj/VectorObj.hpp"
+#include "../../Obj/BatchedDenseObj.hpp"
+#include "../Factorized/batched.hpp"
+#include "ILU.hpp"
+#include "Preconditioner.hpp"
+
+enum class JacobiType {
+    Point,  // D = diag(A)
+    L1      // d_i = a_ii + sum_{j != i} |a_ij|: convergent smoother for any SPD A, no damping needed
+};
+
+/**
+ * @brief Point and l1-Jacobi preconditioner z = weight * D^(-1) r
+ *
+ * The setup stores D^(-1); apply is one parallel diagonal scaling. smooth runs
+ * the stationary iteration x += weight * D^(-1) (b - A x), e.g. as a multigrid
+ * smoother, where the point variant usually needs a weight of about 2/3.
+ */
+template <typename TNum, typename MatrixType = SparseMatrixCSC<TNum>>
+class JacobiPreconditioner : public Preconditioner<TNum, VectorObj<TNum>> {
+private:
+    JacobiType type;
+    TNum weight;
+    std::vector<TNum> invDiag;
+    bool isComputed = false;
+
+public:
+    explicit JacobiPreconditioner(JacobiType type = JacobiType::Point, TNum weight = TNum(1)) : type(type), weight(weight) {
+        if (!(weight > TNum(0))) {
+            throw std::invalid_argument("Jacobi weight must be positive");
+        }
+    }
+
+    void compute(const MatrixType& Matrix) {
+        if (Matrix.getRows() != Matrix.getCols()) {
+            throw std::invalid_argument("Matrix must be square for Jacobi");
+        }
+        isComputed = false;
+        const csr::Matrix<TNum> A = csr::fromMatrix<TNum>(Matrix);
+        invDiag.assign(A.rows, TNum(0));
+        bool singular = false;
+        #pragma omp parallel for schedule(static) reduction(|| : singular)
+        for (int i = 0; i < A.rows; ++i) {
+            TNum d = TNum(0), offDiag = TNum(0);
+            for (int p = A.rowPtr[i]; p < A.rowPtr[i + 1]; ++p) {
+                if (A.colIdx[p] == i) d += A.vals[p];
+                else offDiag += std::abs(A.vals[p]);
+            }
+            if (type == JacobiType::L1) d += offDiag;
+            if (d == TNum(0)) singular = true;
+            else invDiag[i] = weight / d;
+        }
+        if (singular) {
+            throw std::runtime_error("Jacobi: zero diagonal entry");
+        }
+        isComputed = true;
+    }
+
+    VectorObj<TNum> apply(const VectorObj<TNum>& r) override {
+        if (!isComputed) {
+            throw std::runtime_error("Jacobi not computed");
+        }
+        if (r.size() != invDiag.size()) {
+            throw std::invalid_argument("Vector size does not match matrix size");
+        }
+        const int n = static_cast<int>(invDiag.size());
+        VectorObj<TNum> z(n);
+        const TNum* rp = r.element();
+        TNum* zp = z.element();
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < n; ++i) zp[i] = invDiag[i] * rp[i];
+        return z;
+    }
+
+    // steps iterations of x += weight * D^(-1) (b - A x)
+    template <typename VectorType>
+    void smooth(const MatrixType& A, const VectorType& b, VectorType& x, int steps) const {
+        if (!isComputed) {
+            throw std::runtime_error("Jacobi not computed");
+        }
+        const int n = static_cast<int>(invDiag.size());
+        for (int k = 0; k < steps; ++k) {
+            const VectorType r = b - A * x;
+            const TNum* rp = r.element();
+            TNum* xp = x.element();
+            #pragma omp parallel for schedule(static)
+            for (int i = 0; i < n; ++i) xp[i] += invDiag[i] * rp[i];
+        }
+    }
+
+    // weight * D^(-1), with D the point or l1 diagonal
+    const std::vector<TNum>& getInverseDiagonal() const { return invDiag; }
+};
+
+/**
+ * @brief Block-Jacobi preconditioner with explicitly inverted diagonal blocks
+ *
+ * The blocks are either given as a partition of the unknowns (setBlocks), of a
+ * fixed size, or detected automatically: consecutive rows with identical
+ * sparsity patterns, such as the degrees of freedom of one node of a finite
+ * element mesh, form a block. Blocks of equal size are factored together with
+ * batched::LU and inverted once at setup, so apply is one small dense
+ * matrix-vector product per block, all blocks in parallel. With setL1(true) the
+ * off-block absolute row sums are added to the block diagonals (l1 block-Jacobi).
+ */
+template <typename TNum, typename MatrixType = SparseMatrixCSC<TNum>>
+class BlockJacobiPreconditioner : public Preconditioner<TNum, VectorObj<TNum>> {
+private:
+    int blockSize;
+    int maxDetectedSize = 16;
+    bool l1 = false;
+    std::vector<int> userBlocks;
+    // Block b covers rows blockPtr[b] .. blockPtr[b + 1] - 1; its inverse is
+    // stored row-major at inverses[invPtr[b]]
+    std::vector<int> blockPtr, invPtr;
+    std::vector<TNum> inverses;
+    int n = 0;
+    bool isComputed = false;
+
+    void partition(const csr::Matrix<TNum>& A) {
+        blockPtr.assign(1, 0);
+        if (!userBlocks.empty()) {
+            if (userBlocks.front() != 0 || userBlocks.back() != A.rows) {
+                throw std::invalid_argument("Blocks must partition the unknowns 0 .. n - 1");
+            }
+            for (size_t b = 1; b < userBlocks.size(); ++b) {
+                if (userBlocks[b] <= userBlocks[b - 1]) {
+                    throw std::invalid_argument("Block offsets must be strictly increasing");
+                }
+            }
+            blockPtr = userBlocks;
+        } else if (blockSize > 0) {
+            for (int start = blockSize; start < A.rows; start += blockSize) blockPtr.push_back(start);
+            if (A.rows > 0) blockPtr.push_back(A.rows);
+        } else {
+            for (int i = 1; i <= A.rows; ++i) {
+                const bool samePattern = i < A.rows && i - blockPtr.back() < maxDetectedSize
+                    && std::equal(A.colIdx.begin() + A.rowPtr[i - 1], A.colIdx.begin() + A.rowPtr[i],
+                                  A.colIdx.begin() + A.rowPtr[i], A.colIdx.begin() + A.rowPtr[i + 1]);
+                if (!samePattern) blockPtr.push_back(i);
+            }
+        }
+    }
+
+public:
+    /**
+     * @param blockSize Fixed block size; 0 detects the blocks from the sparsity pattern
+     */
+    explicit BlockJacobiPreconditioner(int blockSize = 0) : blockSize(blockSize) {
+        if (blockSize < 0) {
+            throw std::invalid_argument("Block size must be non-negative");
+        }
+    }
+
+    // User-defined blocks: offsets 0 = b_0 < b_1 < ... < b_m = n, used by the next compute
+    void setBlocks(const std::vector<int>& offsets) {
+        if (offsets.size() < 2) {
+            throw std::invalid_argument("Block offsets need at least one block");
+        }
+        userBlocks = offsets;
+    }
+
+    // Upper bound on the size of automatically detected blocks
+    void setMaxBlockSize(int size) {
+        if (size < 1) {
+            throw std::invalid_argument("Block size must be positive");
+        }
+        maxDetectedSize = size;
+    }
+
+    void setL1(bool enable) { l1 = enable; }
+
+    void compute(const MatrixType& Matrix) {
+        if (Matrix.getRows() != Matrix.getCols()) {
+            throw std::invalid_argument("Matrix must be square for block-Jacobi");
+        }
+        isComputed = false;
+        const csr::Matrix<TNum> A = csr::fromMatrix<TNum>(Matrix);
+        n = A.rows;
+        partition(A);
+        const int numBlocks = static_cast<int>(blockPtr.size()) - 1;
+
+        invPtr.assign(numBlocks + 1, 0);
+        std::map<int, std::vector<int>> bySize;
+        for (int b = 0; b < numBlocks; ++b) {
+            const int s = blockPtr[b + 1] - blockPtr[b];
+            invPtr[b + 1] = invPtr[b] + s * s;
+            bySize[s].push_back(b);
+        }
+        inverses.assign(invPtr[numBlocks], TNum(0));
+
+        for (const auto& group : bySize) {
+            const int s = group.first;
+            const std::vector<int>& blocks = group.second;
+            const int count = static_cast<int>(blocks.size());
+
+            BatchedDenseObj<TNum> D(s, s, count), X(s, s, count);
+            #pragma omp parallel for schedule(static)
+            for (int k = 0; k < count; ++k) {
+                const int start = blockPtr[blocks[k]];
+                for (int r = 0; r < s; ++r) {
+                    const int i = start + r;
+                    TNum offBlock = TNum(0);
+                    for (int p = A.rowPtr[i]; p < A.rowPtr[i + 1]; ++p) {
+                        const int c = A.colIdx[p] - start;
+                        if (c >= 0 && c < s) D.lane(r, c)[k] += A.vals[p];
+                        else offBlock += std::abs(A.vals[p]);
+                    }
+                    if (l1) D.lane(r, r)[k] += offBlock;
+                    X.lane(r, r)[k] = TNum(1);
+                }
+            }
+            std::vector<int> pivots;
+            batched::LU(D, pivots);
+            batched::LUSolve(D, pivots, X);
+
+            #pragma omp parallel for schedule(static)
+            for (int k = 0; k < count; ++k) {
+                TNum* inv = inverses.data() + invPtr[blocks[k]];
+                for (int r = 0; r < s; ++r) {
+                    for (int c = 0; c < s; ++c) inv[r * s + c] = X.lane(r, c)[k];
+                }
+            }
+        }
+        isComputed = true;
+    }
+
+    VectorObj<TNum> apply(const VectorObj<TNum>& r) override {
+        if (!isComputed) {
+            throw std::runtime_error("Block-Jacobi not computed");
+        }
+        if (static_cast<int>(r.size()) != n) {
+            throw std::invalid_argument("Vector size does not match matrix size");
+        }
+        VectorObj<TNum> z(n);
+        const TNum* rp = r.element();
+        TNum* zp = z.element();
+        const int numBlocks = static_cast<int>(blockPtr.size()) - 1;
+        #pragma omp parallel for schedule(static)
+        for (int b = 0; b < numBlocks; ++b) {
+            const int start = blockPtr[b], s = blockPtr[b + 1] - start;
+            const TNum* inv = inverses.data() + invPtr[b];
+            for (int i = 0; i < s; ++i) {
+                TNum sum = TNum(0);
+                for (int j = 0; j < s; ++j) sum += inv[i * s + j] * rp[start + j];
+                zp[start + i] = sum;
+            }
+        }
+        return z;
+    }
+
+    // steps iterations of x += M^(-1) (b - A x)
+    void smooth(const MatrixType& A, const VectorObj<TNum>& b, VectorObj<TNum>& x, int steps) {
+        for (int k = 0; k < steps; ++k) {
+            x.axpy(TNum(1), apply(b - A * x));
+        }
+    }
+
+    int getBlockCount() const { return static_cast<int>(blockPtr.size()) - 1; }
+    // Block offsets of the last compute
+    const std::vector<int>& getBlocks() const { return blockPtr; }
+};
+
+#endif // JACOBI_HPP
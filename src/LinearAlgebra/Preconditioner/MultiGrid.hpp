@@ -3,27 +3,169 @@
 
 #include "../../Obj/SparseObj.hpp"
 #include "../Solver/IterSolver.hpp"
+#include "../Solver/Chebyshev.hpp"
+#include "CSR.hpp"
+#include "Jacobi.hpp"
+#include "Preconditioner.hpp"
 #include <vector>
 #include <cmath>
-#include <unordered_map>
+#include <memory>
 #include <unordered_set>
-#include <iostream>
 #include <algorithm>
 #include <numeric>
 
-// Algebraic Multi-Grid Solver Template
+// Relaxation used on every level of the V-cycle
+enum class AMGSmoother {
+    SOR,       // Sequential sweeps over the rows
+    Chebyshev, // Polynomial in D^(-1) A: parallel SpMVs, no inner products
+    Jacobi,    // Damped point Jacobi, weight 2/3
+    L1Jacobi   // l1-Jacobi, convergent without damping for SPD A
+};
+
+/**
+ * @brief Levels and smoothers shared by the AMG hierarchies
+ *
+ * Every level keeps its operator, the transfers to the next coarser level
+ * (stored as TransferType) and the data of the selected smoother. The derived
+ * classes build the levels and call setupSmoothers once they are complete.
+ */
+template <typename TNum, typename VectorType, typename TransferType>
+class AMGLevels {
+protected:
+    // Operator of one level, transfers to the next coarser level and smoother data
+    struct Level {
+        SparseMatrixCSC<TNum> A;
+        TransferType P;  // Coarse -> this level; empty on the coarsest level
+        TransferType R;  // P^T
+        std::unique_ptr<ChebyshevSmoother<TNum, VectorType>> chebyshev;
+        std::unique_ptr<JacobiPreconditioner<TNum>> jacobi;
+    };
+
+    AMGSmoother smoother;
+    int chebyshevDegree = 2;
+    // Levels are not moved once built: the smoothers keep references to Level::A
+    std::vector<std::unique_ptr<Level>> hierarchy;
+
+    explicit AMGLevels(AMGSmoother smoother) : smoother(smoother) {}
+
+    void setupSmoother(Level& level) {
+        level.chebyshev.reset();
+        level.jacobi.reset();
+        if (smoother == AMGSmoother::Chebyshev) {
+            level.chebyshev.reset(new ChebyshevSmoother<TNum, VectorType>(level.A, chebyshevDegree));
+        } else if (smoother == AMGSmoother::Jacobi || smoother == AMGSmoother::L1Jacobi) {
+            level.jacobi.reset(new JacobiPreconditioner<TNum>(
+                smoother == AMGSmoother::Jacobi ? JacobiType::Point : JacobiType::L1,
+                smoother == AMGSmoother::Jacobi ? TNum(2) / TNum(3) : TNum(1)));
+            level.jacobi->compute(level.A);
+        }
+    }
+
+    void setupSmoothers() {
+        for (auto& level : hierarchy) setupSmoother(*level);
+    }
+
+    // smoothingSteps sweeps (SOR, Jacobi) or Chebyshev applications on A x = b
+    void smooth(const Level& level, const VectorType& b, VectorType& x, int smoothingSteps) {
+        if (level.chebyshev) {
+            for (int k = 0; k < smoothingSteps; ++k) level.chebyshev->smooth(b, x);
+        } else if (level.jacobi) {
+            level.jacobi->smooth(level.A, b, x, smoothingSteps);
+        } else {
+            SOR<TNum, SparseMatrixCSC<TNum>, VectorType>(level.A, b, smoothingSteps).solve(x);
+        }
+    }
+
+public:
+    void setSmoother(AMGSmoother type, int degree = 2) {
+        if (degree < 1) {
+            throw std::invalid_argument("Smoother degree must be positive");
+        }
+        smoother = type;
+        chebyshevDegree = degree;
+        setupSmoothers();
+    }
+
+    // Number of levels built by the last setup
+    int getNumLevels() const { return static_cast<int>(hierarchy.size()); }
+
+    // Size of the operator on level l (0 is the finest)
+    int getLevelSize(int l) const { return hierarchy.at(l)->A.getRows(); }
+
+    // Sum of the nonzeros of all level operators over those of the finest one
+    double getOperatorComplexity() const {
+        if (hierarchy.empty()) return 0.0;
+        double total = 0.0;
+        for (const auto& level : hierarchy) total += static_cast<double>(level->A.values.size());
+        return total / static_cast<double>(hierarchy.front()->A.values.size());
+    }
+};
+
+/**
+ * @brief Classical algebraic multigrid with a cached hierarchy
+ *
+ * setup(A, levels, theta) builds every level once: strong connections, the
+ * greedy C/F splitting, the prolongation P, the restriction R = P^T, the
+ * Galerkin operator R A P and the smoother data (Chebyshev interval, Jacobi
+ * diagonal). vcycle then only applies the stored hierarchy and can be called
+ * for any number of right-hand sides. Coarsening stops early when a level
+ * would keep more than maxCoarseFraction of its points (or none at all), so
+ * no level repeats the operator of the one above it.
+ *
+ * amgVCycle(A, b, x, ...) is kept for existing callers: it rebuilds the
+ * hierarchy only when A, levels or theta differ from the cached ones.
+ */
 template <typename TNum, typename VectorType>
-class AlgebraicMultiGrid {
+class AlgebraicMultiGrid : public AMGLevels<TNum, VectorType, SparseMatrixCSC<TNum>> {
 private:
-    // Compute strong connections based on threshold theta
+    using Base = AMGLevels<TNum, VectorType, SparseMatrixCSC<TNum>>;
+    using typename Base::Level;
+    using Base::hierarchy;
+    using Base::smooth;
+    using Base::setupSmoothers;
+
+    // A coarse level must have at most this fraction of the points of the finer one
+    static constexpr double maxCoarseFraction = 0.8;
+
+    int builtLevels = 0;
+    TNum builtTheta = TNum(0);
+
+    void cycle(size_t l, const VectorType& b, VectorType& x, int smoothingSteps) {
+        const Level& level = *hierarchy[l];
+        if (l + 1 == hierarchy.size()) {
+            smooth(level, b, x, smoothingSteps);
+            return;
+        }
+
+        // Pre-smoothing
+        smooth(level, b, x, smoothingSteps);
+
+        // Restrict the residual and solve for the coarse correction
+        const VectorType r_c = level.R * (b - level.A * x);
+        VectorType x_c(r_c.size(), TNum(0));
+        cycle(l + 1, r_c, x_c, smoothingSteps);
+        x = x + level.P * x_c;
+
+        // Post-smoothing
+        smooth(level, b, x, smoothingSteps);
+    }
+
+    // Strong connections (Ruge-Stueben): j is strong for row i if |a_ij| >= theta * max_{k != i} |a_ik|,
+    // symmetrized for the splitting. Rows without off-diagonal entries have no connections.
     std::vector<std::unordered_set<int>> computeStrongConnections(const SparseMatrixCSC<TNum>& A, TNum theta) {
+        std::vector<TNum> rowMax(A.getRows(), TNum(0));
+        for (int col = 0; col < A.getCols(); ++col) {
+            for (int k = A.col_ptr[col]; k < A.col_ptr[col + 1]; ++k) {
+                const int row = A.row_indices[k];
+                if (row != col) rowMax[row] = std::max(rowMax[row], std::abs(A.values[k]));
+            }
+        }
         std::vector<std::unordered_set<int>> connections(A.getRows());
         for (int col = 0; col < A.getCols(); ++col) {
-            TNum diag = std::abs(A(col, col));
             for (int k = A.col_ptr[col]; k < A.col_ptr[col + 1]; ++k) {
-                int row = A.row_indices[k];
-                TNum value = std::abs(A.values[k]);
-                if (row != col && value > theta * diag) {
+                const int row = A.row_indices[k];
+                const TNum value = std::abs(A.values[k]);
+                if (row != col && value > TNum(0) && value >= theta * rowMax[row]) {
                     connections[row].insert(col);
                     connections[col].insert(row);
                 }
@@ -32,14 +174,17 @@ private:
         return connections;
     }
 
-    // Coarse grid selection using greedy C/F splitting
+    // Coarse grid selection using greedy C/F splitting; points without strong
+    // connections are fine points left to the smoother
     std::vector<int> coarseGridSelection(const SparseMatrixCSC<TNum>& A, TNum theta) {
         auto strongConnections = computeStrongConnections(A, theta);
         std::vector<int> gridFlag(A.getRows(), -1); // -1: Unassigned, 0: Fine, 1: Coarse
         std::vector<int> coarsePoints;
 
         for (int i = 0; i < A.getRows(); ++i) {
-            if (gridFlag[i] == -1) {
+            if (gridFlag[i] == -1 && strongConnections[i].empty()) {
+                gridFlag[i] = 0;
+            } else if (gridFlag[i] == -1) {
                 gridFlag[i] = 1; // Mark as coarse
                 coarsePoints.push_back(i);
                 for (int neighbor : strongConnections[i]) {
@@ -52,74 +197,142 @@ private:
         return coarsePoints;
     }
 
-    // Build prolongation matrix P
+    // Build prolongation matrix P by direct interpolation from the coarse neighbours
+    // of every fine point: w_ik = -(a_ik / a_ii) * sum_{j != i} a_ij / sum_{j in C_i} a_ij
     SparseMatrixCSC<TNum> buildProlongation(const SparseMatrixCSC<TNum>& A, const std::vector<int>& coarsePoints) {
-        SparseMatrixCSC<TNum> P(A.getRows(), coarsePoints.size());
-        std::unordered_map<int, int> coarseMap;
+        const int n = A.getRows();
+        SparseMatrixCSC<TNum> P(n, coarsePoints.size());
+        std::vector<int> coarseIndex(n, -1);
         for (size_t i = 0; i < coarsePoints.size(); ++i) {
-            coarseMap[coarsePoints[i]] = i;
+            coarseIndex[coarsePoints[i]] = static_cast<int>(i);
             P.addValue(coarsePoints[i], i, 1.0);
         }
 
-        for (int i = 0; i < A.getRows(); ++i) {
-            if (coarseMap.find(i) == coarseMap.end()) { // Fine points
-                TNum sum = 0.0;
-                for (int k = A.col_ptr[i]; k < A.col_ptr[i + 1]; ++k) {
-                    sum += std::abs(A.values[k]);
-                }
-                for (int k = A.col_ptr[i]; k < A.col_ptr[i + 1]; ++k) {
-                    int coarseIdx = coarseMap[A.row_indices[k]];
-                    P.addValue(i, coarseIdx, A.values[k] / sum);
+        const csr::Matrix<TNum> rows = csr::fromMatrix<TNum>(A);
+        for (int i = 0; i < n; ++i) {
+            if (coarseIndex[i] >= 0) continue;
+            TNum diag = TNum(0), allSum = TNum(0), coarseSum = TNum(0);
+            for (int k = rows.rowPtr[i]; k < rows.rowPtr[i + 1]; ++k) {
+                const int j = rows.colIdx[k];
+                if (j == i) {
+                    diag += rows.vals[k];
+                } else {
+                    allSum += rows.vals[k];
+                    if (coarseIndex[j] >= 0) coarseSum += rows.vals[k];
                 }
             }
+            if (diag == TNum(0) || coarseSum == TNum(0)) continue;  // Left to the smoother
+            const TNum scale = -allSum / (coarseSum * diag);
+            for (int k = rows.rowPtr[i]; k < rows.rowPtr[i + 1]; ++k) {
+                const int j = rows.colIdx[k];
+                if (j != i && coarseIndex[j] >= 0) P.addValue(i, coarseIndex[j], scale * rows.vals[k]);
+            }
         }
         P.finalize();
         return P;
     }
 
-    // Compute Galerkin coarse matrix A_c = P^T * A * P
-    SparseMatrixCSC<TNum> galerkinCoarseMatrix(const SparseMatrixCSC<TNum>& A, const SparseMatrixCSC<TNum>& P) {
-        SparseMatrixCSC<TNum> PT = P.Transpose();
-        SparseMatrixCSC<TNum> AP = A * P;
-        return PT * AP;
+    // Compute Galerkin coarse matrix A_c = R * A * P
+    SparseMatrixCSC<TNum> galerkinCoarseMatrix(const SparseMatrixCSC<TNum>& A, const SparseMatrixCSC<TNum>& P,
+                                               const SparseMatrixCSC<TNum>& R) {
+        // Row-wise sparse products: cost proportional to the flops, not to rows x columns
+        const csr::Matrix<TNum> AP = csr::multiply(csr::fromMatrix<TNum>(A), csr::fromMatrix<TNum>(P));
+        return csr::toCSC(csr::multiply(csr::fromMatrix<TNum>(R), AP));
+    }
+
+    bool matchesHierarchy(const SparseMatrixCSC<TNum>& A, int levels, TNum theta) const {
+        if (hierarchy.empty() || levels != builtLevels || theta != builtTheta) return false;
+        const SparseMatrixCSC<TNum>& cached = hierarchy.front()->A;
+        return A.getRows() == cached.getRows() && A.getCols() == cached.getCols() && A.col_ptr == cached.col_ptr
+            && A.row_indices == cached.row_indices && A.values == cached.values;
     }
 
 public:
-    AlgebraicMultiGrid() = default;
+    AlgebraicMultiGrid() : Base(AMGSmoother::SOR) {}
     ~AlgebraicMultiGrid() = default;
 
-    // Recursive AMG V-cycle
-    void amgVCycle(const SparseMatrixCSC<TNum>& A, const VectorType& b, VectorType& x, int levels, int smoothingSteps, TNum theta) {
-        if (levels == 1) {
-            SOR<TNum, SparseMatrixCSC<TNum>, VectorType>(A, b, smoothingSteps).solve(x);
-            return;
+    /**
+     * @brief Build and store the hierarchy for A
+     * @param levels Maximum number of levels, including the finest one
+     * @param theta Strength-of-connection threshold relative to the largest off-diagonal of each row
+     * @throws std::runtime_error if A is not square
+     */
+    void setup(const SparseMatrixCSC<TNum>& A, int levels, TNum theta) {
+        if (A.getRows() != A.getCols()) {
+            throw std::runtime_error("AMG requires a square matrix");
         }
+        if (levels < 1) {
+            throw std::invalid_argument("AMG needs at least one level");
+        }
+        hierarchy.clear();
+        hierarchy.emplace_back(new Level());
+        hierarchy.back()->A = A;
+        while (static_cast<int>(hierarchy.size()) < levels) {
+            Level& fine = *hierarchy.back();
+            const std::vector<int> coarsePoints = coarseGridSelection(fine.A, theta);
+            if (coarsePoints.empty() || coarsePoints.size() > maxCoarseFraction * fine.A.getRows()) break;
+            fine.P = buildProlongation(fine.A, coarsePoints);
+            fine.R = fine.P.Transpose();
+            std::unique_ptr<Level> coarse(new Level());
+            coarse->A = galerkinCoarseMatrix(fine.A, fine.P, fine.R);
+            hierarchy.push_back(std::move(coarse));
+        }
+        setupSmoothers();
+        builtLevels = levels;
+        builtTheta = theta;
+    }
 
-        // Pre-smoothing
-        SOR<TNum, SparseMatrixCSC<TNum>, VectorType>(A, b, smoothingSteps).solve(x);
-
-        // Compute residual r = b - A * x
-        VectorType r = b - (const_cast<SparseMatrixCSC<TNum>&>(A) * x);
+    // One V-cycle on A x = b with the hierarchy of the last setup
+    void vcycle(const VectorType& b, VectorType& x, int smoothingSteps) {
+        if (hierarchy.empty()) {
+            throw std::runtime_error("AMG hierarchy not set up");
+        }
+        if (static_cast<int>(b.size()) != hierarchy.front()->A.getRows() || x.size() != b.size()) {
+            throw std::invalid_argument("Vector size does not match matrix size");
+        }
+        cycle(0, b, x, smoothingSteps);
+    }
 
-        // Build coarse grid
-        auto coarsePoints = coarseGridSelection(A, theta);
-        SparseMatrixCSC<TNum> P = buildProlongation(A, coarsePoints);
-        SparseMatrixCSC<TNum> A_c = galerkinCoarseMatrix(A, P);
+    // Recursive AMG V-cycle; the hierarchy is rebuilt only when A, levels or theta change
+    void amgVCycle(const SparseMatrixCSC<TNum>& A, const VectorType& b, VectorType& x, int levels, int smoothingSteps, TNum theta) {
+        if (!matchesHierarchy(A, levels, theta)) {
+            setup(A, levels, theta);
+        }
+        vcycle(b, x, smoothingSteps);
+    }
+};
 
-        // Restrict residual to coarse grid
-        VectorType r_c = P.Transpose() * r;
+/**
+ * @brief One AMG V-cycle from a zero initial guess as a preconditioner
+ *
+ * The hierarchy is built once in the constructor. The SOR smoothing makes the
+ * cycle a non-symmetric, slightly nonlinear operator, so use it with a
+ * flexible method such as FGMRES. With the Chebyshev smoother the cycle is a
+ * fixed symmetric operator for symmetric A.
+ */
+template <typename TNum, typename VectorType>
+class AMGPreconditioner : public Preconditioner<TNum, VectorType> {
+private:
+    AlgebraicMultiGrid<TNum, VectorType> amg;
+    int smoothingSteps;
 
-        // Solve on coarse grid
-        VectorType x_c(r_c.size(), 0.0);
-        amgVCycle(A_c, r_c, x_c, levels - 1, smoothingSteps, theta);
+public:
+    AMGPreconditioner(const SparseMatrixCSC<TNum>& A, int levels, int smoothingSteps, TNum theta)
+        : smoothingSteps(smoothingSteps) {
+        amg.setup(A, levels, theta);
+    }
 
-        // Prolong correction to fine grid
-        VectorType correction = P * x_c;
-        x = x + correction;
+    void setSmoother(AMGSmoother type, int degree = 2) {
+        amg.setSmoother(type, degree);
+    }
 
-        // Post-smoothing
-        SOR<TNum, SparseMatrixCSC<TNum>, VectorType>(A, b, smoothingSteps).solve(x);
+    VectorType apply(const VectorType& r) override {
+        VectorType z(r.size(), TNum(0));
+        amg.vcycle(r, z, smoothingSteps);
+        return z;
     }
+
+    const AlgebraicMultiGrid<TNum, VectorType>& getHierarchy() const { return amg; }
 };
 
 #endif // AMG_HPP
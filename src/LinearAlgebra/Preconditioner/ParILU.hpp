@@ -0,0 +1,291 @@
+#ifndef PARILU_HPP
+#define PARILU_HPP
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <stdexcept>
+#include "../../Obj/SparseObj.hpp"
+#include "../../Obj/VectorObj.hpp"
+#include "ILU.hpp"
+#include "Preconditioner.hpp"
+
+/**
+ * @brief Fine-grained parallel ILU (Chow-Patel) by asynchronous fixed-point sweeps
+ *
+ * On the ILU(k) pattern S the incomplete factors satisfy (L U)_ij = a_ij for all
+ * (i, j) in S, i.e.
+ *     l_ij = (a_ij - sum_{k<j} l_ik u_kj) / u_jj   (i > j)
+ *     u_ij =  a_ij - sum_{k<i} l_ik u_kj           (i <= j).
+ * Each sweep evaluates every equation once, all rows in parallel. By default the
+ * entries are updated in place, so a sweep sees a mix of old and new values
+ * (with one thread a single sweep in row order is the exact ILU). A few sweeps
+ * from the scaled entries of A already give a preconditioner as good as ILU(k);
+ * update() starts from the previous factors instead, which is what a slowly
+ * changing matrix (time stepping, Newton) needs.
+ *
+ * apply uses the exact triangular solves of ilu::Factors, or a fixed number of
+ * Jacobi iterations on each triangular system, which are SpMVs and parallelise
+ * like them at the price of an approximate solve.
+ */
+template <typename TNum, typename MatrixType = SparseMatrixCSC<TNum>>
+class ParILUPreconditioner : public Preconditioner<TNum, VectorObj<TNum>> {
+private:
+    int sweeps;
+    int fillLevel;
+    int jacobiSolves = 0;
+    bool asynchronous = true;
+    ilu::Factors<TNum> factors;
+    std::vector<TNum> uDiag;
+    // Values of A on the pattern, parallel to lIdx, uIdx and the diagonal
+    std::vector<TNum> aL, aU, aDiag;
+    // Strict U by columns: rows uColRow[p] of column j at p in [uColPtr[j], uColPtr[j + 1]), value uVal[uColPos[p]]
+    std::vector<int> uColPtr, uColRow, uColPos;
+    std::vector<int> patternRowPtr, patternColIdx;
+    int n = 0;
+    bool isComputed = false;
+
+    static TNum load(const TNum& v) {
+        TNum out;
+        #pragma omp atomic read relaxed
+        out = v;
+        return out;
+    }
+
+    static void store(TNum& v, TNum value) {
+        #pragma omp atomic write relaxed
+        v = value;
+    }
+
+    // sum_{k < limit} l_ik u_kj by merging row i of L with column j of strict U (values lv, uv)
+    TNum rowColumnProduct(int i, int j, int limit, const TNum* lv, const TNum* uv) const {
+        TNum sum = TNum(0);
+        int a = factors.lPtr[i];
+        int b = uColPtr[j];
+        const int aEnd = factors.lPtr[i + 1], bEnd = uColPtr[j + 1];
+        while (a < aEnd && b < bEnd) {
+            const int ka = factors.lIdx[a], kb = uColRow[b];
+            if (ka >= limit || kb >= limit) break;
+            if (ka == kb) {
+                sum += load(lv[a]) * load(uv[uColPos[b]]);
+                ++a;
+                ++b;
+            } else if (ka < kb) {
+                ++a;
+            } else {
+                ++b;
+            }
+        }
+        return sum;
+    }
+
+    void sweep() {
+        // Synchronous sweeps read a snapshot of the previous sweep (Jacobi-like, reproducible);
+        // asynchronous ones read whatever the other rows have written so far
+        std::vector<TNum> lOld, uOld, dOld;
+        if (!asynchronous) {
+            lOld = factors.lVal;
+            uOld = factors.uVal;
+            dOld = uDiag;
+        }
+        const TNum* lv = asynchronous ? factors.lVal.data() : lOld.data();
+        const TNum* uv = asynchronous ? factors.uVal.data() : uOld.data();
+        const TNum* dv = asynchronous ? uDiag.data() : dOld.data();
+
+        #pragma omp parallel for schedule(dynamic, 64)
+        for (int i = 0; i < n; ++i) {
+            for (int idx = factors.lPtr[i]; idx < factors.lPtr[i + 1]; ++idx) {
+                const int j = factors.lIdx[idx];
+                store(factors.lVal[idx], (aL[idx] - rowColumnProduct(i, j, j, lv, uv)) / load(dv[j]));
+            }
+            store(uDiag[i], aDiag[i] - rowColumnProduct(i, i, i, lv, uv));
+            for (int idx = factors.uPtr[i]; idx < factors.uPtr[i + 1]; ++idx) {
+                store(factors.uVal[idx], aU[idx] - rowColumnProduct(i, factors.uIdx[idx], i, lv, uv));
+            }
+        }
+    }
+
+    // Pattern, CSC view of U and the values of A on the pattern
+    void setup(const csr::Matrix<TNum>& A) {
+        n = A.rows;
+        if (patternRowPtr != A.rowPtr || patternColIdx != A.colIdx) {
+            ilu::symbolic(A, fillLevel, factors);
+            factors.analyze();
+            patternRowPtr = A.rowPtr;
+            patternColIdx = A.colIdx;
+
+            uColPtr.assign(n + 1, 0);
+            for (int c : factors.uIdx) ++uColPtr[c + 1];
+            for (int j = 0; j < n; ++j) uColPtr[j + 1] += uColPtr[j];
+            uColRow.resize(factors.uIdx.size());
+            uColPos.resize(factors.uIdx.size());
+            std::vector<int> next(uColPtr.begin(), uColPtr.end() - 1);
+            for (int i = 0; i < n; ++i) {
+                for (int idx = factors.uPtr[i]; idx < factors.uPtr[i + 1]; ++idx) {
+                    const int p = next[factors.uIdx[idx]]++;
+                    uColRow[p] = i;
+                    uColPos[p] = idx;
+                }
+            }
+            isComputed = false;
+        }
+
+        aL.assign(factors.lIdx.size(), TNum(0));
+        aU.assign(factors.uIdx.size(), TNum(0));
+        aDiag.assign(n, TNum(0));
+        std::vector<TNum> w(n, TNum(0));
+        for (int i = 0; i < n; ++i) {
+            for (int idx = A.rowPtr[i]; idx < A.rowPtr[i + 1]; ++idx) w[A.colIdx[idx]] = A.vals[idx];
+            for (int idx = factors.lPtr[i]; idx < factors.lPtr[i + 1]; ++idx) aL[idx] = w[factors.lIdx[idx]];
+            for (int idx = factors.uPtr[i]; idx < factors.uPtr[i + 1]; ++idx) aU[idx] = w[factors.uIdx[idx]];
+            aDiag[i] = w[i];
+            for (int idx = A.rowPtr[i]; idx < A.rowPtr[i + 1]; ++idx) w[A.colIdx[idx]] = TNum(0);
+            if (aDiag[i] == TNum(0)) {
+                throw std::runtime_error("ParILU requires a nonzero diagonal");
+            }
+        }
+    }
+
+    void finish() {
+        for (int i = 0; i < n; ++i) {
+            if (uDiag[i] == TNum(0) || !std::isfinite(uDiag[i])) {
+                throw std::runtime_error("ParILU sweeps produced a zero or non-finite pivot");
+            }
+            factors.uDiagInv[i] = TNum(1) / uDiag[i];
+        }
+        isComputed = true;
+    }
+
+    // x = T^(-1) b approximately by `jacobiSolves` iterations x <- D^(-1) (b - T_strict x)
+    void jacobiSolve(const std::vector<int>& ptr, const std::vector<int>& idx, const std::vector<TNum>& val,
+                     const TNum* diagInv, const TNum* b, TNum* x, std::vector<TNum>& work) const {
+        for (int i = 0; i < n; ++i) x[i] = diagInv ? b[i] * diagInv[i] : b[i];
+        work.resize(n);
+        for (int it = 0; it < jacobiSolves; ++it) {
+            TNum* w = work.data();
+            #pragma omp parallel for schedule(static)
+            for (int i = 0; i < n; ++i) {
+                TNum sum = b[i];
+                for (int k = ptr[i]; k < ptr[i + 1]; ++k) sum -= val[k] * x[idx[k]];
+                w[i] = diagInv ? sum * diagInv[i] : sum;
+            }
+            std::copy(work.begin(), work.end(), x);
+        }
+    }
+
+public:
+    /**
+     * @param sweeps Fixed-point sweeps per compute or update
+     * @param fillLevel Level of fill of the pattern, as in ILUPreconditioner
+     */
+    explicit ParILUPreconditioner(int sweeps = 3, int fillLevel = 0) : sweeps(sweeps), fillLevel(fillLevel) {
+        if (sweeps < 1 || fillLevel < 0) {
+            throw std::invalid_argument("ParILU requires at least one sweep and a non-negative fill level");
+        }
+    }
+
+    void setSweeps(int count) {
+        if (count < 1) {
+            throw std::invalid_argument("ParILU requires at least one sweep");
+        }
+        sweeps = count;
+    }
+
+    // Jacobi iterations per triangular solve in apply; 0 selects the exact solves
+    void setJacobiSolves(int iterations) {
+        if (iterations < 0) {
+            throw std::invalid_argument("Number of Jacobi iterations must be non-negative");
+        }
+        jacobiSolves = iterations;
+    }
+
+    // Synchronous sweeps give the same factors for any thread count; asynchronous (default) converge faster
+    void setAsynchronous(bool enable) { asynchronous = enable; }
+
+    void setTriangularSchedule(sptrsv::Schedule schedule) { factors.schedule = schedule; }
+
+    // Sweeps from the standard initial guess L = strict lower part of A scaled by its diagonal, U = upper part of A
+    void compute(const MatrixType& Matrix) {
+        if (Matrix.getRows() != Matrix.getCols()) {
+            throw std::invalid_argument("Matrix must be square for ParILU factorization");
+        }
+        setup(csr::fromMatrix<TNum>(Matrix));
+        uDiag = aDiag;
+        for (int i = 0; i < n; ++i) {
+            for (int idx = factors.lPtr[i]; idx < factors.lPtr[i + 1]; ++idx) {
+                factors.lVal[idx] = aL[idx] / aDiag[factors.lIdx[idx]];
+            }
+        }
+        factors.uVal = aU;
+        for (int s = 0; s < sweeps; ++s) sweep();
+        finish();
+    }
+
+    // Sweeps starting from the current factors; falls back to compute when the pattern changed
+    void update(const MatrixType& Matrix) {
+        if (!isComputed || Matrix.getRows() != n) {
+            compute(Matrix);
+            return;
+        }
+        setup(csr::fromMatrix<TNum>(Matrix));
+        if (!isComputed) {
+            compute(Matrix);
+            return;
+        }
+        for (int s = 0; s < sweeps; ++s) sweep();
+        finish();
+    }
+
+    /**
+     * @brief ||A - L U|| in the Frobenius norm over the pattern, relative to ||A|| there
+     *
+     * Zero exactly when the factors are the ILU(k) factors of A.
+     */
+    TNum getResidual() const {
+        TNum res = TNum(0), ref = TNum(0);
+        for (int i = 0; i < n; ++i) {
+            for (int idx = factors.lPtr[i]; idx < factors.lPtr[i + 1]; ++idx) {
+                const int j = factors.lIdx[idx];
+                const TNum r = aL[idx] - rowColumnProduct(i, j, j, factors.lVal.data(), factors.uVal.data()) - factors.lVal[idx] * uDiag[j];
+                res += r * r;
+                ref += aL[idx] * aL[idx];
+            }
+            const TNum d = aDiag[i] - rowColumnProduct(i, i, i, factors.lVal.data(), factors.uVal.data()) - uDiag[i];
+            res += d * d;
+            ref += aDiag[i] * aDiag[i];
+            for (int idx = factors.uPtr[i]; idx < factors.uPtr[i + 1]; ++idx) {
+                const TNum r = aU[idx] - rowColumnProduct(i, factors.uIdx[idx], i, factors.lVal.data(), factors.uVal.data()) - factors.uVal[idx];
+                res += r * r;
+                ref += aU[idx] * aU[idx];
+            }
+        }
+        return ref > TNum(0) ? std::sqrt(res / ref) : std::sqrt(res);
+    }
+
+    VectorObj<TNum> solve(const VectorObj<TNum>& b) const {
+        if (!isComputed) {
+            throw std::runtime_error("ParILU factorization not computed");
+        }
+        if (static_cast<int>(b.size()) != n) {
+            throw std::invalid_argument("Vector size does not match matrix size");
+        }
+        if (jacobiSolves == 0) {
+            VectorObj<TNum> x = b;
+            factors.solveInPlace(x.element());
+            return x;
+        }
+        std::vector<TNum> work;
+        VectorObj<TNum> y(n), x(n);
+        jacobiSolve(factors.lPtr, factors.lIdx, factors.lVal, nullptr, b.element(), y.element(), work);
+        jacobiSolve(factors.uPtr, factors.uIdx, factors.uVal, factors.uDiagInv.data(), y.element(), x.element(), work);
+        return x;
+    }
+
+    VectorObj<TNum> apply(const VectorObj<TNum>& r) override {
+        return solve(r);
+    }
+
+    const ilu::Factors<TNum>& getFactors() const { return factors; }
+};
+
+#endif // PARILU_HPP
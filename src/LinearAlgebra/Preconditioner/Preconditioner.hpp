@@ -0,0 +1,39 @@
+#ifndef PRECONDITIONER_HPP
+#define PRECONDITIONER_HPP
+
+#include <functional>
+#include <utility>
+#include "../../Obj/VectorObj.hpp"
+
+/**
+ * @brief Common interface of preconditioners: apply returns z ~= M^(-1) r
+ *
+ * apply is not required to be a fixed linear operator. A multigrid cycle, an
+ * inner Krylov solve with a loose tolerance or a nonlinear smoother may all be
+ * used, as long as the outer solver is flexible (see FGMRES).
+ */
+template <typename TNum, typename VectorType = VectorObj<TNum>>
+class Preconditioner {
+public:
+    virtual ~Preconditioner() = default;
+
+    virtual VectorType apply(const VectorType& r) = 0;
+};
+
+/**
+ * @brief Preconditioner defined by a callable, e.g. a lambda running an inner solver
+ */
+template <typename TNum, typename VectorType = VectorObj<TNum>>
+class FunctionPreconditioner : public Preconditioner<TNum, VectorType> {
+private:
+    std::function<VectorType(const VectorType&)> func;
+
+public:
+    explicit FunctionPreconditioner(std::function<VectorType(const VectorType&)> f) : func(std::move(f)) {}
+
+    VectorType apply(const VectorType& r) override {
+        return func(r);
+    }
+};
+
+#endif // PRECONDITIONER_HPP
@@ -0,0 +1,509 @@
+#ifndef SMOOTHED_AGGREGATION_HPP
+#define SMOOTHED_AGGREGATION_HPP
+
+#include <vector>
+#include <cmath>
+#include <memory>
+#include <algorithm>
+#include <stdexcept>
+#include "../../Obj/SparseObj.hpp"
+#include "../../Obj/DenseObj.hpp"
+#include "../../Obj/VectorObj.hpp"
+#include "../../Obj/BatchedDenseObj.hpp"
+#include "../Factorized/batched.hpp"
+#include "../Krylov/KrylovSubspace.hpp"
+#include "../Solver/Chebyshev.hpp"
+#include "CSR.hpp"
+#include "MultiGrid.hpp"
+#include "Preconditioner.hpp"
+
+/**
+ * @namespace sa
+ * @brief Near-nullspace helpers for smoothed-aggregation AMG
+ */
+namespace sa {
+    /**
+     * @brief Rigid-body modes of an elasticity problem as near-nullspace vectors
+     * @param coords Nodal coordinates, interleaved (x0, y0[, z0], x1, ...), one unknown per coordinate
+     * @param dim Spatial dimension, 2 or 3
+     * @return n x 3 (2D: two translations, one rotation) or n x 6 (3D) matrix
+     */
+    template <typename TNum>
+    DenseObj<TNum> rigidBodyModes(const std::vector<TNum>& coords, int dim) {
+        if ((dim != 2 && dim != 3) || coords.size() % dim != 0) {
+            throw std::invalid_argument("Rigid-body modes need 2D or 3D interleaved coordinates");
+        }
+        const int n = static_cast<int>(coords.size());
+        const int nodes = n / dim;
+        DenseObj<TNum> B(n, dim == 2 ? 3 : 6);
+        for (int k = 0; k < nodes; ++k) {
+            const TNum* c = coords.data() + static_cast<size_t>(k) * dim;
+            const int i = k * dim;
+            for (int d = 0; d < dim; ++d) B(i + d, d) = TNum(1);
+            if (dim == 2) {
+                B(i, 2) = -c[1];
+                B(i + 1, 2) = c[0];
+            } else {
+                // Rotations about the x, y and z axes
+                B(i + 1, 3) = -c[2];
+                B(i + 2, 3) = c[1];
+                B(i, 4) = c[2];
+                B(i + 2, 4) = -c[0];
+                B(i, 5) = -c[1];
+                B(i + 1, 5) = c[0];
+            }
+        }
+        return B;
+    }
+} // namespace sa
+
+/**
+ * @brief Smoothed-aggregation algebraic multigrid (Vanek, Mandel, Brezina)
+ *
+ * Each level groups the unknowns into nodes of blockSize unknowns and keeps the
+ * node pairs whose block norms satisfy ||A_IJ|| >= theta sqrt(||A_II|| ||A_JJ||).
+ * Strongly connected nodes are aggregated greedily. The tentative prolongator
+ * T restricts the near-nullspace B to every aggregate and orthonormalizes it
+ * there by QR; the R factors become the coarse near-nullspace. T is smoothed
+ * by one damped Jacobi step with the filtered matrix, where the weak
+ * connections are lumped into the diagonal:
+ *
+ *     P = (I - omega D_F^(-1) A_F) T,   omega = 4 / (3 rho(D_F^(-1) A_F))
+ *
+ * The coarse operator is the Galerkin product P^T A P. Without a user
+ * near-nullspace the blockSize constant vectors (translations) are used. For
+ * elasticity, pass the rigid-body modes (sa::rigidBodyModes), which also gives
+ * the next level blocks of 3 (2D) or 6 (3D) unknowns. The coarsest level is
+ * solved by dense LU when it is nonsingular. setup builds everything once;
+ * vcycle and apply only use the stored hierarchy.
+ */
+template <typename TNum, typename VectorType = VectorObj<TNum>>
+class SmoothedAggregationAMG : public Preconditioner<TNum, VectorType>,
+                               public AMGLevels<TNum, VectorType, csr::Matrix<TNum>> {
+private:
+    using Base = AMGLevels<TNum, VectorType, csr::Matrix<TNum>>;
+    using typename Base::Level;
+    using Base::hierarchy;
+    using Base::setupSmoothers;
+
+    TNum theta;
+    int blockSize = 1;
+    DenseObj<TNum> nullspace;
+    bool hasNullspace = false;
+    int maxLevels = 10;
+    int maxCoarseSize = 64;
+    int smoothingSteps = 1;
+    bool smoothProlongator = true;
+    BatchedDenseObj<TNum> coarseLU;
+    std::vector<int> coarsePivots;
+    bool directCoarse = false;
+
+    void smooth(const Level& level, const VectorType& b, VectorType& x) { Base::smooth(level, b, x, smoothingSteps); }
+
+    // Strongly connected node pairs as a symmetric adjacency list (without I itself)
+    void strength(const csr::Matrix<TNum>& A, int bs, std::vector<int>& ptr, std::vector<int>& adj) const {
+        const int nodes = A.rows / bs;
+        std::vector<TNum> norm2(nodes, TNum(0)), diag(nodes, TNum(0));
+        std::vector<int> marker(nodes, -1), touched;
+        std::vector<std::vector<std::pair<int, TNum>>> blocks(nodes);
+        for (int I = 0; I < nodes; ++I) {
+            touched.clear();
+            for (int i = I * bs; i < (I + 1) * bs; ++i) {
+                for (int p = A.rowPtr[i]; p < A.rowPtr[i + 1]; ++p) {
+                    const int J = A.colIdx[p] / bs;
+                    if (marker[J] != I) {
+                        marker[J] = I;
+                        norm2[J] = TNum(0);
+                        touched.push_back(J);
+                    }
+                    norm2[J] += A.vals[p] * A.vals[p];
+                }
+            }
+            for (int J : touched) {
+                if (J == I) diag[I] = std::sqrt(norm2[J]);
+                else blocks[I].emplace_back(J, std::sqrt(norm2[J]));
+            }
+        }
+        std::vector<std::vector<int>> strong(nodes);
+        for (int I = 0; I < nodes; ++I) {
+            for (const auto& entry : blocks[I]) {
+                const int J = entry.first;
+                if (entry.second > TNum(0) && entry.second >= theta * std::sqrt(diag[I] * diag[J])) {
+                    strong[I].push_back(J);
+                    strong[J].push_back(I);
+                }
+            }
+        }
+        ptr.assign(nodes + 1, 0);
+        adj.clear();
+        for (int I = 0; I < nodes; ++I) {
+            std::sort(strong[I].begin(), strong[I].end());
+            strong[I].erase(std::unique(strong[I].begin(), strong[I].end()), strong[I].end());
+            adj.insert(adj.end(), strong[I].begin(), strong[I].end());
+            ptr[I + 1] = static_cast<int>(adj.size());
+        }
+    }
+
+    // Greedy three-phase aggregation; isolated nodes stay unaggregated (-1)
+    static int aggregate(const std::vector<int>& ptr, const std::vector<int>& adj, std::vector<int>& agg) {
+        const int nodes = static_cast<int>(ptr.size()) - 1;
+        agg.assign(nodes, -1);
+        int count = 0;
+        // Phase 1: a node whose strong neighbourhood is still free becomes an aggregate with it
+        for (int I = 0; I < nodes; ++I) {
+            if (agg[I] != -1 || ptr[I] == ptr[I + 1]) continue;
+            bool free = true;
+            for (int p = ptr[I]; p < ptr[I + 1] && free; ++p) free = agg[adj[p]] == -1;
+            if (!free) continue;
+            agg[I] = count;
+            for (int p = ptr[I]; p < ptr[I + 1]; ++p) agg[adj[p]] = count;
+            ++count;
+        }
+        // Phase 2: remaining nodes join an aggregate of a strong neighbour from phase 1
+        const std::vector<int> phase1 = agg;
+        for (int I = 0; I < nodes; ++I) {
+            if (agg[I] != -1) continue;
+            for (int p = ptr[I]; p < ptr[I + 1]; ++p) {
+                if (phase1[adj[p]] != -1) {
+                    agg[I] = phase1[adj[p]];
+                    break;
+                }
+            }
+        }
+        // Phase 3: aggregates of whatever is left, with its free strong neighbours
+        for (int I = 0; I < nodes; ++I) {
+            if (agg[I] != -1 || ptr[I] == ptr[I + 1]) continue;
+            agg[I] = count;
+            for (int p = ptr[I]; p < ptr[I + 1]; ++p) {
+                if (agg[adj[p]] == -1) agg[adj[p]] = count;
+            }
+            ++count;
+        }
+        return count;
+    }
+
+    // Tentative prolongator T (n x count*k) and the coarse near-nullspace Bc (count*k x k, row-major)
+    static csr::Matrix<TNum> tentative(const std::vector<int>& agg, int count, int bs, const std::vector<TNum>& B, int k,
+                                      std::vector<TNum>& Bc) {
+        const int nodes = static_cast<int>(agg.size());
+        const int n = nodes * bs;
+        std::vector<std::vector<int>> members(count);
+        for (int I = 0; I < nodes; ++I) {
+            if (agg[I] >= 0) members[agg[I]].push_back(I);
+        }
+        Bc.assign(static_cast<size_t>(count) * k * k, TNum(0));
+        // Q entries of every unknown, to be laid out by rows afterwards
+        std::vector<TNum> rowVals(static_cast<size_t>(n) * k, TNum(0));
+
+        #pragma omp parallel
+        {
+            std::vector<TNum> local, Q, tau(k);
+            #pragma omp for schedule(dynamic, 16)
+            for (int a = 0; a < count; ++a) {
+                const int m = static_cast<int>(members[a].size()) * bs;
+                const int mp = std::max(m, k);  // Zero rows pad aggregates smaller than the near-nullspace
+                local.assign(static_cast<size_t>(mp) * k, TNum(0));
+                for (int r = 0; r < m; ++r) {
+                    const int i = members[a][r / bs] * bs + r % bs;
+                    for (int c = 0; c < k; ++c) local[r + static_cast<size_t>(c) * mp] = B[static_cast<size_t>(i) * k + c];
+                }
+                Krylov::householderQR(local.data(), mp, k, mp, tau.data());
+                for (int r = 0; r < k; ++r) {
+                    for (int c = r; c < k; ++c) {
+                        Bc[(static_cast<size_t>(a) * k + r) * k + c] = local[r + static_cast<size_t>(c) * mp];
+                    }
+                }
+                Q.assign(static_cast<size_t>(mp) * k, TNum(0));
+                Krylov::householderQ(local.data(), mp, k, mp, tau.data(), Q.data(), mp);
+                for (int r = 0; r < m; ++r) {
+                    const int i = members[a][r / bs] * bs + r % bs;
+                    for (int c = 0; c < k; ++c) rowVals[static_cast<size_t>(i) * k + c] = Q[r + static_cast<size_t>(c) * mp];
+                }
+            }
+        }
+
+        csr::Matrix<TNum> T;
+        T.rows = n;
+        T.cols = count * k;
+        T.rowPtr.assign(n + 1, 0);
+        for (int i = 0; i < n; ++i) {
+            const int a = agg[i / bs];
+            if (a >= 0) {
+                for (int c = 0; c < k; ++c) {
+                    T.colIdx.push_back(a * k + c);
+                    T.vals.push_back(rowVals[static_cast<size_t>(i) * k + c]);
+                }
+            }
+            T.rowPtr[i + 1] = static_cast<int>(T.colIdx.size());
+        }
+        return T;
+    }
+
+    // P = (I - omega D_F^(-1) A_F) T with the weak connections of A lumped into the diagonal
+    csr::Matrix<TNum> smoothProlongatorFrom(const csr::Matrix<TNum>& A, int bs, const std::vector<int>& ptr,
+                                           const std::vector<int>& adj, const csr::Matrix<TNum>& T) const {
+        const int n = A.rows;
+        csr::Matrix<TNum> AF;
+        AF.rows = AF.cols = n;
+        AF.rowPtr.assign(n + 1, 0);
+        std::vector<TNum> invDiag(n, TNum(0));
+        std::vector<int> strongMark(ptr.size() - 1, -1);
+        for (int i = 0; i < n; ++i) {
+            const int I = i / bs;
+            for (int p = ptr[I]; p < ptr[I + 1]; ++p) strongMark[adj[p]] = i;
+            strongMark[I] = i;
+            TNum diag = TNum(0), lumped = TNum(0);
+            for (int p = A.rowPtr[i]; p < A.rowPtr[i + 1]; ++p) {
+                const int j = A.colIdx[p];
+                if (j == i) {
+                    diag += A.vals[p];
+                } else if (strongMark[j / bs] == i) {
+                    AF.colIdx.push_back(j);
+                    AF.vals.push_back(A.vals[p]);
+                } else {
+                    lumped += A.vals[p];
+                }
+            }
+            AF.colIdx.push_back(i);
+            AF.vals.push_back(diag + lumped);
+            AF.rowPtr[i + 1] = static_cast<int>(AF.colIdx.size());
+            invDiag[i] = diag + lumped != TNum(0) ? TNum(1) / (diag + lumped) : TNum(0);
+        }
+
+        // rho(D_F^(-1) A_F) by power iteration
+        VectorObj<TNum> v = chebyshev::detail::startVector<TNum>(n), w(n);
+        TNum rho = TNum(0);
+        for (int it = 0; it < 15; ++it) {
+            const TNum norm = static_cast<TNum>(v.L2norm());
+            if (norm == TNum(0)) break;
+            for (int i = 0; i < n; ++i) v[i] /= norm;
+            csr::spmv(AF, v.element(), w.element());
+            rho = TNum(0);
+            for (int i = 0; i < n; ++i) {
+                w[i] *= invDiag[i];
+                rho += w[i] * w[i];
+            }
+            rho = std::sqrt(rho);
+            std::swap(v, w);
+        }
+        const TNum omega = rho > TNum(0) ? TNum(4) / (TNum(3) * rho) : TNum(0);
+
+        // P = T - omega D_F^(-1) (A_F T); both patterns are sorted, so the rows are merged
+        const csr::Matrix<TNum> AT = csr::multiply(AF, T);
+        csr::Matrix<TNum> P;
+        P.rows = n;
+        P.cols = T.cols;
+        P.rowPtr.assign(n + 1, 0);
+        for (int i = 0; i < n; ++i) {
+            int p = T.rowPtr[i], q = AT.rowPtr[i];
+            const TNum scale = -omega * invDiag[i];
+            while (p < T.rowPtr[i + 1] || q < AT.rowPtr[i + 1]) {
+                const int jp = p < T.rowPtr[i + 1] ? T.colIdx[p] : T.cols;
+                const int jq = q < AT.rowPtr[i + 1] ? AT.colIdx[q] : T.cols;
+                TNum value = TNum(0);
+                const int j = std::min(jp, jq);
+                if (jp == j) value += T.vals[p++];
+                if (jq == j) value += scale * AT.vals[q++];
+                P.colIdx.push_back(j);
+                P.vals.push_back(value);
+            }
+            P.rowPtr[i + 1] = static_cast<int>(P.colIdx.size());
+        }
+        return P;
+    }
+
+    // Rows of a coarse operator that are entirely zero (unused coarse unknowns) get a unit diagonal
+    static void fixEmptyRows(csr::Matrix<TNum>& A) {
+        csr::Matrix<TNum> fixed;
+        fixed.rows = A.rows;
+        fixed.cols = A.cols;
+        fixed.rowPtr.assign(A.rows + 1, 0);
+        for (int i = 0; i < A.rows; ++i) {
+            bool empty = true;
+            for (int p = A.rowPtr[i]; p < A.rowPtr[i + 1]; ++p) {
+                if (A.vals[p] != TNum(0)) {
+                    empty = false;
+                    fixed.colIdx.push_back(A.colIdx[p]);
+                    fixed.vals.push_back(A.vals[p]);
+                }
+            }
+            if (empty) {
+                fixed.colIdx.push_back(i);
+                fixed.vals.push_back(TNum(1));
+            }
+            fixed.rowPtr[i + 1] = static_cast<int>(fixed.colIdx.size());
+        }
+        A = std::move(fixed);
+    }
+
+    void cycle(size_t l, const VectorType& b, VectorType& x) {
+        Level& level = *hierarchy[l];
+        if (l + 1 == hierarchy.size()) {
+            if (directCoarse) {
+                BatchedDenseObj<TNum> rhs(static_cast<int>(b.size()), 1, 1);
+                for (size_t i = 0; i < b.size(); ++i) rhs.lane(static_cast<int>(i), 0)[0] = b[i];
+                batched::LUSolve(coarseLU, coarsePivots, rhs);
+                for (size_t i = 0; i < b.size(); ++i) x[i] = rhs.lane(static_cast<int>(i), 0)[0];
+            } else {
+                smooth(level, b, x);
+            }
+            return;
+        }
+
+        smooth(level, b, x);
+        const VectorType r = b - level.A * x;
+        VectorType r_c(level.R.rows), x_c(level.R.rows, TNum(0));
+        csr::spmv(level.R, r.element(), r_c.element());
+        cycle(l + 1, r_c, x_c);
+        VectorType correction(level.P.rows);
+        csr::spmv(level.P, x_c.element(), correction.element());
+        x = x + correction;
+        smooth(level, b, x);
+    }
+
+public:
+    /**
+     * @param theta Strength-of-connection threshold; 0 keeps every connection
+     */
+    explicit SmoothedAggregationAMG(TNum theta = TNum(0.08)) : Base(AMGSmoother::Chebyshev), theta(theta) {
+        if (theta < TNum(0)) {
+            throw std::invalid_argument("Strength threshold must be non-negative");
+        }
+    }
+
+    // Unknowns per node on the finest level, e.g. the spatial dimension for elasticity
+    void setBlockSize(int size) {
+        if (size < 1) {
+            throw std::invalid_argument("Block size must be positive");
+        }
+        blockSize = size;
+    }
+
+    // Near-nullspace vectors as the columns of B (n x k), with blockSize unknowns per node
+    void setNearNullspace(const DenseObj<TNum>& B, int nodeBlockSize) {
+        setBlockSize(nodeBlockSize);
+        if (B.getCols() < 1) {
+            throw std::invalid_argument("Near-nullspace needs at least one vector");
+        }
+        nullspace = B;
+        hasNullspace = true;
+    }
+
+    void setMaxLevels(int levels) {
+        if (levels < 1) {
+            throw std::invalid_argument("AMG needs at least one level");
+        }
+        maxLevels = levels;
+    }
+
+    // Coarsening stops once a level has at most this many unknowns
+    void setMaxCoarseSize(int size) {
+        if (size < 1) {
+            throw std::invalid_argument("Coarse size must be positive");
+        }
+        maxCoarseSize = size;
+    }
+
+    void setSmoothingSteps(int steps) {
+        if (steps < 0) {
+            throw std::invalid_argument("Number of smoothing steps must be non-negative");
+        }
+        smoothingSteps = steps;
+    }
+
+    // false keeps the tentative prolongator (plain aggregation AMG)
+    void setProlongatorSmoothing(bool enable) { smoothProlongator = enable; }
+
+    void setup(const SparseMatrixCSC<TNum>& A) {
+        const int n = A.getRows();
+        if (n != A.getCols()) {
+            throw std::invalid_argument("AMG requires a square matrix");
+        }
+        if (n % blockSize != 0) {
+            throw std::invalid_argument("Matrix size is not a multiple of the block size");
+        }
+        if (hasNullspace && nullspace.getRows() != n) {
+            throw std::invalid_argument("Near-nullspace does not match the matrix size");
+        }
+
+        // Near-nullspace row-major, n x k
+        int k = hasNullspace ? nullspace.getCols() : blockSize;
+        std::vector<TNum> B(static_cast<size_t>(n) * k, TNum(0));
+        for (int i = 0; i < n; ++i) {
+            for (int c = 0; c < k; ++c) {
+                B[static_cast<size_t>(i) * k + c] = hasNullspace ? nullspace(i, c) : TNum(i % blockSize == c ? 1 : 0);
+            }
+        }
+
+        hierarchy.clear();
+        directCoarse = false;
+        csr::Matrix<TNum> current = csr::fromMatrix<TNum>(A);
+        int bs = blockSize;
+        std::vector<int> ptr, adj, agg;
+        std::vector<TNum> Bc;
+        while (true) {
+            std::unique_ptr<Level> level(new Level());
+            const bool last = static_cast<int>(hierarchy.size()) + 1 >= maxLevels || current.rows <= maxCoarseSize;
+            int count = 0;
+            if (!last) {
+                strength(current, bs, ptr, adj);
+                count = aggregate(ptr, adj, agg);
+            }
+            // Stop when nothing aggregates or the level would not shrink
+            if (last || count == 0 || count * k >= current.rows) {
+                level->A = csr::toCSC(current);
+                hierarchy.push_back(std::move(level));
+                break;
+            }
+
+            const csr::Matrix<TNum> T = tentative(agg, count, bs, B, k, Bc);
+            level->P = smoothProlongator ? smoothProlongatorFrom(current, bs, ptr, adj, T) : T;
+            level->R = csr::transpose(level->P);
+            csr::Matrix<TNum> coarse = csr::multiply(level->R, csr::multiply(current, level->P));
+            fixEmptyRows(coarse);
+
+            level->A = csr::toCSC(current);
+            hierarchy.push_back(std::move(level));
+            current = std::move(coarse);
+            bs = k;
+            B.swap(Bc);
+        }
+
+        setupSmoothers();
+
+        // Dense LU on the coarsest level; a singular coarse operator is smoothed instead
+        const csr::Matrix<TNum>& Ac = current;
+        if (Ac.rows <= std::max(maxCoarseSize, 1024)) {
+            coarseLU = BatchedDenseObj<TNum>(Ac.rows, Ac.rows, 1);
+            for (int i = 0; i < Ac.rows; ++i) {
+                for (int p = Ac.rowPtr[i]; p < Ac.rowPtr[i + 1]; ++p) coarseLU.lane(i, Ac.colIdx[p])[0] += Ac.vals[p];
+            }
+            try {
+                batched::LU(coarseLU, coarsePivots);
+                directCoarse = true;
+            } catch (const std::runtime_error&) {
+                directCoarse = false;
+            }
+        }
+    }
+
+    // One V-cycle on A x = b with the stored hierarchy
+    void vcycle(const VectorType& b, VectorType& x) {
+        if (hierarchy.empty()) {
+            throw std::runtime_error("AMG hierarchy not set up");
+        }
+        if (static_cast<int>(b.size()) != hierarchy.front()->A.getRows() || x.size() != b.size()) {
+            throw std::invalid_argument("Vector size does not match matrix size");
+        }
+        cycle(0, b, x);
+    }
+
+    // One V-cycle from a zero initial guess; symmetric for symmetric A with the Chebyshev or Jacobi smoothers
+    VectorType apply(const VectorType& r) override {
+        VectorType z(r.size(), TNum(0));
+        vcycle(r, z);
+        return z;
+    }
+};
+
+#endif // SMOOTHED_AGGREGATION_HPP
@@ -0,0 +1,127 @@
+#ifndef TRIANGULAR_SOLVE_HPP
+#define TRIANGULAR_SOLVE_HPP
+
+#include <vector>
+#include <algorithm>
+#include <thread>
+
+/**
+ * @brief Sparse triangular solves on CSR rows with cached dependency analysis
+ *
+ * A row stores its off-diagonal entries (ptr/idx/val); the diagonal is either
+ * implicit one or given as an inverse. The analysis groups rows into level sets
+ * (wavefronts): a row of level l only depends on rows of lower levels, so all
+ * rows of a level can be solved in parallel with one barrier per level. The
+ * synchronization-free variant needs no barriers: each row spins on per-row
+ * completion flags of the rows it reads. Both produce the same result as the
+ * sequential substitution.
+ */
+namespace sptrsv {
+    enum class Schedule {
+        Sequential,  // Plain substitution in row order
+        LevelSet,    // One parallel loop per wavefront; sequential when wavefronts are narrow
+        SyncFree     // Rows in parallel, waiting on completion flags of their dependencies
+    };
+
+    // Wavefronts of one triangular factor; only depends on the sparsity pattern
+    struct LevelSets {
+        std::vector<int> levelPtr;  // Rows of level l are rows[levelPtr[l] .. levelPtr[l + 1])
+        std::vector<int> rows;
+
+        int numLevels() const { return levelPtr.empty() ? 0 : static_cast<int>(levelPtr.size()) - 1; }
+    };
+
+    // Average number of rows per level below which the level-set solve stays sequential
+    constexpr int minRowsPerLevel = 64;
+
+    /**
+     * @brief Level sets of a triangular pattern
+     * @param lower true if rows depend on smaller indices (forward solve), false for backward
+     */
+    inline LevelSets analyze(int n, const std::vector<int>& ptr, const std::vector<int>& idx, bool lower) {
+        std::vector<int> level(n, 0);
+        int numLevels = n > 0 ? 1 : 0;
+        for (int r = 0; r < n; ++r) {
+            const int i = lower ? r : n - 1 - r;
+            int lev = 0;
+            for (int k = ptr[i]; k < ptr[i + 1]; ++k) lev = std::max(lev, level[idx[k]] + 1);
+            level[i] = lev;
+            numLevels = std::max(numLevels, lev + 1);
+        }
+
+        // Counting sort of the rows by level, in solve order within each level
+        LevelSets sets;
+        sets.levelPtr.assign(numLevels + 1, 0);
+        for (int i = 0; i < n; ++i) ++sets.levelPtr[level[i] + 1];
+        for (int l = 0; l < numLevels; ++l) sets.levelPtr[l + 1] += sets.levelPtr[l];
+        sets.rows.resize(n);
+        std::vector<int> next(sets.levelPtr.begin(), sets.levelPtr.end() - 1);
+        for (int r = 0; r < n; ++r) {
+            const int i = lower ? r : n - 1 - r;
+            sets.rows[next[level[i]]++] = i;
+        }
+        return sets;
+    }
+
+    /**
+     * @brief Solve in place: x_i = (x_i - sum_k val_k x_idx_k) * diagInv_i for every row
+     * @param diagInv Inverted diagonal, or nullptr for a unit diagonal
+     * @param lower Direction of the dependencies, as passed to analyze
+     */
+    template <typename TNum>
+    void solve(Schedule schedule, const LevelSets& sets, int n, const int* ptr, const int* idx,
+               const TNum* val, const TNum* diagInv, TNum* x, bool lower) {
+        auto row = [&](int i) {
+            TNum sum = x[i];
+            for (int k = ptr[i]; k < ptr[i + 1]; ++k) sum -= val[k] * x[idx[k]];
+            x[i] = diagInv ? sum * diagInv[i] : sum;
+        };
+
+        const int numLevels = sets.numLevels();
+        if (schedule == Schedule::LevelSet && numLevels > 0 && n / numLevels >= minRowsPerLevel) {
+            const int* rows = sets.rows.data();
+            const int* levelPtr = sets.levelPtr.data();
+            #pragma omp parallel
+            for (int l = 0; l < numLevels; ++l) {
+                #pragma omp for schedule(static)
+                for (int r = levelPtr[l]; r < levelPtr[l + 1]; ++r) row(rows[r]);
+            }
+            return;
+        }
+
+        if (schedule == Schedule::SyncFree && n > 0) {
+            // Each thread takes its rows in solve order, so the first unfinished row
+            // overall always has its dependencies done and the spin waits terminate
+            std::vector<int> done(n, 0);
+            int* flags = done.data();
+            #pragma omp parallel for schedule(static, 32)
+            for (int r = 0; r < n; ++r) {
+                const int i = lower ? r : n - 1 - r;
+                TNum sum = x[i];
+                for (int k = ptr[i]; k < ptr[i + 1]; ++k) {
+                    const int j = idx[k];
+                    int ready = 0;
+                    for (int spins = 0; !ready; ++spins) {
+                        #pragma omp atomic read seq_cst
+                        ready = flags[j];
+                        // Give the core away when threads outnumber cores
+                        if (!ready && spins >= 64) std::this_thread::yield();
+                    }
+                    sum -= val[k] * x[j];
+                }
+                x[i] = diagInv ? sum * diagInv[i] : sum;
+                #pragma omp atomic write seq_cst
+                flags[i] = 1;
+            }
+            return;
+        }
+
+        if (lower) {
+            for (int i = 0; i < n; ++i) row(i);
+        } else {
+            for (int i = n - 1; i >= 0; --i) row(i);
+        }
+    }
+}
+
+#endif // TRIANGULAR_SOLVE_HPP
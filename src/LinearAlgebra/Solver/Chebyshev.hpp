@@ -0,0 +1,354 @@
+#ifndef CHEBYSHEV_HPP
+#define CHEBYSHEV_HPP
+
+#include <vector>
+#include <cmath>
+#include <complex>
+#include <algorithm>
+#include <stdexcept>
+#include "../../Obj/SparseObj.hpp"
+#include "../../Obj/VectorObj.hpp"
+#include "../Factorized/basic.hpp"
+#include "../Krylov/KrylovSubspace.hpp"
+#include "../Preconditioner/Preconditioner.hpp"
+
+// Interval [lambdaMin, lambdaMax] assumed to contain the spectrum of D^(-1) A
+template <typename TNum>
+struct SpectralInterval {
+    TNum lambdaMin;
+    TNum lambdaMax;
+};
+
+/**
+ * @namespace chebyshev
+ * @brief Chebyshev semi-iteration for systems whose Jacobi-scaled operator D^(-1) A has a real positive spectrum
+ *
+ * An iteration costs one SpMV, one diagonal scaling and a few axpys. There are
+ * no inner products, so there is nothing to synchronize between threads; the
+ * price is that an interval enclosing the spectrum must be known, which the
+ * estimators below provide from a few power or Lanczos steps.
+ */
+namespace chebyshev {
+
+    // D^(-1) as a vector; throws on a zero diagonal entry
+    template <typename TNum>
+    std::vector<TNum> inverseDiagonal(const SparseMatrixCSC<TNum>& A) {
+        std::vector<TNum> invDiag(A.getRows());
+        for (int i = 0; i < A.getRows(); ++i) {
+            const TNum d = A(i, i);
+            if (d == TNum(0)) {
+                throw std::runtime_error("Chebyshev: zero diagonal entry");
+            }
+            invDiag[i] = TNum(1) / d;
+        }
+        return invDiag;
+    }
+
+    namespace detail {
+        // Deterministic pseudo-random start vector with components in all parts of the spectrum
+        template <typename TNum>
+        VectorObj<TNum> startVector(int n) {
+            VectorObj<TNum> v(n);
+            for (int i = 0; i < n; ++i) {
+                const double h = std::sin(12.9898 * (i + 1)) * 43758.5453;
+                v[i] = static_cast<TNum>(h - std::floor(h) - 0.5);
+            }
+            return v;
+        }
+
+        // D^(-1) A as an operator for basic::powerIter
+        template <typename TNum>
+        struct ScaledOperator {
+            const SparseMatrixCSC<TNum>& A;
+            const std::vector<TNum>& invDiag;
+
+            int getRows() const { return A.getRows(); }
+            int getCols() const { return A.getCols(); }
+            VectorObj<TNum> operator*(const VectorObj<TNum>& v) const {
+                VectorObj<TNum> w = A * v;
+                TNum* wp = w.element();
+                for (int i = 0; i < getRows(); ++i) wp[i] *= invDiag[i];
+                return w;
+            }
+        };
+    } // namespace detail
+
+    /**
+     * @brief Estimate of the largest eigenvalue of D^(-1) A by power iteration
+     *
+     * Converges from below, so callers should enlarge the estimate by a safety
+     * factor before using it as the upper end of an interval.
+     */
+    template <typename TNum>
+    TNum estimateLargestEigenvalue(const SparseMatrixCSC<TNum>& A, int steps = 10) {
+        const std::vector<TNum> invDiag = inverseDiagonal(A);
+        const detail::ScaledOperator<TNum> op{A, invDiag};
+        VectorObj<TNum> v = detail::startVector<TNum>(A.getRows());
+        basic::powerIter(op, v, steps);
+        return (op * v).L2norm();
+    }
+
+    /**
+     * @brief Extreme Ritz values of D^(-1) A from Lanczos on the symmetric D^(-1/2) A D^(-1/2)
+     *
+     * Requires A symmetric with a positive diagonal. The Ritz values lie inside
+     * the spectrum and the extreme ones converge first, so a handful of steps
+     * gives a usable interval.
+     */
+    template <typename TNum>
+    SpectralInterval<TNum> lanczosInterval(const SparseMatrixCSC<TNum>& A, int steps = 20) {
+        const int n = A.getRows();
+        const std::vector<TNum> invDiag = inverseDiagonal(A);
+        std::vector<TNum> scale(n);
+        for (int i = 0; i < n; ++i) {
+            if (invDiag[i] < TNum(0)) {
+                throw std::runtime_error("Chebyshev: Lanczos estimate needs a positive diagonal");
+            }
+            scale[i] = std::sqrt(invDiag[i]);
+        }
+        const int k = std::max(1, std::min(steps, n));
+
+        VectorObj<TNum> v = detail::startVector<TNum>(n), vPrev(n, TNum(0));
+        v.normalize();
+        std::vector<TNum> T(static_cast<size_t>(k) * k, TNum(0));
+        TNum betaPrev = TNum(0);
+        int m = k;
+        for (int j = 0; j < k; ++j) {
+            // w = S v with S = D^(-1/2) A D^(-1/2)
+            VectorObj<TNum> sv(n);
+            for (int i = 0; i < n; ++i) sv[i] = scale[i] * v[i];
+            VectorObj<TNum> w = A * sv;
+            TNum* wp = w.element();
+            for (int i = 0; i < n; ++i) wp[i] *= scale[i];
+
+            const TNum alpha = w * v;
+            w.axpy(-alpha, v);
+            w.axpy(-betaPrev, vPrev);
+            const TNum beta = w.L2norm();
+            T[j + static_cast<size_t>(j) * k] = alpha;
+            if (j + 1 < k) {
+                T[j + 1 + static_cast<size_t>(j) * k] = beta;
+                T[j + static_cast<size_t>(j + 1) * k] = beta;
+            }
+            if (beta <= std::numeric_limits<TNum>::epsilon() * std::abs(alpha)) {
+                m = j + 1;  // Invariant subspace: the Ritz values are exact
+                break;
+            }
+            vPrev = std::move(v);
+            v = w * (TNum(1) / beta);
+            betaPrev = beta;
+        }
+
+        const std::vector<std::complex<TNum>> ritz = Krylov::hessenbergEigenvalues(T.data(), k, m);
+        SpectralInterval<TNum> interval{ritz[0].real(), ritz[0].real()};
+        for (const auto& z : ritz) {
+            interval.lambdaMin = std::min(interval.lambdaMin, z.real());
+            interval.lambdaMax = std::max(interval.lambdaMax, z.real());
+        }
+        return interval;
+    }
+
+    /**
+     * @brief Recurrence state of Chebyshev semi-iteration (Saad, Algorithm 12.1)
+     *
+     * step() advances x by one iteration and keeps the residual r = b - A x up
+     * to date, using one SpMV and no inner products.
+     */
+    template <typename TNum, typename VectorType = VectorObj<TNum>>
+    class Recurrence {
+    private:
+        const SparseMatrixCSC<TNum>& A;
+        const std::vector<TNum>& invDiag;
+        TNum theta, delta, sigma, rho;
+        VectorType d;
+        bool started = false;
+
+    public:
+        Recurrence(const SparseMatrixCSC<TNum>& A, const std::vector<TNum>& invDiag, SpectralInterval<TNum> interval)
+            : A(A), invDiag(invDiag) {
+            if (!(interval.lambdaMax > interval.lambdaMin) || !(interval.lambdaMin > TNum(0))) {
+                throw std::invalid_argument("Chebyshev: need 0 < lambdaMin < lambdaMax");
+            }
+            theta = TNum(0.5) * (interval.lambdaMax + interval.lambdaMin);
+            delta = TNum(0.5) * (interval.lambdaMax - interval.lambdaMin);
+            sigma = theta / delta;
+            rho = TNum(1) / sigma;
+        }
+
+        void step(VectorType& x, VectorType& r) {
+            const int n = static_cast<int>(x.size());
+            const TNum* rp = r.element();
+            if (!started) {
+                // d = D^(-1) r / theta
+                d = VectorType(n);
+                TNum* dp = d.element();
+                for (int i = 0; i < n; ++i) dp[i] = invDiag[i] * rp[i] / theta;
+                started = true;
+            } else {
+                // d = rho_new rho d + 2 rho_new / delta D^(-1) r
+                const TNum rhoNew = TNum(1) / (TNum(2) * sigma - rho);
+                const TNum c1 = rhoNew * rho;
+                const TNum c2 = TNum(2) * rhoNew / delta;
+                TNum* dp = d.element();
+                #pragma omp parallel for schedule(static)
+                for (int i = 0; i < n; ++i) dp[i] = c1 * dp[i] + c2 * invDiag[i] * rp[i];
+                rho = rhoNew;
+            }
+            x.axpy(TNum(1), d);
+            r.axpy(TNum(-1), A * d);
+        }
+    };
+
+    // steps iterations on A x = b from the current x; no inner products
+    template <typename TNum, typename VectorType = VectorObj<TNum>>
+    void iterate(const SparseMatrixCSC<TNum>& A, const std::vector<TNum>& invDiag, const VectorType& b, VectorType& x,
+                 int steps, SpectralInterval<TNum> interval) {
+        Recurrence<TNum, VectorType> recurrence(A, invDiag, interval);
+        VectorType r = b - A * x;
+        for (int k = 0; k < steps; ++k) {
+            recurrence.step(x, r);
+        }
+    }
+
+} // namespace chebyshev
+
+/**
+ * @brief Chebyshev semi-iteration as a solver for Jacobi-scaled SPD-like systems
+ *
+ * The residual norm, the only reduction, is evaluated every checkInterval
+ * iterations. Without an explicit interval one is estimated by Lanczos for
+ * the matrix of every solve, so the solver can be reused across matrices.
+ */
+template <typename TNum, typename VectorType = VectorObj<TNum>>
+class ChebyshevSolver {
+private:
+    bool userInterval = false;  // Set by setInterval; otherwise estimated per solve
+    SpectralInterval<TNum> interval{TNum(0), TNum(0)};
+    int checkInterval = 10;
+    int lanczosSteps = 20;
+    int iterations = 0;
+    TNum residualNorm = TNum(0);
+
+public:
+    ChebyshevSolver() = default;
+
+    void setInterval(TNum lambdaMin, TNum lambdaMax) {
+        interval = {lambdaMin, lambdaMax};
+        userInterval = true;
+    }
+    void setCheckInterval(int steps) { checkInterval = std::max(1, steps); }
+    void setLanczosSteps(int steps) { lanczosSteps = std::max(1, steps); }
+
+    const SpectralInterval<TNum>& getInterval() const { return interval; }
+    int getIterations() const { return iterations; }
+    TNum getResidualNorm() const { return residualNorm; }
+
+    /**
+     * @brief Solve A x = b starting from the initial guess in x
+     * @param tol Tolerance on the relative residual ||b - A x|| / ||b||
+     * @return true if the tolerance was reached
+     */
+    bool solve(const SparseMatrixCSC<TNum>& A, const VectorType& b, VectorType& x, int maxIter, double tol) {
+        const int n = A.getRows();
+        if (A.getCols() != n || static_cast<int>(b.size()) != n || static_cast<int>(x.size()) != n) {
+            throw std::invalid_argument("Matrix dimensions must match vector size");
+        }
+        const std::vector<TNum> invDiag = chebyshev::inverseDiagonal(A);
+        if (!userInterval) {
+            // Ritz values lie inside the spectrum: widen the interval slightly
+            interval = chebyshev::lanczosInterval(A, lanczosSteps);
+            interval.lambdaMin *= TNum(0.95);
+            interval.lambdaMax *= TNum(1.05);
+        }
+
+        iterations = 0;
+        const TNum bNorm = b.L2norm();
+        const TNum target = tol * (bNorm > TNum(0) ? bNorm : TNum(1));
+        VectorType r = b - A * x;
+        residualNorm = r.L2norm();
+        chebyshev::Recurrence<TNum, VectorType> recurrence(A, invDiag, interval);
+        while (residualNorm > target && iterations < maxIter) {
+            recurrence.step(x, r);
+            ++iterations;
+            if (iterations % checkInterval == 0 || iterations == maxIter) {
+                residualNorm = r.L2norm();
+            }
+        }
+        return residualNorm <= target;
+    }
+};
+
+/**
+ * @brief Chebyshev smoother targeting the upper part of the spectrum
+ *
+ * Damps the eigencomponents in [lambdaMax / ratio, lambdaMax] of D^(-1) A, the
+ * high-frequency error multigrid smoothing is responsible for. lambdaMax comes
+ * from a few power steps at construction. Unlike Gauss-Seidel/SOR every step is
+ * a parallel SpMV.
+ */
+template <typename TNum, typename VectorType = VectorObj<TNum>>
+class ChebyshevSmoother {
+private:
+    const SparseMatrixCSC<TNum>& A;
+    std::vector<TNum> invDiag;
+    SpectralInterval<TNum> interval;
+    int degree;
+
+public:
+    ChebyshevSmoother(const SparseMatrixCSC<TNum>& A, int degree = 2, TNum ratio = TNum(30), int powerSteps = 10)
+        : A(A), invDiag(chebyshev::inverseDiagonal(A)), degree(degree) {
+        if (degree < 1 || !(ratio > TNum(1))) {
+            throw std::invalid_argument("Chebyshev smoother needs degree >= 1 and ratio > 1");
+        }
+        const TNum lambdaMax = TNum(1.1) * chebyshev::estimateLargestEigenvalue(A, powerSteps);
+        interval = {lambdaMax / ratio, lambdaMax};
+    }
+
+    const SpectralInterval<TNum>& getInterval() const { return interval; }
+
+    // degree Chebyshev steps on A x = b
+    void smooth(const VectorType& b, VectorType& x) const {
+        chebyshev::iterate(A, invDiag, b, x, degree, interval);
+    }
+};
+
+/**
+ * @brief Polynomial preconditioner z = p(A) r from degree Chebyshev steps on A z = r, z0 = 0
+ *
+ * The polynomial is fixed, so for SPD A the preconditioner is a symmetric
+ * positive definite linear operator and can be used with CG. Applying it costs
+ * degree SpMVs and no inner products.
+ */
+template <typename TNum, typename VectorType = VectorObj<TNum>>
+class ChebyshevPreconditioner : public Preconditioner<TNum, VectorType> {
+private:
+    const SparseMatrixCSC<TNum>& A;
+    std::vector<TNum> invDiag;
+    SpectralInterval<TNum> interval;
+    int degree;
+
+public:
+    ChebyshevPreconditioner(const SparseMatrixCSC<TNum>& A, int degree, SpectralInterval<TNum> interval)
+        : A(A), invDiag(chebyshev::inverseDiagonal(A)), interval(interval), degree(degree) {
+        if (degree < 1) {
+            throw std::invalid_argument("Chebyshev preconditioner needs degree >= 1");
+        }
+    }
+
+    // Interval estimated by Lanczos and widened slightly
+    ChebyshevPreconditioner(const SparseMatrixCSC<TNum>& A, int degree, int lanczosSteps = 20)
+        : ChebyshevPreconditioner(A, degree, chebyshev::lanczosInterval(A, lanczosSteps)) {
+        interval.lambdaMin *= TNum(0.95);
+        interval.lambdaMax *= TNum(1.05);
+    }
+
+    const SpectralInterval<TNum>& getInterval() const { return interval; }
+
+    VectorType apply(const VectorType& r) override {
+        VectorType z(r.size(), TNum(0));
+        chebyshev::iterate(A, invDiag, r, z, degree, interval);
+        return z;
+    }
+};
+
+#endif // CHEBYSHEV_HPP
@@ -2,10 +2,12 @@
 #define ITER_SOLVER_HPP
 
 #include "../../Obj/SparseObj.hpp"
+#include "SolverMonitor.hpp"
 #include <vector>
 #include <cmath>
 #include <stdexcept>
 #include <optional>
+#include <algorithm>
 
 // Gradient Descent Solver Template with Preconditioner and Convergence Check
 template <typename TNum, typename SparseMatrixType, typename VectorType>
@@ -52,16 +54,26 @@ private:
     const VectorType& b;
     int maxIter;
     TNum omega; // Relaxation factor for methods like SOR
+    SolverMonitor* monitor = nullptr;
 
 public:
     SOR(const SparseMatrixType& matrix, const VectorType& rhs, int iterations, TNum relaxation = 1.0)
         : A(matrix), b(rhs), maxIter(iterations), omega(relaxation) {}
 
-    void solve(VectorType& x) {
+    // Record the change norm of every sweep into `m` (not owned); solve performs no I/O
+    void setMonitor(SolverMonitor& m) {
+        monitor = &m;
+    }
+
+    // Returns true if the change between two sweeps dropped below 1e-6. As a
+    // smoother with a fixed sweep count running out is expected, not an error.
+    bool solve(VectorType& x) {
         VectorType xOld(x.size(), 0.0);
         TNum changeNorm = 0.0;
+        if (monitor) monitor->start();
 
-        for (int iter = 0; iter < maxIter; ++iter) {
+        int iter = 0;
+        for (; iter < maxIter; ++iter) {
             for (int i = 0; i < A.getRows(); ++i) {
                 TNum diag = A(i, i);
                 if (std::abs(diag) < 1e-10) {
@@ -82,15 +94,18 @@ public:
 
             // Check for convergence based on the change in solution
             changeNorm = (x - xOld).L2norm();
+            if (monitor) monitor->record(SolverMonitor::Event::Iteration, iter + 1, changeNorm);
             if (changeNorm < 1e-6) {
                 break;  // Converged early
             }
         }
 
-        if (changeNorm >= 1e-6) {
-            std::cout << "Solution did not converge within the specified iterations. " << changeNorm << std::endl;
-            // throw std::runtime_error("Solution did not converge within the specified iterations.");
+        const bool converged = changeNorm < 1e-6;
+        if (monitor) {
+            monitor->record(converged ? SolverMonitor::Event::Converged : SolverMonitor::Event::MaxIterations,
+                            std::min(iter + 1, maxIter), changeNorm);
         }
+        return converged;
     }
 };
 #endif // ITER_SOLVER_HPP
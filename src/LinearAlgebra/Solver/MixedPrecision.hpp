@@ -0,0 +1,113 @@
+#ifndef MIXED_PRECISION_HPP
+#define MIXED_PRECISION_HPP
+
+#include <algorithm>
+#include <stdexcept>
+#include "../../Obj/SparseObj.hpp"
+#include "../../Obj/VectorObj.hpp"
+#include "../Krylov/FGMRES.hpp"
+#include "../Preconditioner/Preconditioner.hpp"
+
+/**
+ * @brief Mixed-precision iterative refinement: low-precision inner solves, high-precision residuals
+ *
+ * Keeps a TLow copy of A. Each refinement step computes r = b - A x in THigh,
+ * solves A d = r approximately with FGMRES in TLow (preconditioned by a TLow
+ * ILU, LU or AMG built on lowPrecisionMatrix()) and updates x += d in THigh.
+ * The factors and the inner iterations move half the bytes of a double
+ * solve, while the refinement still converges to THigh accuracy as long as
+ * the inner solve reduces the residual, i.e. A is not too ill-conditioned for
+ * TLow. The right-hand side of the inner solve is scaled to unit norm so the
+ * correction neither underflows nor overflows in TLow.
+ */
+template <typename TLow = float, typename THigh = double>
+class MixedPrecisionRefinement {
+private:
+    const SparseMatrixCSC<THigh>& A;
+    SparseMatrixCSC<TLow> Alow;
+    Preconditioner<TLow, VectorObj<TLow>>* preconditioner = nullptr;
+    int innerKrylovDim = 30;
+    int innerMaxIter = 1;
+    double innerTol = 1e-3;
+    int refinements = 0;
+    int innerIterations = 0;
+    THigh residualNorm = THigh(0);
+
+public:
+    explicit MixedPrecisionRefinement(const SparseMatrixCSC<THigh>& matrix)
+        : A(matrix), Alow(matrix.template cast<TLow>()) {
+        if (A.getRows() != A.getCols()) {
+            throw std::invalid_argument("Matrix must be square");
+        }
+    }
+
+    // Low-precision operator the preconditioner should be built on
+    const SparseMatrixCSC<TLow>& lowPrecisionMatrix() const { return Alow; }
+
+    // The preconditioner is not owned and must outlive the calls to solve
+    void setPreconditioner(Preconditioner<TLow, VectorObj<TLow>>& M) {
+        preconditioner = &M;
+    }
+
+    /**
+     * @brief Inner FGMRES settings
+     * @param KrylovDim Restart length
+     * @param maxIter Maximum number of restart cycles per refinement step
+     * @param tol Relative residual reduction requested from each inner solve
+     */
+    void setInnerSolver(int KrylovDim, int maxIter, double tol) {
+        if (KrylovDim <= 0 || maxIter <= 0 || tol <= 0.0) {
+            throw std::invalid_argument("Invalid inner solver settings");
+        }
+        innerKrylovDim = KrylovDim;
+        innerMaxIter = maxIter;
+        innerTol = tol;
+    }
+
+    int getRefinements() const { return refinements; }
+    int getInnerIterations() const { return innerIterations; }
+    THigh getResidualNorm() const { return residualNorm; }
+
+    /**
+     * @brief Solve A x = b starting from the initial guess in x
+     * @param maxRefinements Maximum number of refinement steps
+     * @param tol Tolerance on the relative residual ||b - A x|| / ||b||, computed in THigh
+     * @return true if the tolerance was reached
+     */
+    bool solve(const VectorObj<THigh>& b, VectorObj<THigh>& x, int maxRefinements, double tol) {
+        const int n = A.getRows();
+        if (static_cast<int>(b.size()) != n || static_cast<int>(x.size()) != n) {
+            throw std::invalid_argument("Vector sizes must match the matrix");
+        }
+
+        refinements = 0;
+        innerIterations = 0;
+        const THigh bNorm = b.L2norm();
+        const THigh target = tol * (bNorm > THigh(0) ? bNorm : THigh(1));
+        FGMRES<TLow> inner;
+        if (preconditioner) {
+            inner.setPreconditioner(*preconditioner);
+        }
+
+        VectorObj<THigh> r = b - A * x;
+        residualNorm = r.L2norm();
+        while (residualNorm > target && refinements < maxRefinements) {
+            // A d = r / ||r|| in TLow
+            const VectorObj<TLow> rLow = (r * (THigh(1) / residualNorm)).template cast<TLow>();
+            VectorObj<TLow> d(n, TLow(0));
+            inner.solve(Alow, rLow, d, innerMaxIter, std::min(innerKrylovDim, n), innerTol);
+            innerIterations += inner.getIterations();
+            ++refinements;
+
+            // x += ||r|| d and the residual in THigh
+            const TLow* dp = d.element();
+            THigh* xp = x.element();
+            for (int i = 0; i < n; ++i) xp[i] += residualNorm * static_cast<THigh>(dp[i]);
+            r = b - A * x;
+            residualNorm = r.L2norm();
+        }
+        return residualNorm <= target;
+    }
+};
+
+#endif // MIXED_PRECISION_HPP
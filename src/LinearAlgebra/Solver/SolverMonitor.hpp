@@ -0,0 +1,97 @@
+#ifndef SOLVER_MONITOR_HPP
+#define SOLVER_MONITOR_HPP
+
+#include <chrono>
+#include <cmath>
+#include <functional>
+#include <ostream>
+#include <vector>
+
+/**
+ * @brief In-memory convergence history shared by the iterative solvers
+ *
+ * Solvers hold a non-owning pointer that is null by default, so an unmonitored
+ * solve pays one branch per iteration and performs no I/O. When attached, every
+ * record (iteration, residual, seconds since start, event) is appended to the
+ * history and forwarded to the registered callbacks. The history can be written
+ * as CSV or JSON after the solve; streaming output goes through a callback.
+ */
+class SolverMonitor {
+public:
+    enum class Event {
+        Iteration,     // One inner iteration; residual is the solver's estimate
+        Restart,       // End of a restart cycle or outer step; residual is recomputed
+        Converged,     // Tolerance reached
+        MaxIterations  // Iteration limit reached without convergence
+    };
+
+    struct Record {
+        Event event;
+        int iteration;
+        double residual;
+        double seconds;
+    };
+
+    using Callback = std::function<void(const Record&)>;
+
+private:
+    std::vector<Record> history;
+    std::vector<Callback> callbacks;
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+public:
+    // Clears the history and restarts the clock; called by the solver at the start of solve
+    void start() {
+        history.clear();
+        startTime = std::chrono::steady_clock::now();
+    }
+
+    void record(Event event, int iteration, double residual) {
+        const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        history.push_back({event, iteration, residual, seconds});
+        for (const Callback& callback : callbacks) callback(history.back());
+    }
+
+    void addCallback(Callback callback) { callbacks.push_back(std::move(callback)); }
+
+    const std::vector<Record>& getHistory() const { return history; }
+
+    // Number of records of one kind, e.g. the restarts of a GMRES solve
+    int count(Event event) const {
+        int c = 0;
+        for (const Record& rec : history) c += rec.event == event;
+        return c;
+    }
+
+    static const char* eventName(Event event) {
+        switch (event) {
+            case Event::Iteration: return "iteration";
+            case Event::Restart: return "restart";
+            case Event::Converged: return "converged";
+            case Event::MaxIterations: return "max_iterations";
+        }
+        return "unknown";
+    }
+
+    void writeCSV(std::ostream& os) const {
+        os << "event,iteration,residual,seconds\n";
+        for (const Record& rec : history) {
+            os << eventName(rec.event) << ',' << rec.iteration << ',' << rec.residual << ',' << rec.seconds << '\n';
+        }
+    }
+
+    void writeJSON(std::ostream& os) const {
+        os << '[';
+        for (size_t i = 0; i < history.size(); ++i) {
+            const Record& rec = history[i];
+            os << (i ? "," : "") << "{\"event\":\"" << eventName(rec.event) << "\",\"iteration\":" << rec.iteration
+               << ",\"residual\":";
+            // JSON has no literal for inf or nan
+            if (std::isfinite(rec.residual)) os << rec.residual; else os << "null";
+            os << ",\"seconds\":" << rec.seconds << '}';
+        }
+        os << "]\n";
+    }
+};
+
+#endif // SOLVER_MONITOR_HPP
@@ -0,0 +1,157 @@
+#ifndef BANDOBJ_HPP
+#define BANDOBJ_HPP
+
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
+#include "VectorObj.hpp"
+#include "DenseObj.hpp"
+#include "SparseObj.hpp"
+
+/**
+ * @brief Square band matrix in LAPACK (gbtrf) band storage
+ *
+ * A has kl sub-diagonals and ku super-diagonals. Column j is stored in a
+ * column of length ld = 2 * kl + ku + 1 and entry (i, j) lives at row
+ * kl + ku + i - j of that column. The top kl rows are left free for the fill
+ * created by row interchanges during banded LU, so a BandObj can be factored
+ * in place in O(n * kl * (kl + ku)) time and O(n * (2 * kl + ku)) memory.
+ */
+template<typename TObj>
+class BandObj {
+private:
+    int _n;  // Order of the matrix
+    int _kl; // Number of sub-diagonals
+    int _ku; // Number of super-diagonals
+    int _ld; // Length of a stored column
+    std::vector<TObj> arr;
+
+    inline bool inBand(int row, int col) const {
+        return row - col <= _kl && col - row <= _ku + _kl;
+    }
+
+public:
+    BandObj() : _n(0), _kl(0), _ku(0), _ld(1), arr() {}
+
+    BandObj(int n, int kl, int ku) : _n(n), _kl(kl), _ku(ku), _ld(2 * kl + ku + 1),
+        arr(static_cast<size_t>(2 * kl + ku + 1) * n, TObj(0)) {
+        if (n < 0 || kl < 0 || ku < 0) {
+            throw std::invalid_argument("Band matrix dimensions must be non-negative.");
+        }
+    }
+
+    // Extract the band of a sparse matrix; the bandwidths are taken from its pattern
+    explicit BandObj(const SparseMatrixCSC<TObj>& A) : BandObj() {
+        if (A.getRows() != A.getCols()) {
+            throw std::invalid_argument("Band storage requires a square matrix.");
+        }
+        int kl = 0, ku = 0;
+        for (int col = 0; col < A.getCols(); ++col) {
+            for (int k = A.col_ptr[col]; k < A.col_ptr[col + 1]; ++k) {
+                kl = std::max(kl, A.row_indices[k] - col);
+                ku = std::max(ku, col - A.row_indices[k]);
+            }
+        }
+        *this = BandObj(A.getRows(), kl, ku);
+        for (int col = 0; col < A.getCols(); ++col) {
+            for (int k = A.col_ptr[col]; k < A.col_ptr[col + 1]; ++k) {
+                (*this)(A.row_indices[k], col) = A.values[k];
+            }
+        }
+    }
+
+    // Symmetrically permuted band, B(i, j) = A(perm[i], perm[j]), e.g. with a
+    // bandwidth-reducing ordering such as banded::reverseCuthillMcKee
+    BandObj(const SparseMatrixCSC<TObj>& A, const std::vector<int>& perm) : BandObj() {
+        const int n = A.getRows();
+        if (n != A.getCols() || static_cast<int>(perm.size()) != n) {
+            throw std::invalid_argument("Permutation does not match the matrix dimensions.");
+        }
+        std::vector<int> inv(n, -1);
+        for (int i = 0; i < n; ++i) {
+            if (perm[i] < 0 || perm[i] >= n || inv[perm[i]] != -1) {
+                throw std::invalid_argument("Invalid permutation.");
+            }
+            inv[perm[i]] = i;
+        }
+        int kl = 0, ku = 0;
+        for (int col = 0; col < n; ++col) {
+            for (int k = A.col_ptr[col]; k < A.col_ptr[col + 1]; ++k) {
+                kl = std::max(kl, inv[A.row_indices[k]] - inv[col]);
+                ku = std::max(ku, inv[col] - inv[A.row_indices[k]]);
+            }
+        }
+        *this = BandObj(n, kl, ku);
+        for (int col = 0; col < n; ++col) {
+            for (int k = A.col_ptr[col]; k < A.col_ptr[col + 1]; ++k) {
+                (*this)(inv[A.row_indices[k]], inv[col]) = A.values[k];
+            }
+        }
+    }
+
+    BandObj(const BandObj& other) = default;
+    BandObj(BandObj&& other) noexcept = default;
+    BandObj& operator=(const BandObj& other) = default;
+    BandObj& operator=(BandObj&& other) noexcept = default;
+    ~BandObj() = default;
+
+    // Accessors; entries outside the stored band are structurally zero
+    TObj& operator()(int row, int col) {
+        if (row < 0 || col < 0 || row >= _n || col >= _n || !inBand(row, col)) {
+            throw std::out_of_range("Matrix indices are outside the band.");
+        }
+        return arr[(_kl + _ku + row - col) + static_cast<size_t>(col) * _ld];
+    }
+
+    TObj operator()(int row, int col) const {
+        if (row < 0 || col < 0 || row >= _n || col >= _n) {
+            throw std::out_of_range("Matrix indices are out of range.");
+        }
+        if (!inBand(row, col)) return TObj(0);
+        return arr[(_kl + _ku + row - col) + static_cast<size_t>(col) * _ld];
+    }
+
+    TObj* data() { return arr.data(); }
+    const TObj* data() const { return arr.data(); }
+
+    inline int getRows() const { return _n; }
+    inline int getCols() const { return _n; }
+    inline int getLower() const { return _kl; }
+    inline int getUpper() const { return _ku; }
+    inline int ld() const { return _ld; }
+
+    void addValue(int row, int col, TObj value) {
+        (*this)(row, col) = value;
+    }
+
+    void finalize() {}
+
+    // Matrix-vector multiplication using the original kl/ku band
+    VectorObj<TObj> operator*(const VectorObj<TObj>& vec) const {
+        if (_n != static_cast<int>(vec.size())) {
+            throw std::invalid_argument("Vector size does not match matrix columns.");
+        }
+        VectorObj<TObj> result(_n);
+        TObj* y = result.element();
+        const TObj* x = vec.element();
+        for (int j = 0; j < _n; ++j) {
+            const TObj* col = arr.data() + static_cast<size_t>(j) * _ld + _kl + _ku - j;
+            for (int i = std::max(0, j - _ku); i <= std::min(_n - 1, j + _kl); ++i) {
+                y[i] += col[i] * x[j];
+            }
+        }
+        return result;
+    }
+
+    DenseObj<TObj> toDense() const {
+        DenseObj<TObj> dense(_n, _n);
+        for (int j = 0; j < _n; ++j) {
+            for (int i = std::max(0, j - _ku); i <= std::min(_n - 1, j + _kl); ++i) {
+                dense(i, j) = (*this)(i, j);
+            }
+        }
+        return dense;
+    }
+};
+
+#endif // BANDOBJ_HPP
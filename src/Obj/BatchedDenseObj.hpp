@@ -0,0 +1,107 @@
+#ifndef BATCHEDDENSEOBJ_HPP
+#define BATCHEDDENSEOBJ_HPP
+
+#include <vector>
+#include <stdexcept>
+#include "DenseObj.hpp"
+
+/**
+ * @brief A batch of independent, equally sized dense matrices.
+ *
+ * Entry (row, col) of matrix k is stored at ((row + col * n) * batch + k), i.e.
+ * the batch index is the fastest running one. The same entry of consecutive
+ * systems is therefore contiguous, which lets the batched kernels vectorize
+ * across the batch instead of along the (short) rows and columns.
+ */
+template<typename TObj>
+class BatchedDenseObj {
+private:
+    int _n;     // Number of rows of each matrix
+    int _m;     // Number of columns of each matrix
+    int _batch; // Number of matrices
+    std::vector<TObj> arr;
+
+public:
+    // Constructors
+    BatchedDenseObj() : _n(0), _m(0), _batch(0), arr() {}
+
+    BatchedDenseObj(int n, int m, int batch) : _n(n), _m(m), _batch(batch), arr(static_cast<size_t>(n) * m * batch, TObj(0)) {
+        if (n < 0 || m < 0 || batch < 0) {
+            throw std::invalid_argument("Batched matrix dimensions must be non-negative.");
+        }
+    }
+
+    BatchedDenseObj(const BatchedDenseObj& other) = default;
+    BatchedDenseObj(BatchedDenseObj&& other) noexcept = default;
+    BatchedDenseObj& operator=(const BatchedDenseObj& other) = default;
+    BatchedDenseObj& operator=(BatchedDenseObj&& other) noexcept = default;
+    ~BatchedDenseObj() = default;
+
+    // Accessors
+    TObj& operator()(int row, int col, int k) {
+        if (row < 0 || col < 0 || k < 0 || row >= _n || col >= _m || k >= _batch) {
+            throw std::out_of_range("Batched matrix indices are out of range.");
+        }
+        return arr[(static_cast<size_t>(row) + static_cast<size_t>(col) * _n) * _batch + k];
+    }
+
+    const TObj& operator()(int row, int col, int k) const {
+        if (row < 0 || col < 0 || k < 0 || row >= _n || col >= _m || k >= _batch) {
+            throw std::out_of_range("Batched matrix indices are out of range.");
+        }
+        return arr[(static_cast<size_t>(row) + static_cast<size_t>(col) * _n) * _batch + k];
+    }
+
+    // Unchecked pointer to entry (row, col) of the first matrix; the entry of
+    // matrix k is at offset k. Intended for the batched kernels.
+    inline TObj* lane(int row, int col) {
+        return arr.data() + (static_cast<size_t>(row) + static_cast<size_t>(col) * _n) * _batch;
+    }
+    inline const TObj* lane(int row, int col) const {
+        return arr.data() + (static_cast<size_t>(row) + static_cast<size_t>(col) * _n) * _batch;
+    }
+
+    TObj* data() { return arr.data(); }
+    const TObj* data() const { return arr.data(); }
+
+    inline int getRows() const { return _n; }
+    inline int getCols() const { return _m; }
+    inline int getBatch() const { return _batch; }
+
+    void zero() {
+        std::fill(arr.begin(), arr.end(), TObj(0));
+    }
+
+    // Scatter a DenseObj into slot k of the batch
+    void setMatrix(int k, const DenseObj<TObj>& A) {
+        if (A.getRows() != _n || A.getCols() != _m) {
+            throw std::invalid_argument("Matrix dimensions do not match the batch.");
+        }
+        if (k < 0 || k >= _batch) {
+            throw std::out_of_range("Batch index is out of range.");
+        }
+        const TObj* src = A.data();
+        for (int j = 0; j < _m; ++j) {
+            for (int i = 0; i < _n; ++i) {
+                lane(i, j)[k] = src[i + j * _n];
+            }
+        }
+    }
+
+    // Gather slot k of the batch into a DenseObj
+    DenseObj<TObj> getMatrix(int k) const {
+        if (k < 0 || k >= _batch) {
+            throw std::out_of_range("Batch index is out of range.");
+        }
+        DenseObj<TObj> A(_n, _m);
+        TObj* dst = A.data();
+        for (int j = 0; j < _m; ++j) {
+            for (int i = 0; i < _n; ++i) {
+                dst[i + j * _n] = lane(i, j)[k];
+            }
+        }
+        return A;
+    }
+};
+
+#endif // BATCHEDDENSEOBJ_HPP
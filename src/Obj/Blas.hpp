@@ -0,0 +1,72 @@
+#ifndef BLAS_HPP
+#define BLAS_HPP
+
+#include "cblas.h"
+
+/**
+ * @namespace blas
+ * @brief Precision-generic overloads of the CBLAS routines used in the library
+ *
+ * Templates call blas::gemm etc. with TNum pointers and the overload picks
+ * the s- or d-prefixed routine, so float instantiations run single precision
+ * BLAS instead of failing to compile against the double interface.
+ */
+namespace blas {
+    inline void gemm(CBLAS_ORDER order, CBLAS_TRANSPOSE ta, CBLAS_TRANSPOSE tb, int m, int n, int k,
+                     double alpha, const double* A, int lda, const double* B, int ldb, double beta, double* C, int ldc) {
+        cblas_dgemm(order, ta, tb, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+    }
+    inline void gemm(CBLAS_ORDER order, CBLAS_TRANSPOSE ta, CBLAS_TRANSPOSE tb, int m, int n, int k,
+                     float alpha, const float* A, int lda, const float* B, int ldb, float beta, float* C, int ldc) {
+        cblas_sgemm(order, ta, tb, m, n, k, alpha, A, lda, B, ldb, beta, C, ldc);
+    }
+
+    inline void gemv(CBLAS_ORDER order, CBLAS_TRANSPOSE ta, int m, int n, double alpha, const double* A, int lda,
+                     const double* x, int incx, double beta, double* y, int incy) {
+        cblas_dgemv(order, ta, m, n, alpha, A, lda, x, incx, beta, y, incy);
+    }
+    inline void gemv(CBLAS_ORDER order, CBLAS_TRANSPOSE ta, int m, int n, float alpha, const float* A, int lda,
+                     const float* x, int incx, float beta, float* y, int incy) {
+        cblas_sgemv(order, ta, m, n, alpha, A, lda, x, incx, beta, y, incy);
+    }
+
+    inline void ger(CBLAS_ORDER order, int m, int n, double alpha, const double* x, int incx,
+                    const double* y, int incy, double* A, int lda) {
+        cblas_dger(order, m, n, alpha, x, incx, y, incy, A, lda);
+    }
+    inline void ger(CBLAS_ORDER order, int m, int n, float alpha, const float* x, int incx,
+                    const float* y, int incy, float* A, int lda) {
+        cblas_sger(order, m, n, alpha, x, incx, y, incy, A, lda);
+    }
+
+    inline void trsm(CBLAS_ORDER order, CBLAS_SIDE side, CBLAS_UPLO uplo, CBLAS_TRANSPOSE ta, CBLAS_DIAG diag,
+                     int m, int n, double alpha, const double* A, int lda, double* B, int ldb) {
+        cblas_dtrsm(order, side, uplo, ta, diag, m, n, alpha, A, lda, B, ldb);
+    }
+    inline void trsm(CBLAS_ORDER order, CBLAS_SIDE side, CBLAS_UPLO uplo, CBLAS_TRANSPOSE ta, CBLAS_DIAG diag,
+                     int m, int n, float alpha, const float* A, int lda, float* B, int ldb) {
+        cblas_strsm(order, side, uplo, ta, diag, m, n, alpha, A, lda, B, ldb);
+    }
+
+    inline double dot(int n, const double* x, int incx, const double* y, int incy) {
+        return cblas_ddot(n, x, incx, y, incy);
+    }
+    inline float dot(int n, const float* x, int incx, const float* y, int incy) {
+        return cblas_sdot(n, x, incx, y, incy);
+    }
+
+    inline double nrm2(int n, const double* x, int incx) { return cblas_dnrm2(n, x, incx); }
+    inline float nrm2(int n, const float* x, int incx) { return cblas_snrm2(n, x, incx); }
+
+    inline void axpy(int n, double alpha, const double* x, int incx, double* y, int incy) {
+        cblas_daxpy(n, alpha, x, incx, y, incy);
+    }
+    inline void axpy(int n, float alpha, const float* x, int incx, float* y, int incy) {
+        cblas_saxpy(n, alpha, x, incx, y, incy);
+    }
+
+    inline void scal(int n, double alpha, double* x, int incx) { cblas_dscal(n, alpha, x, incx); }
+    inline void scal(int n, float alpha, float* x, int incx) { cblas_sscal(n, alpha, x, incx); }
+} // namespace blas
+
+#endif // BLAS_HPP
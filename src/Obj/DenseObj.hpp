@@ -7,13 +7,17 @@
 #include <functional>
 #include <iostream>
 // #include <openblas/cblas.h>
-#include "cblas.h"
+#include "Blas.hpp"
 
 #include "VectorObj.hpp"
+#include "DenseView.hpp"
 
 template<typename TObj> 
 class VectorObj;
 
+template<typename TObj>
+class DenseView;
+
 
 template<typename TObj>
 class DenseObj {
@@ -52,6 +56,12 @@ public:
         }
     }
 
+    // Deep copy of a viewed block
+    template<typename U>
+    explicit DenseObj(const DenseView<U>& view) : _n(view.getRows()), _m(view.getCols()), arr(view.getRows() * view.getCols()) {
+        this->view(0, 0, _n, _m).assign(view);
+    }
+
     // Copy Constructor
     DenseObj(const DenseObj& other) = default;
 
@@ -67,6 +77,14 @@ public:
     // Destructor
     ~DenseObj() = default;
 
+    // Copy with the entries converted to another precision
+    template <typename U>
+    DenseObj<U> cast() const {
+        DenseObj<U> result(_n, _m);
+        std::copy(arr.begin(), arr.end(), result.data());
+        return result;
+    }
+
     // Accessors
     TObj& operator[](int index) {
         if ( index < 0 || index >= _n * _m ) {
@@ -101,6 +119,14 @@ public:
     inline int getRows() const { return _n; }
     inline int getCols() const { return _m; }
 
+    // Non-owning views of the block starting at (row, col); no data is copied
+    DenseView<TObj> view(int row, int col, int n, int m) {
+        return DenseView<TObj>(arr.data(), _n, _m, std::max(1, _n)).view(row, col, n, m);
+    }
+    DenseView<const TObj> view(int row, int col, int n, int m) const {
+        return DenseView<const TObj>(arr.data(), _n, _m, std::max(1, _n)).view(row, col, n, m);
+    }
+
     // Scalar multiplication
     DenseObj& operator*=(TObj scalar) {
         for (TObj& value : arr) {
@@ -141,7 +167,7 @@ public:
             throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
         }
         DenseObj result(_n, other._m);
-        cblas_dgemm(CblasColMajor, CblasNoTrans, CblasNoTrans,
+        blas::gemm(CblasColMajor, CblasNoTrans, CblasNoTrans,
                     _n, other._m, _m, 1.0,
                     arr.data(), _n,
                     other.arr.data(), other._n,
@@ -149,13 +175,18 @@ public:
         return result;
     }
 
+    template<typename U>
+    DenseObj operator*(const DenseView<U>& other) const {
+        return view(0, 0, _n, _m) * other;
+    }
+
     // Matrix-vector multiplication
     VectorObj<TObj> operator*(const VectorObj<TObj>& vec) const {
         if (_m != static_cast<int>(vec.size())) {
             throw std::invalid_argument("Vector size does not match matrix columns.");
         }
         VectorObj<TObj> result(_n);
-        cblas_dgemv(CblasColMajor, CblasNoTrans,
+        blas::gemv(CblasColMajor, CblasNoTrans,
                     _n, _m, 1.0,
                     arr.data(), _n,
                     vec.element(), 1,
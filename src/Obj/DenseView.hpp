@@ -0,0 +1,157 @@
+#ifndef DENSEVIEW_HPP
+#define DENSEVIEW_HPP
+
+#include <stdexcept>
+#include <type_traits>
+#include <algorithm>
+#include "Blas.hpp"
+
+#include "VectorObj.hpp"
+
+template<typename TObj>
+class DenseObj;
+
+/**
+ * @brief Non-owning view of a column-major block of a DenseObj
+ *
+ * Entry (row, col) lives at data()[row + col * ld()], so a view can be handed
+ * to BLAS together with its leading dimension and to every basic:: routine
+ * that works in place. Views of a const DenseObj are DenseView<const TObj>.
+ * A view is only valid while the matrix it refers to is alive and not resized.
+ */
+template<typename TObj>
+class DenseView {
+public:
+    using value_type = std::remove_const_t<TObj>;
+
+private:
+    TObj* _ptr; // Address of entry (0, 0)
+    int _n;     // Number of rows
+    int _m;     // Number of columns
+    int _ld;    // Leading dimension (distance between columns)
+
+public:
+    DenseView() : _ptr(nullptr), _n(0), _m(0), _ld(1) {}
+
+    DenseView(TObj* ptr, int n, int m, int ld) : _ptr(ptr), _n(n), _m(m), _ld(ld) {
+        if (n < 0 || m < 0 || ld < std::max(1, n)) {
+            throw std::invalid_argument("Invalid view dimensions or leading dimension.");
+        }
+    }
+
+    // A mutable view converts to a read-only one
+    template<typename U, typename = std::enable_if_t<std::is_same_v<const U, TObj> && !std::is_same_v<U, TObj>>>
+    DenseView(const DenseView<U>& other) : _ptr(other.data()), _n(other.getRows()), _m(other.getCols()), _ld(other.ld()) {}
+
+    // Accessors
+    TObj& operator()(int row, int col) const {
+        if (row < 0 || col < 0 || row >= _n || col >= _m) {
+            throw std::out_of_range("Matrix indices are out of range.");
+        }
+        return _ptr[row + static_cast<size_t>(col) * _ld];
+    }
+
+    TObj* data() const { return _ptr; }
+
+    inline int getRows() const { return _n; }
+    inline int getCols() const { return _m; }
+    inline int ld() const { return _ld; }
+
+    // Sub-block of this view starting at (row, col)
+    DenseView view(int row, int col, int n, int m) const {
+        if (row < 0 || col < 0 || n < 0 || m < 0 || row + n > _n || col + m > _m) {
+            throw std::out_of_range("Sub-view exceeds the viewed block.");
+        }
+        return DenseView(_ptr + row + static_cast<size_t>(col) * _ld, n, m, _ld);
+    }
+
+    VectorObj<value_type> getColumn(int index) const {
+        if (index < 0 || index >= _m) {
+            throw std::out_of_range("Column index is out of range.");
+        }
+        return VectorObj<value_type>(_ptr + static_cast<size_t>(index) * _ld, _n);
+    }
+
+    void swapRows(int row1, int row2) const {
+        if (row1 < 0 || row2 < 0 || row1 >= _n || row2 >= _n) {
+            throw std::out_of_range("Matrix indices are out of range.");
+        }
+        if (row1 == row2) return;
+        for (int j = 0; j < _m; ++j) {
+            std::swap(_ptr[row1 + static_cast<size_t>(j) * _ld], _ptr[row2 + static_cast<size_t>(j) * _ld]);
+        }
+    }
+
+    void addValue(int row, int col, value_type value) const {
+        (*this)(row, col) = value;
+    }
+
+    void finalize() const {}
+
+    // Copy the entries of another block of the same shape into this one
+    template<typename U>
+    void assign(const DenseView<U>& other) const {
+        if (_n != other.getRows() || _m != other.getCols()) {
+            throw std::invalid_argument("Matrix dimensions do not match for assignment.");
+        }
+        for (int j = 0; j < _m; ++j) {
+            std::copy(other.data() + static_cast<size_t>(j) * other.ld(),
+                      other.data() + static_cast<size_t>(j) * other.ld() + _n,
+                      _ptr + static_cast<size_t>(j) * _ld);
+        }
+    }
+
+    // Owning copy of the viewed block
+    DenseObj<value_type> toDense() const {
+        DenseObj<value_type> result(_n, _m);
+        result.view(0, 0, _n, _m).assign(*this);
+        return result;
+    }
+
+    DenseObj<value_type> Transpose() const {
+        DenseObj<value_type> result(_m, _n);
+        for (int j = 0; j < _m; ++j) {
+            for (int i = 0; i < _n; ++i) {
+                result(j, i) = _ptr[i + static_cast<size_t>(j) * _ld];
+            }
+        }
+        return result;
+    }
+
+    // Matrix multiplication
+    template<typename U>
+    DenseObj<value_type> operator*(const DenseView<U>& other) const {
+        if (_m != other.getRows()) {
+            throw std::invalid_argument("Matrix dimensions do not match for multiplication.");
+        }
+        DenseObj<value_type> result(_n, other.getCols());
+        blas::gemm(CblasColMajor, CblasNoTrans, CblasNoTrans,
+                    _n, other.getCols(), _m, 1.0,
+                    _ptr, _ld,
+                    other.data(), other.ld(),
+                    0.0, result.data(), std::max(1, _n));
+        return result;
+    }
+
+    DenseObj<value_type> operator*(const DenseObj<value_type>& other) const {
+        return (*this) * other.view(0, 0, other.getRows(), other.getCols());
+    }
+
+    // Matrix-vector multiplication
+    VectorObj<value_type> operator*(const VectorObj<value_type>& vec) const {
+        if (_m != static_cast<int>(vec.size())) {
+            throw std::invalid_argument("Vector size does not match matrix columns.");
+        }
+        VectorObj<value_type> result(_n);
+        blas::gemv(CblasColMajor, CblasNoTrans,
+                    _n, _m, 1.0,
+                    _ptr, _ld,
+                    vec.element(), 1,
+                    0.0, result.element(), 1);
+        return result;
+    }
+};
+
+#include "DenseObj.hpp"
+
+#endif // DENSEVIEW_HPP
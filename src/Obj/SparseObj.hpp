@@ -25,6 +25,15 @@ public:
     alignas(64) std::vector<int> row_indices;
     alignas(64) std::vector<int> col_ptr;
 
+    // Row-wise index of the CSC pattern, rebuilt by finalize(): the entries of
+    // row i are values[row_pos[k]] at column row_col[k] for k in
+    // [row_ptr[i], row_ptr[i + 1]). It holds positions rather than copies of the
+    // values, so in-place updates (addValue on an existing entry, scaling) stay
+    // visible. Code that writes col_ptr/row_indices directly must call finalize().
+    std::vector<int> row_ptr;
+    std::vector<int> row_col;
+    std::vector<int> row_pos;
+
     // Helper struct for construction
     struct Entry {
         int row;
@@ -52,6 +61,24 @@ public:
     }
     ~SparseMatrixCSC() = default;
 
+    // Copy with the entries converted to another precision (e.g. a float operator for mixed precision)
+    template <typename U>
+    SparseMatrixCSC<U> cast() const {
+        SparseMatrixCSC<U> result(_n, _m);
+        result.values.assign(values.begin(), values.end());
+        result.row_indices = row_indices;
+        result.col_ptr = col_ptr;
+        result.row_ptr = row_ptr;
+        result.row_col = row_col;
+        result.row_pos = row_pos;
+        // addValue and finalize keep working on the copy through the construction buffer
+        result.construction_buffer.reserve(construction_buffer.size());
+        for (const Entry& e : construction_buffer) {
+            result.construction_buffer.push_back({e.row, e.col, static_cast<U>(e.value)});
+        }
+        return result;
+    }
+
     void addValue(int row, int col, TObj value) {
 
         const auto end = col_ptr[col + 1];
@@ -76,6 +103,7 @@ public:
     void finalize() {
         if (construction_buffer.empty()) {
             construction_buffer.clear();
+            buildRowIndex();
             return;
         }
         std::sort(construction_buffer.begin(), construction_buffer.end());
@@ -97,6 +125,32 @@ public:
         }
 
         // construction_buffer.clear();
+        buildRowIndex();
+    }
+
+    // Counting-sort transpose of the pattern into row_ptr/row_col/row_pos; columns
+    // within a row come out in ascending order
+    void buildRowIndex() {
+        const int nnz = row_indices.size();
+        if (static_cast<int>(col_ptr.size()) != _m + 1 || col_ptr[_m] != nnz) {
+            row_ptr.clear();
+            row_col.clear();
+            row_pos.clear();
+            return;
+        }
+        row_ptr.assign(_n + 1, 0);
+        for (int idx = 0; idx < nnz; ++idx) ++row_ptr[row_indices[idx] + 1];
+        std::partial_sum(row_ptr.begin(), row_ptr.end(), row_ptr.begin());
+        row_col.resize(nnz);
+        row_pos.resize(nnz);
+        std::vector<int> next(row_ptr.begin(), row_ptr.end() - 1);
+        for (int col = 0; col < _m; ++col) {
+            for (int idx = col_ptr[col]; idx < col_ptr[col + 1]; ++idx) {
+                const int k = next[row_indices[idx]]++;
+                row_col[k] = col;
+                row_pos[k] = idx;
+            }
+        }
     }
 
     inline int getRows() const { return _n; }
@@ -135,15 +189,25 @@ public:
 
         VectorObj<TObj> result(_n, TObj());
 
-        #pragma omp parallel for schedule(dynamic)
-        for (int col = 0; col < _m; ++col) {
-            const TObj vec_val = vec[col];
-            if (vec_val == TObj()) continue;
-
-            for (int idx = col_ptr[col]; idx < col_ptr[col + 1]; ++idx) {
-                #pragma omp critical
-                {
-                    result[row_indices[idx]] += values[idx] * vec_val;
+        const TObj* x = vec.element();
+        TObj* y = result.element();
+        if (row_pos.size() == row_indices.size() && static_cast<int>(row_ptr.size()) == _n + 1) {
+            // Row-oriented gather: no shared writes, and every y[i] is summed in
+            // column order whatever the thread count
+            #pragma omp parallel for schedule(static)
+            for (int row = 0; row < _n; ++row) {
+                TObj sum = TObj();
+                for (int k = row_ptr[row]; k < row_ptr[row + 1]; ++k) {
+                    sum += values[row_pos[k]] * x[row_col[k]];
+                }
+                y[row] = sum;
+            }
+        } else {
+            // Pattern written without finalize(): sequential column scatter
+            for (int col = 0; col < _m; ++col) {
+                const TObj vec_val = x[col];
+                for (int idx = col_ptr[col]; idx < col_ptr[col + 1]; ++idx) {
+                    y[row_indices[idx]] += values[idx] * vec_val;
                 }
             }
         }
@@ -151,6 +215,44 @@ public:
         return result;
     }
 
+    // Sparse times dense (SpMM): the matrix is streamed once per panel of
+    // right-hand sides instead of once per column, which is what makes block
+    // Krylov methods cheaper than k separate solves
+    DenseObj<TObj> operator*(const DenseObj<TObj>& X) const {
+        if (_m != X.getRows()) {
+            throw std::invalid_argument("Dimension mismatch");
+        }
+        const int k = X.getCols();
+        constexpr int panel = 8;
+        DenseObj<TObj> Y(_n, k);
+        const int panels = (k + panel - 1) / panel;
+
+        #pragma omp parallel for schedule(static) if(panels > 1)
+        for (int pnl = 0; pnl < panels; ++pnl) {
+            const int j0 = pnl * panel;
+            const int w = std::min(panel, k - j0);
+            // Row-major copies of the panel keep the inner loop contiguous
+            std::vector<TObj> xp(static_cast<size_t>(_m) * w), yp(static_cast<size_t>(_n) * w, TObj());
+            for (int j = 0; j < w; ++j) {
+                const TObj* xc = X.data() + static_cast<size_t>(j0 + j) * _m;
+                for (int i = 0; i < _m; ++i) xp[static_cast<size_t>(i) * w + j] = xc[i];
+            }
+            for (int col = 0; col < _m; ++col) {
+                const TObj* xrow = xp.data() + static_cast<size_t>(col) * w;
+                for (int idx = col_ptr[col]; idx < col_ptr[col + 1]; ++idx) {
+                    const TObj a = values[idx];
+                    TObj* yrow = yp.data() + static_cast<size_t>(row_indices[idx]) * w;
+                    for (int j = 0; j < w; ++j) yrow[j] += a * xrow[j];
+                }
+            }
+            for (int j = 0; j < w; ++j) {
+                TObj* yc = Y.data() + static_cast<size_t>(j0 + j) * _n;
+                for (int i = 0; i < _n; ++i) yc[i] = yp[static_cast<size_t>(i) * w + j];
+            }
+        }
+        return Y;
+    }
+
     SparseMatrixCSC operator*(const SparseMatrixCSC& other) const {
         if (_m != other._n) {
             throw std::invalid_argument("Dimension mismatch");
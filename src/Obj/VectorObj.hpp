@@ -33,6 +33,14 @@ public:
 
     ~VectorObj() = default;
 
+    // Copy with the entries converted to another precision
+    template <typename U>
+    VectorObj<U> cast() const {
+        VectorObj<U> result(static_cast<int>(_size));
+        std::copy(data.begin(), data.end(), result.element());
+        return result;
+    }
+
     // Element Access
     TObj& operator[](int index) {
         if (index < 0 || index >= _size) throw std::out_of_range("Index out of range.");
@@ -101,6 +109,15 @@ public:
         return result;
     }
 
+    // In-place update this = this + alpha * other, without a temporary
+    VectorObj& axpy(TObj alpha, const VectorObj& other) {
+        if (_size != other._size) throw std::invalid_argument("Vector dimensions do not match.");
+        TObj* y = data.data();
+        const TObj* x = other.data.data();
+        for (size_t i = 0; i < _size; ++i) y[i] += alpha * x[i];
+        return *this;
+    }
+
     // Dot Product
     TObj operator*(const VectorObj& other) const {
         if (_size != other._size) throw std::invalid_argument("Vector dimensions do not match for dot product.");
@@ -1,5 +1,10 @@
+#include <stack>
+#include <vector>
+#include <stdexcept>
+#include <algorithm>
 #include "../../Obj/SparseObj.hpp"
 #include "../../Obj/VectorObj.hpp" 
+#include "../../Obj/DenseObj.hpp"
 
 namespace SparseLA{
 
@@ -40,4 +45,71 @@ namespace SparseLA{
 			}
 		}
 	}
-}
\ No newline at end of file
+
+	// Sparse triangular solve with a block of right-hand sides, T X = B.
+	// Each column of T is streamed once for all k right-hand sides: B is
+	// copied into row-major panels so the k updates per nonzero are contiguous,
+	// and the panels are solved in parallel.
+	template<typename T = double >
+	void TriangularSolve(const SparseMatrixCSC<T> &Tri, DenseObj<T> &B, bool lower, bool unitDiagonal = false){
+		const int n = Tri.getRows();
+		const int k = B.getCols();
+		if (n != Tri.getCols() || B.getRows() != n) {
+			throw std::invalid_argument("Matrix dimensions do not match for triangular solve.");
+		}
+		if (n == 0 || k == 0) return;
+
+		std::vector<T> diag(n, T(1));
+		if (!unitDiagonal) {
+			std::vector<bool> found(n, false);
+			for (int j = 0; j < n; ++j) {
+				for (int p = Tri.col_ptr[j]; p < Tri.col_ptr[j + 1]; ++p) {
+					if (Tri.row_indices[p] == j) {
+						diag[j] = Tri.values[p];
+						found[j] = Tri.values[p] != T(0);
+					}
+				}
+				if (!found[j]) {
+					throw std::runtime_error("Division by zero during substitution.");
+				}
+			}
+		}
+
+		const int panel = 32;
+		const int panels = (k + panel - 1) / panel;
+		T* b = B.data();
+
+		#pragma omp parallel for schedule(dynamic)
+		for (int q = 0; q < panels; ++q) {
+			const int r0 = q * panel;
+			const int w = std::min(panel, k - r0);
+			std::vector<T> X(static_cast<size_t>(n) * w);
+			for (int r = 0; r < w; ++r) {
+				for (int i = 0; i < n; ++i) {
+					X[static_cast<size_t>(i) * w + r] = b[i + static_cast<size_t>(r0 + r) * n];
+				}
+			}
+
+			for (int s = 0; s < n; ++s) {
+				const int j = lower ? s : n - 1 - s;
+				T* xj = X.data() + static_cast<size_t>(j) * w;
+				const T inv = T(1) / diag[j];
+				for (int r = 0; r < w; ++r) xj[r] *= inv;
+				for (int p = Tri.col_ptr[j]; p < Tri.col_ptr[j + 1]; ++p) {
+					const int i = Tri.row_indices[p];
+					if (lower ? i <= j : i >= j) continue;
+					const T lij = Tri.values[p];
+					T* xi = X.data() + static_cast<size_t>(i) * w;
+					#pragma omp simd
+					for (int r = 0; r < w; ++r) xi[r] -= lij * xj[r];
+				}
+			}
+
+			for (int r = 0; r < w; ++r) {
+				for (int i = 0; i < n; ++i) {
+					b[i + static_cast<size_t>(r0 + r) * n] = X[static_cast<size_t>(i) * w + r];
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include "ApproximateInverse.hpp"
+#include "ConjugateGradient.hpp"
+#include "FGMRES.hpp"
+#include "SparseObj.hpp"
+#include "VectorObj.hpp"
+#include "TestProblems.hpp"
+#include <cmath>
+
+class ApproximateInverseTest : public ::testing::Test {
+protected:
+    SparseMatrixCSC<double> diagonal(int n) {
+        SparseMatrixCSC<double> D(n, n);
+        for (int i = 0; i < n; ++i) D.addValue(i, i, 1.0 + i);
+        D.finalize();
+        return D;
+    }
+
+    int cgIterations(const SparseMatrixCSC<double>& A, Preconditioner<double>* M) {
+        VectorObj<double> b = testproblems::rhs(A.getRows());
+        ConjugateGrad<double, SparseMatrixCSC<double>, VectorObj<double>> cg(A, b, 1000, 1e-10);
+        if (M) cg.setPreconditioner(*M);
+        VectorObj<double> x;
+        EXPECT_TRUE(cg.solve(x));
+        EXPECT_LT((b - A * x).L2norm(), 1e-9 * b.L2norm());
+        return cg.getIterations();
+    }
+};
+
+// Both approximate inverses are exact for a diagonal matrix
+TEST_F(ApproximateInverseTest, ExactForDiagonal) {
+    SparseMatrixCSC<double> D = diagonal(40);
+    VectorObj<double> b = testproblems::rhs(40);
+
+    FSAIPreconditioner<double> fsai;
+    fsai.compute(D);
+    EXPECT_LT((D * fsai.apply(b) - b).L2norm(), 1e-12 * b.L2norm());
+
+    SPAIPreconditioner<double> spai;
+    spai.compute(D);
+    EXPECT_LT(spai.getResidual(), 1e-12);
+    EXPECT_LT((D * spai.apply(b) - b).L2norm(), 1e-12 * b.L2norm());
+}
+
+// FSAI is SPD, so it preconditions CG; a denser pattern helps more
+TEST_F(ApproximateInverseTest, FSAIPreconditionsCG) {
+    SparseMatrixCSC<double> A = testproblems::upwindConvectionDiffusion(30, 0.0);
+    const int plain = cgIterations(A, nullptr);
+
+    FSAIPreconditioner<double> fsai1(1);
+    fsai1.compute(A);
+    const int it1 = cgIterations(A, &fsai1);
+
+    FSAIPreconditioner<double> fsai2(2);
+    fsai2.compute(A);
+    const int it2 = cgIterations(A, &fsai2);
+
+    EXPECT_EQ(fsai1.getNonZeros(), (A.values.size() + A.getRows()) / 2);
+    EXPECT_GT(fsai2.getNonZeros(), fsai1.getNonZeros());
+    EXPECT_LT(it1, plain);
+    EXPECT_LT(it2, it1);
+}
+
+// ||A M - I||_F shrinks with the pattern level and SPAI accelerates FGMRES
+TEST_F(ApproximateInverseTest, SPAIPreconditionsFGMRES) {
+    SparseMatrixCSC<double> A = testproblems::upwindConvectionDiffusion(30, 2.0);
+    const int n = A.getRows();
+    VectorObj<double> b = testproblems::rhs(n);
+
+    FGMRES<double> plain;
+    VectorObj<double> x0(n, 0.0);
+    ASSERT_TRUE(plain.solve(A, b, x0, 30, 30, 1e-10));
+
+    SPAIPreconditioner<double> spai1(1), spai2(2);
+    spai1.compute(A);
+    spai2.compute(A);
+    EXPECT_LT(spai2.getResidual(), spai1.getResidual());
+    EXPECT_LT(spai1.getResidual(), std::sqrt(static_cast<double>(n)));
+
+    FGMRES<double> solver;
+    solver.setPreconditioner(spai2);
+    VectorObj<double> x(n, 0.0);
+    EXPECT_TRUE(solver.solve(A, b, x, 30, 30, 1e-10));
+    EXPECT_LT((b - A * x).L2norm(), 1e-8);
+    EXPECT_LT(solver.getIterations(), plain.getIterations());
+}
+
+// Row 0 of A(:, J) is empty for column 0 (a_00 = 0), which still counts in ||A M - I||_F
+TEST_F(ApproximateInverseTest, SPAIResidualWithZeroDiagonal) {
+    SparseMatrixCSC<double> A(3, 3);
+    A.addValue(0, 2, 1.0);
+    A.addValue(1, 0, 1.0);
+    A.addValue(1, 1, 1.0);
+    A.addValue(2, 1, 1.0);
+    A.addValue(2, 2, 1.0);
+    A.finalize();
+    SPAIPreconditioner<double> spai(1);
+    spai.compute(A);
+    double total = 0.0;
+    for (int j = 0; j < 3; ++j) {
+        VectorObj<double> e(3, 0.0);
+        e[j] = 1.0;
+        const double r = (A * spai.apply(e) - e).L2norm();
+        total += r * r;
+    }
+    EXPECT_NEAR(spai.getResidual(), std::sqrt(total), 1e-12);
+    EXPECT_GE(spai.getResidual(), 1.0);
+}
+
+TEST_F(ApproximateInverseTest, InvalidArguments) {
+    EXPECT_THROW(FSAIPreconditioner<double>(0), std::invalid_argument);
+    EXPECT_THROW(SPAIPreconditioner<double>(0), std::invalid_argument);
+    FSAIPreconditioner<double> fsai;
+    SPAIPreconditioner<double> spai;
+    EXPECT_THROW(fsai.apply(VectorObj<double>(3, 1.0)), std::runtime_error);
+    EXPECT_THROW(spai.apply(VectorObj<double>(3, 1.0)), std::runtime_error);
+
+    SparseMatrixCSC<double> indefinite(2, 2);
+    indefinite.addValue(0, 0, 1.0);
+    indefinite.addValue(1, 1, -1.0);
+    indefinite.finalize();
+    EXPECT_THROW(fsai.compute(indefinite), std::runtime_error);
+
+    fsai.compute(diagonal(4));
+    EXPECT_THROW(fsai.apply(VectorObj<double>(3, 1.0)), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include "banded.hpp"
+#include "BandObj.hpp"
+#include "SparseObj.hpp"
+#include "VectorObj.hpp"
+#include "TestProblems.hpp"
+#include <cmath>
+#include <random>
+
+class BandedTest : public ::testing::Test {
+protected:
+    // 2D 5-point Laplacian on an m x m grid, with rows/columns numbered by perm
+    SparseMatrixCSC<double> laplacian2D(int m, const std::vector<int>& perm) {
+        const int n = m * m;
+        SparseMatrixCSC<double> A(n, n);
+        for (int j = 0; j < m; ++j) {
+            for (int i = 0; i < m; ++i) {
+                const int idx = perm[i + j * m];
+                A.addValue(idx, idx, 4.0);
+                if (i > 0) A.addValue(idx, perm[i - 1 + j * m], -1.0);
+                if (i < m - 1) A.addValue(idx, perm[i + 1 + j * m], -1.0);
+                if (j > 0) A.addValue(idx, perm[i + (j - 1) * m], -1.0);
+                if (j < m - 1) A.addValue(idx, perm[i + (j + 1) * m], -1.0);
+            }
+        }
+        A.finalize();
+        return A;
+    }
+
+    double residualNorm(const SparseMatrixCSC<double>& A, const VectorObj<double>& x, const VectorObj<double>& b) {
+        return (b - A * x).L2norm();
+    }
+};
+
+TEST_F(BandedTest, ConversionFromSparse) {
+    SparseMatrixCSC<double> A(4, 4);
+    A.addValue(0, 0, 1.0); A.addValue(2, 0, 5.0);
+    A.addValue(1, 1, 2.0); A.addValue(0, 1, 6.0);
+    A.addValue(2, 2, 3.0); A.addValue(3, 3, 4.0);
+    A.finalize();
+
+    const BandObj<double> B(A);
+    EXPECT_EQ(B.getLower(), 2);
+    EXPECT_EQ(B.getUpper(), 1);
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            EXPECT_DOUBLE_EQ(B(i, j), A(i, j));
+        }
+    }
+
+    VectorObj<double> x(4);
+    for (int i = 0; i < 4; ++i) x[i] = i + 1.0;
+    VectorObj<double> y = B * x;
+    VectorObj<double> yRef = A * x;
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_DOUBLE_EQ(y[i], yRef[i]);
+    }
+    BandObj<double> C(A);
+    EXPECT_THROW(C(3, 0) = 1.0, std::out_of_range);
+}
+
+TEST_F(BandedTest, LUSolveWithPivoting) {
+    const int n = 50, kl = 2, ku = 3;
+    std::mt19937 gen(7);
+    std::uniform_real_distribution<> dis(-1.0, 1.0);
+    SparseMatrixCSC<double> A(n, n);
+    for (int j = 0; j < n; ++j) {
+        for (int i = std::max(0, j - ku); i <= std::min(n - 1, j + kl); ++i) {
+            // Small diagonal forces row interchanges
+            A.addValue(i, j, i == j ? 1e-3 : dis(gen));
+        }
+    }
+    A.finalize();
+
+    VectorObj<double> b(n);
+    for (int i = 0; i < n; ++i) b[i] = std::cos(i);
+
+    BandObj<double> LU(A);
+    std::vector<int> P;
+    banded::LU(LU, P);
+    VectorObj<double> x = b;
+    banded::LUSolve(LU, P, x);
+
+    EXPECT_LT(residualNorm(A, x, b), 1e-9);
+    bool pivoted = false;
+    for (int j = 0; j < n; ++j) pivoted = pivoted || P[j] != j;
+    EXPECT_TRUE(pivoted);
+}
+
+TEST_F(BandedTest, SingularMatrix) {
+    BandObj<double> A(3, 1, 1);
+    A(0, 0) = 1.0;
+    A(1, 0) = 1.0;
+    std::vector<int> P;
+    EXPECT_THROW(banded::LU(A, P), std::runtime_error);
+}
+
+TEST_F(BandedTest, CholeskySolve) {
+    const int n = 40;
+    SparseMatrixCSC<double> A = testproblems::poisson1D(n);
+    VectorObj<double> b(n, 1.0);
+
+    BandObj<double> L(A);
+    banded::Cholesky(L);
+    VectorObj<double> x = b;
+    banded::CholeskySolve(L, x);
+
+    EXPECT_LT(residualNorm(A, x, b), 1e-10);
+    // Exact solution of the discrete problem: x_i = (i + 1)(n - i) / 2
+    EXPECT_NEAR(x[0], n / 2.0, 1e-9);
+}
+
+TEST_F(BandedTest, NotPositiveDefinite) {
+    SparseMatrixCSC<double> A = testproblems::poisson1D(5) * -1.0;
+    BandObj<double> L(A);
+    EXPECT_THROW(banded::Cholesky(L), std::runtime_error);
+}
+
+TEST_F(BandedTest, ReverseCuthillMcKee) {
+    const int m = 8, n = m * m;
+    std::vector<int> shuffle(n);
+    for (int i = 0; i < n; ++i) shuffle[i] = i;
+    std::shuffle(shuffle.begin(), shuffle.end(), std::mt19937(3));
+    SparseMatrixCSC<double> A = laplacian2D(m, shuffle);
+
+    std::vector<int> perm = banded::reverseCuthillMcKee(A);
+    BandObj<double> B(A, perm);
+    EXPECT_LE(B.getLower(), 2 * m);
+    EXPECT_LT(B.getLower(), BandObj<double>(A).getLower());
+
+    // Solve the permuted system and map the solution back
+    VectorObj<double> b(n);
+    for (int i = 0; i < n; ++i) b[i] = 1.0 + i % 5;
+    VectorObj<double> bp(n);
+    for (int i = 0; i < n; ++i) bp[i] = b[perm[i]];
+
+    banded::Cholesky(B);
+    banded::CholeskySolve(B, bp);
+    VectorObj<double> x(n);
+    for (int i = 0; i < n; ++i) x[perm[i]] = bp[i];
+
+    EXPECT_LT(residualNorm(A, x, b), 1e-10);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+#include "batched.hpp"
+#include "BatchedDenseObj.hpp"
+#include "DenseObj.hpp"
+#include <random>
+#include <cmath>
+
+class BatchedFactorizationTest : public ::testing::Test {
+protected:
+    // Fill a batch with random, diagonally dominant (optionally symmetric) systems
+    BatchedDenseObj<double> randomBatch(int n, int m, int batch, bool spd = false) {
+        std::mt19937 gen(42);
+        std::uniform_real_distribution<> dis(-1.0, 1.0);
+        BatchedDenseObj<double> A(n, m, batch);
+        for (int k = 0; k < batch; ++k) {
+            for (int j = 0; j < m; ++j) {
+                for (int i = 0; i < n; ++i) {
+                    A(i, j, k) = dis(gen);
+                }
+            }
+            if (spd) {
+                for (int j = 0; j < m; ++j) {
+                    for (int i = 0; i < j; ++i) {
+                        A(i, j, k) = A(j, i, k);
+                    }
+                }
+            }
+            for (int i = 0; i < std::min(n, m); ++i) {
+                A(i, i, k) += n;
+            }
+        }
+        return A;
+    }
+
+    double residual(const DenseObj<double>& A, const BatchedDenseObj<double>& X,
+                    const BatchedDenseObj<double>& B, int k) {
+        double maxErr = 0.0;
+        for (int r = 0; r < B.getCols(); ++r) {
+            for (int i = 0; i < A.getRows(); ++i) {
+                double sum = 0.0;
+                for (int j = 0; j < A.getCols(); ++j) {
+                    sum += A(i, j) * X(j, r, k);
+                }
+                maxErr = std::max(maxErr, std::abs(sum - B(i, r, k)));
+            }
+        }
+        return maxErr;
+    }
+};
+
+TEST_F(BatchedFactorizationTest, LayoutRoundTrip) {
+    BatchedDenseObj<double> A = randomBatch(3, 2, 5);
+    DenseObj<double> M = A.getMatrix(3);
+    EXPECT_DOUBLE_EQ(M(2, 1), A(2, 1, 3));
+    EXPECT_EQ(&A(2, 1, 3), A.lane(2, 1) + 3);
+
+    BatchedDenseObj<double> B(3, 2, 5);
+    B.setMatrix(4, M);
+    EXPECT_DOUBLE_EQ(B(1, 0, 4), M(1, 0));
+    EXPECT_THROW(B(3, 0, 0), std::out_of_range);
+}
+
+TEST_F(BatchedFactorizationTest, LUSolve) {
+    for (int n : {4, 7, 16}) {
+        const int batch = 203;
+        BatchedDenseObj<double> A = randomBatch(n, n, batch);
+        BatchedDenseObj<double> B = randomBatch(n, 2, batch);
+        BatchedDenseObj<double> LU = A;
+        BatchedDenseObj<double> X = B;
+
+        std::vector<int> P;
+        batched::LU(LU, P);
+        batched::LUSolve(LU, P, X);
+
+        for (int k = 0; k < batch; k += 17) {
+            EXPECT_LT(residual(A.getMatrix(k), X, B, k), 1e-10) << "n = " << n << ", system " << k;
+        }
+    }
+}
+
+TEST_F(BatchedFactorizationTest, LUPivoting) {
+    // Zero leading entry forces a row interchange
+    BatchedDenseObj<double> A(2, 2, 3);
+    BatchedDenseObj<double> B(2, 1, 3);
+    for (int k = 0; k < 3; ++k) {
+        A(0, 0, k) = 0.0; A(0, 1, k) = 1.0;
+        A(1, 0, k) = 2.0; A(1, 1, k) = 1.0;
+        B(0, 0, k) = 1.0; B(1, 0, k) = 3.0 + k;
+    }
+    BatchedDenseObj<double> X = B;
+    std::vector<int> P;
+    batched::LU(A, P);
+    batched::LUSolve(A, P, X);
+    for (int k = 0; k < 3; ++k) {
+        EXPECT_NEAR(X(0, 0, k), (2.0 + k) / 2.0, 1e-12);
+        EXPECT_NEAR(X(1, 0, k), 1.0, 1e-12);
+    }
+}
+
+TEST_F(BatchedFactorizationTest, SingularSystem) {
+    BatchedDenseObj<double> A = randomBatch(4, 4, 10);
+    for (int i = 0; i < 4; ++i) {
+        A(i, 2, 6) = 0.0;
+    }
+    std::vector<int> P;
+    EXPECT_THROW(batched::LU(A, P), std::runtime_error);
+}
+
+TEST_F(BatchedFactorizationTest, CholeskySolve) {
+    const int n = 9, batch = 64;
+    BatchedDenseObj<double> A = randomBatch(n, n, batch, true);
+    BatchedDenseObj<double> B = randomBatch(n, 3, batch);
+    BatchedDenseObj<double> L = A;
+    BatchedDenseObj<double> X = B;
+
+    batched::Cholesky(L);
+    batched::CholeskySolve(L, X);
+
+    DenseObj<double> L5 = L.getMatrix(5);
+    EXPECT_DOUBLE_EQ(L5(0, 1), 0.0);
+    DenseObj<double> LLt = L5 * L5.Transpose();
+    DenseObj<double> A5 = A.getMatrix(5);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            EXPECT_NEAR(LLt(i, j), A5(i, j), 1e-10);
+        }
+    }
+    for (int k = 0; k < batch; ++k) {
+        EXPECT_LT(residual(A.getMatrix(k), X, B, k), 1e-10);
+    }
+}
+
+TEST_F(BatchedFactorizationTest, CholeskyNotPositiveDefinite) {
+    BatchedDenseObj<double> A = randomBatch(3, 3, 4, true);
+    A(2, 2, 1) = -100.0;
+    EXPECT_THROW(batched::Cholesky(A), std::runtime_error);
+}
+
+TEST_F(BatchedFactorizationTest, QRLeastSquares) {
+    const int m = 8, n = 5, batch = 40;
+    BatchedDenseObj<double> A = randomBatch(m, n, batch);
+    BatchedDenseObj<double> B = randomBatch(m, 1, batch);
+    BatchedDenseObj<double> QR = A;
+    BatchedDenseObj<double> X = B;
+
+    std::vector<double> tau;
+    batched::QR(QR, tau);
+    batched::QRSolve(QR, tau, X);
+
+    // The least-squares residual is orthogonal to the range of A: A^T (A x - b) = 0
+    for (int k = 0; k < batch; ++k) {
+        DenseObj<double> Ak = A.getMatrix(k);
+        std::vector<double> r(m);
+        for (int i = 0; i < m; ++i) {
+            r[i] = -B(i, 0, k);
+            for (int j = 0; j < n; ++j) {
+                r[i] += Ak(i, j) * X(j, 0, k);
+            }
+        }
+        for (int j = 0; j < n; ++j) {
+            double dot = 0.0;
+            for (int i = 0; i < m; ++i) {
+                dot += Ak(i, j) * r[i];
+            }
+            EXPECT_NEAR(dot, 0.0, 1e-10);
+        }
+    }
+}
+
+TEST_F(BatchedFactorizationTest, DimensionMismatch) {
+    BatchedDenseObj<double> A(3, 4, 2);
+    std::vector<int> P;
+    EXPECT_THROW(batched::LU(A, P), std::invalid_argument);
+
+    BatchedDenseObj<double> S = randomBatch(3, 3, 2);
+    batched::LU(S, P);
+    BatchedDenseObj<double> B(3, 1, 5);
+    EXPECT_THROW(batched::LUSolve(S, P, B), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
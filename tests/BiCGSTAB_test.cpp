@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include "BiCGSTAB.hpp"
+#include "ILU.hpp"
+#include "SparseObj.hpp"
+#include "VectorObj.hpp"
+#include "TestProblems.hpp"
+#include <cmath>
+
+TEST(BiCGSTABTest, ConvergesForSeveralL) {
+    SparseMatrixCSC<double> A = testproblems::upwindConvectionDiffusion(20, 10.0, 10.0);
+    VectorObj<double> b = testproblems::rhs(A.getRows(), 0.2);
+    for (int ell : {1, 2, 4}) {
+        BiCGSTAB<double> solver(ell);
+        VectorObj<double> x(A.getRows(), 0.0);
+        EXPECT_TRUE(solver.solve(A, b, x, 500, 1e-10)) << "l = " << ell;
+        EXPECT_LT((b - A * x).L2norm() / b.L2norm(), 1e-9) << "l = " << ell;
+        EXPECT_EQ(solver.getMatVecs(), 2 * ell * solver.getIterations());
+    }
+}
+
+TEST(BiCGSTABTest, NonzeroInitialGuessAndPreconditioner) {
+    SparseMatrixCSC<double> A = testproblems::upwindConvectionDiffusion(8, 50.0, 50.0);
+    VectorObj<double> b = testproblems::rhs(A.getRows(), 0.2);
+
+    BiCGSTAB<double> plain(2);
+    VectorObj<double> x0(A.getRows(), 1.0);
+    EXPECT_TRUE(plain.solve(A, b, x0, 500, 1e-10));
+
+    ILUPreconditioner<double> ilu;
+    ilu.compute(A);
+    BiCGSTAB<double> solver(2);
+    solver.setPreconditioner(ilu);
+    VectorObj<double> x(A.getRows(), 1.0);
+    EXPECT_TRUE(solver.solve(A, b, x, 500, 1e-10));
+    EXPECT_LT((b - A * x).L2norm() / b.L2norm(), 1e-9);
+    EXPECT_LE(solver.getIterations(), plain.getIterations());
+}
+
+TEST(BiCGSTABTest, InvalidArguments) {
+    EXPECT_THROW(BiCGSTAB<double>(0), std::invalid_argument);
+    SparseMatrixCSC<double> A = testproblems::upwindConvectionDiffusion(3, 1.0, 1.0);
+    VectorObj<double> b = testproblems::rhs(9, 0.2);
+    VectorObj<double> x(4, 0.0);
+    BiCGSTAB<double> solver;
+    EXPECT_THROW(solver.solve(A, b, x, 10, 1e-8), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
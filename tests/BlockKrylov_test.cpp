@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include "BlockCG.hpp"
+#include "BlockGMRES.hpp"
+#include "ConjugateGradient.hpp"
+#include "SparseObj.hpp"
+#include "DenseObj.hpp"
+#include "VectorObj.hpp"
+#include "TestProblems.hpp"
+#include <cmath>
+#include <random>
+
+class BlockKrylovTest : public ::testing::Test {
+protected:
+    DenseObj<double> loadCases(int n, int k) {
+        std::mt19937 gen(11);
+        std::uniform_real_distribution<> dis(-1.0, 1.0);
+        DenseObj<double> B(n, k);
+        for (int j = 0; j < k; ++j) {
+            for (int i = 0; i < n; ++i) B(i, j) = dis(gen);
+        }
+        return B;
+    }
+
+    double maxRelativeResidual(const SparseMatrixCSC<double>& A, const DenseObj<double>& X, const DenseObj<double>& B) {
+        double worst = 0.0;
+        for (int j = 0; j < B.getCols(); ++j) {
+            VectorObj<double> b = B.getColumn(j);
+            worst = std::max(worst, (b - A * X.getColumn(j)).L2norm() / b.L2norm());
+        }
+        return worst;
+    }
+};
+
+TEST_F(BlockKrylovTest, SparseTimesDense) {
+    SparseMatrixCSC<double> A = testproblems::convectionDiffusion(6, 0.3);
+    DenseObj<double> X = loadCases(36, 11);
+    DenseObj<double> Y = A * X;
+    for (int j = 0; j < X.getCols(); ++j) {
+        VectorObj<double> y = A * X.getColumn(j);
+        for (int i = 0; i < 36; ++i) {
+            EXPECT_NEAR(Y(i, j), y[i], 1e-13);
+        }
+    }
+}
+
+TEST_F(BlockKrylovTest, BlockCGMultipleLoadCases) {
+    SparseMatrixCSC<double> A = testproblems::convectionDiffusion(16, 0.0);
+    const int n = A.getRows(), k = 6;
+    DenseObj<double> B = loadCases(n, k);
+    DenseObj<double> X(n, k);
+
+    BlockCG<double> solver;
+    EXPECT_TRUE(solver.solve(A, B, X, 500, 1e-10));
+    EXPECT_LT(maxRelativeResidual(A, X, B), 1e-9);
+
+    // The shared Krylov space needs fewer iterations than a single-vector CG
+    ConjugateGrad<double, SparseMatrixCSC<double>, VectorObj<double>> cg(A, B.getColumn(0), 500, 1e-10);
+    VectorObj<double> x0(n, 0.0);
+    cg.solve(x0);
+    EXPECT_LT(solver.getIterations(), cg.getIterations());
+}
+
+TEST_F(BlockKrylovTest, BlockCGDependentRightHandSides) {
+    SparseMatrixCSC<double> A = testproblems::convectionDiffusion(10, 0.0);
+    const int n = A.getRows();
+    DenseObj<double> B = loadCases(n, 3);
+    // Third load case is a combination of the first two
+    for (int i = 0; i < n; ++i) B(i, 2) = 2.0 * B(i, 0) - B(i, 1);
+    DenseObj<double> X(n, 3);
+
+    BlockCG<double> solver;
+    EXPECT_TRUE(solver.solve(A, B, X, 500, 1e-10));
+    EXPECT_LT(maxRelativeResidual(A, X, B), 1e-9);
+}
+
+TEST_F(BlockKrylovTest, BlockGMRESNonsymmetric) {
+    SparseMatrixCSC<double> A = testproblems::convectionDiffusion(14, 0.4);
+    const int n = A.getRows(), k = 4;
+    DenseObj<double> B = loadCases(n, k);
+    DenseObj<double> X(n, k);
+
+    BlockGMRES<double> solver;
+    EXPECT_TRUE(solver.solve(A, B, X, 50, 30, 1e-10));
+    EXPECT_LT(maxRelativeResidual(A, X, B), 1e-9);
+    for (double r : solver.getResidualNorms()) {
+        EXPECT_GE(r, 0.0);
+    }
+}
+
+TEST_F(BlockKrylovTest, BlockGMRESDenseOperator) {
+    SparseMatrixCSC<double> As = testproblems::convectionDiffusion(5, 0.2);
+    DenseObj<double> A(25, 25);
+    for (int i = 0; i < 25; ++i) {
+        for (int j = 0; j < 25; ++j) A(i, j) = As(i, j);
+    }
+    DenseObj<double> B = loadCases(25, 3);
+    DenseObj<double> X(25, 3);
+
+    BlockGMRES<double, DenseObj<double>> solver;
+    EXPECT_TRUE(solver.solve(A, B, X, 20, 5, 1e-10));
+    EXPECT_LT(maxRelativeResidual(As, X, B), 1e-9);
+}
+
+TEST_F(BlockKrylovTest, DimensionMismatch) {
+    SparseMatrixCSC<double> A = testproblems::convectionDiffusion(4, 0.0);
+    DenseObj<double> B = loadCases(16, 2);
+    DenseObj<double> X(16, 3);
+    BlockCG<double> cg;
+    EXPECT_THROW(cg.solve(A, B, X, 10, 1e-8), std::invalid_argument);
+    BlockGMRES<double> gmres;
+    EXPECT_THROW(gmres.solve(A, B, X, 10, 5, 1e-8), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
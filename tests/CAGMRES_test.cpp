@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include "CAGMRES.hpp"
+#include "MatrixPowers.hpp"
+#include "SparseObj.hpp"
+#include "VectorObj.hpp"
+#include "TestProblems.hpp"
+#include <cmath>
+
+TEST(CAGMRESTest, MatrixPowersMatchesRepeatedSpMV) {
+    SparseMatrixCSC<double> A = testproblems::convectionDiffusion(30, 0.2);
+    const int n = A.getRows(), s = 5;
+    // A small cache budget forces many wavefront blocks
+    MatrixPowers<double> mpk(A, 16 * 1024);
+    ASSERT_EQ(mpk.getBandwidth(), 30);
+    ASSERT_GT(mpk.blockRows(s), 0);
+
+    std::vector<double> alpha = {0.5, 0.25, 0.25, 0.5, 1.0};
+    std::vector<double> theta = {1.0, -2.0, 0.5, 3.0, 0.0};
+    std::vector<double> beta = {0.0, 0.3, -1.0, 2.0, 0.1};
+    DenseObj<double> V(n, s + 1);
+    VectorObj<double> v = testproblems::rhs(n);
+    for (int i = 0; i < n; ++i) V(i, 0) = v[i];
+    mpk.compute(V.data(), n, s, alpha.data(), theta.data(), beta.data());
+
+    VectorObj<double> prev(n, 0.0);
+    for (int j = 0; j < s; ++j) {
+        VectorObj<double> next = (A * v - v * theta[j]) * alpha[j];
+        if (j > 0) next.axpy(-beta[j], prev);
+        for (int i = 0; i < n; ++i) ASSERT_NEAR(V(i, j + 1), next[i], 1e-10 * (1.0 + std::abs(next[i])));
+        prev = v;
+        v = next;
+    }
+}
+
+TEST(CAGMRESTest, ConvergesWithEveryBasis) {
+    SparseMatrixCSC<double> A = testproblems::convectionDiffusion(20, 0.3);
+    VectorObj<double> b = testproblems::rhs(A.getRows());
+    for (auto basis : {Krylov::Basis::Newton, Krylov::Basis::Chebyshev, Krylov::Basis::Monomial}) {
+        CAGMRES<double> solver(basis == Krylov::Basis::Monomial ? 3 : 6, 5, basis);
+        VectorObj<double> x(A.getRows(), 0.0);
+        EXPECT_TRUE(solver.solve(A, b, x, 100, 1e-10));
+        EXPECT_LT((b - A * x).L2norm(), 1e-9 * b.L2norm());
+        EXPECT_LT(solver.getResidualNorm(), 1e-9 * b.L2norm());
+    }
+}
+
+TEST(CAGMRESTest, NewtonBasisMatchesGMRESIterations) {
+    SparseMatrixCSC<double> A = testproblems::convectionDiffusion(16, 0.1);
+    VectorObj<double> b = testproblems::rhs(A.getRows());
+
+    // s = 1 is standard GMRES(t); a larger s with the same restart length
+    // should need about the same number of iterations
+    CAGMRES<double> reference(1, 30);
+    VectorObj<double> x0(A.getRows(), 0.0);
+    ASSERT_TRUE(reference.solve(A, b, x0, 100, 1e-8));
+
+    CAGMRES<double> solver(6, 5, Krylov::Basis::Newton);
+    VectorObj<double> x(A.getRows(), 0.0);
+    ASSERT_TRUE(solver.solve(A, b, x, 100, 1e-8));
+    EXPECT_LE(solver.getIterations(), reference.getIterations() + 30);
+}
+
+TEST(CAGMRESTest, InvalidArguments) {
+    EXPECT_THROW(CAGMRES<double>(0, 4), std::invalid_argument);
+    SparseMatrixCSC<double> A = testproblems::convectionDiffusion(3, 0.1);
+    VectorObj<double> b = testproblems::rhs(A.getRows());
+    VectorObj<double> x(A.getRows(), 0.0);
+    CAGMRES<double> solver(5, 4);
+    EXPECT_THROW(solver.solve(A, b, x, 10, 1e-8), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+#include "Chebyshev.hpp"
+#include "ConjugateGradient.hpp"
+#include "MultiGrid.hpp"
+#include "SparseObj.hpp"
+#include "VectorObj.hpp"
+#include "TestProblems.hpp"
+#include <cmath>
+
+TEST(ChebyshevTest, SpectralEstimates) {
+    const int m = 12;
+    SparseMatrixCSC<double> A = testproblems::poisson2D(m);
+    // Eigenvalues of D^(-1) A: 1 - (cos(i pi h) + cos(j pi h)) / 2
+    const double h = M_PI / (m + 1);
+    const double lambdaMin = 1.0 - std::cos(h);
+    const double lambdaMax = 1.0 + std::cos(h);
+
+    SpectralInterval<double> interval = chebyshev::lanczosInterval(A, 40);
+    EXPECT_NEAR(interval.lambdaMax, lambdaMax, 1e-3);
+    EXPECT_NEAR(interval.lambdaMin, lambdaMin, 1e-2);
+    EXPECT_GE(interval.lambdaMin, lambdaMin - 1e-12);
+    EXPECT_LE(interval.lambdaMax, lambdaMax + 1e-12);
+
+    const double power = chebyshev::estimateLargestEigenvalue(A, 30);
+    EXPECT_LE(power, lambdaMax + 1e-12);
+    EXPECT_GT(power, 0.9 * lambdaMax);
+}
+
+TEST(ChebyshevTest, SolverConverges) {
+    SparseMatrixCSC<double> A = testproblems::poisson2D(12);
+    VectorObj<double> b = testproblems::rhs(A.getRows());
+    VectorObj<double> x(A.getRows(), 0.0);
+
+    ChebyshevSolver<double> solver;
+    EXPECT_TRUE(solver.solve(A, b, x, 2000, 1e-8));
+    EXPECT_LT((b - A * x).L2norm(), 1e-8 * b.L2norm());
+    EXPECT_EQ(solver.getIterations() % 10, 0);  // Residual only checked every 10 steps
+}
+
+TEST(ChebyshevTest, SolverReestimatesIntervalPerMatrix) {
+    // D^(-1) A lies in about [0.5, 1.5] for the shifted operator and in (0, 2) for the Laplacian
+    SparseMatrixCSC<double> shifted = testproblems::convectionDiffusion(12, 0.0, 4.0);
+    SparseMatrixCSC<double> A = testproblems::poisson2D(12);
+    VectorObj<double> b = testproblems::rhs(A.getRows());
+
+    ChebyshevSolver<double> solver;
+    VectorObj<double> x0(A.getRows(), 0.0);
+    ASSERT_TRUE(solver.solve(shifted, b, x0, 2000, 1e-8));
+    const double firstMax = solver.getInterval().lambdaMax;
+
+    VectorObj<double> x(A.getRows(), 0.0);
+    EXPECT_TRUE(solver.solve(A, b, x, 2000, 1e-8));
+    EXPECT_LT((b - A * x).L2norm(), 1e-8 * b.L2norm());
+    EXPECT_GT(solver.getInterval().lambdaMax, firstMax);
+}
+
+TEST(ChebyshevTest, PolynomialPreconditionerForCG) {
+    SparseMatrixCSC<double> A = testproblems::poisson2D(16);
+    VectorObj<double> b = testproblems::rhs(A.getRows());
+
+    ConjugateGrad<double, SparseMatrixCSC<double>, VectorObj<double>> plain(A, b, 1000, 1e-10);
+    VectorObj<double> x0(A.getRows());
+    ASSERT_TRUE(plain.solve(x0));
+
+    ChebyshevPreconditioner<double> M(A, 4);
+    ConjugateGrad<double, SparseMatrixCSC<double>, VectorObj<double>> pcg(A, b, 1000, 1e-10);
+    pcg.setPreconditioner(M);
+    VectorObj<double> x(A.getRows());
+    ASSERT_TRUE(pcg.solve(x));
+    EXPECT_LT((b - A * x).L2norm(), 1e-9 * b.L2norm());
+    EXPECT_LT(pcg.getIterations(), plain.getIterations());
+}
+
+TEST(ChebyshevTest, SmootherDampsHighFrequencies) {
+    const int m = 16, n = m * m;
+    SparseMatrixCSC<double> A = testproblems::poisson2D(m);
+    ChebyshevSmoother<double> smoother(A, 3);
+    // Error reduction of the eigenmode sin(k pi x) sin(k pi y) after one smoothing call with b = 0
+    auto reduction = [&](int k) {
+        VectorObj<double> e(n);
+        for (int j = 0; j < m; ++j) {
+            for (int i = 0; i < m; ++i) e[i + m * j] = std::sin(k * M_PI * (i + 1) / (m + 1)) * std::sin(k * M_PI * (j + 1) / (m + 1));
+        }
+        VectorObj<double> zero(n, 0.0), x = e;
+        smoother.smooth(zero, x);
+        return x.L2norm() / e.L2norm();
+    };
+    // Degree 3 on [lambdaMax / 30, lambdaMax] guarantees a factor 1 / T_3(1.069) ~ 0.6
+    EXPECT_LT(reduction(16), 0.65);
+    EXPECT_LT(reduction(12), 0.65);
+    EXPECT_GT(reduction(1), 0.8);
+}
+
+TEST(ChebyshevTest, AMGWithChebyshevSmoother) {
+    SparseMatrixCSC<double> A = testproblems::poisson2D(16);
+    VectorObj<double> b = testproblems::rhs(A.getRows());
+    AlgebraicMultiGrid<double, VectorObj<double>> amg;
+    amg.setSmoother(AMGSmoother::Chebyshev, 3);
+
+    auto residual = [&](int levels) {
+        VectorObj<double> x(A.getRows(), 0.0);
+        for (int cycle = 0; cycle < 5; ++cycle) amg.amgVCycle(A, b, x, levels, 1, 0.25);
+        return (b - A * x).L2norm() / b.L2norm();
+    };
+    const double smoothingOnly = residual(1);
+    const double threeLevels = residual(3);
+    ASSERT_EQ(amg.getNumLevels(), 3);
+    EXPECT_LT(amg.getLevelSize(2), amg.getLevelSize(1));
+    EXPECT_LT(amg.getLevelSize(1), A.getRows());
+    EXPECT_LT(threeLevels, 0.1);
+    EXPECT_LT(threeLevels, 0.3 * smoothingOnly);
+}
+
+TEST(ChebyshevTest, InvalidInterval) {
+    SparseMatrixCSC<double> A = testproblems::poisson2D(4);
+    ChebyshevSolver<double> solver;
+    solver.setInterval(2.0, 1.0);
+    VectorObj<double> b = testproblems::rhs(A.getRows()), x(A.getRows(), 0.0);
+    EXPECT_THROW(solver.solve(A, b, x, 10, 1e-8), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -124,6 +124,22 @@ TEST_F(CholeskyTest, LargeMatrixTest) {
     }
 }
 
+TEST_F(CholeskyTest, FactorizeView) {
+    DenseObj<double> big(5, 5);
+    big.view(2, 1, 3, 3).assign(spd_matrix.view(0, 0, 3, 3));
+    const DenseObj<double>& cbig = big;
+
+    DenseObj<double> L, Lref;
+    basic::Cholesky(cbig.view(2, 1, 3, 3), L);
+    basic::Cholesky(spd_matrix, Lref);
+
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            EXPECT_NEAR(L(i, j), Lref(i, j), 1e-12);
+        }
+    }
+}
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -2,6 +2,9 @@
 #include "ConjugateGradient.hpp"
 #include "SparseObj.hpp"
 #include "VectorObj.hpp"
+#include "Preconditioner.hpp"
+#include "TestProblems.hpp"
+#include <cmath>
 
 // Test fixture for Conjugate Gradient
 class ConjugateGradientTest : public ::testing::Test {
@@ -99,6 +102,85 @@ TEST_F(ConjugateGradientTest, SingleIteration) {
     EXPECT_GT(std::abs(rhs[0] - matrix(0, 0) * solution[0]), 1e-6);
 }
 
+TEST(PreconditionedCGTest, StopsOnRelativeResidual) {
+    const int n = 200;
+    SparseMatrixCSC<double> A = testproblems::poisson1D(n, 1e-2);
+    VectorObj<double> b(n, 1.0);
+    ConjugateGrad<double, SparseMatrixCSC<double>, VectorObj<double>> cg(A, b, 10000, 1e-8);
+
+    VectorObj<double> x(n, 0.0);
+    EXPECT_TRUE(cg.solve(x));
+    EXPECT_LT(cg.getIterations(), n);
+    EXPECT_LE(cg.getResidualNorm(), 1e-8 * b.L2norm());
+    EXPECT_LE((b - A * x).L2norm(), 1e-7 * b.L2norm());
+}
+
+TEST(PreconditionedCGTest, JacobiPreconditioner) {
+    // Badly scaled diagonal: Jacobi restores the conditioning of the Laplacian
+    const int n = 100;
+    SparseMatrixCSC<double> A(n, n);
+    for (int i = 0; i < n; ++i) {
+        const double s = std::pow(10.0, (i % 5));
+        A.addValue(i, i, 3.0 * s);
+        if (i > 0) A.addValue(i, i - 1, -std::sqrt(s * std::pow(10.0, (i - 1) % 5)));
+        if (i < n - 1) A.addValue(i, i + 1, -std::sqrt(s * std::pow(10.0, (i + 1) % 5)));
+    }
+    A.finalize();
+    VectorObj<double> b(n, 1.0);
+
+    ConjugateGrad<double, SparseMatrixCSC<double>, VectorObj<double>> plain(A, b, 10000, 1e-10);
+    VectorObj<double> x0(n, 0.0);
+    EXPECT_TRUE(plain.solve(x0));
+
+    FunctionPreconditioner<double> jacobi([&](const VectorObj<double>& r) {
+        VectorObj<double> z(r.size());
+        for (size_t i = 0; i < r.size(); ++i) z[i] = r[i] / A(i, i);
+        return z;
+    });
+    ConjugateGrad<double, SparseMatrixCSC<double>, VectorObj<double>> pcg(A, b, 10000, 1e-10);
+    pcg.setPreconditioner(jacobi);
+    pcg.setResidualReplacement(20);
+    VectorObj<double> x(n, 0.0);
+    EXPECT_TRUE(pcg.solve(x));
+    EXPECT_LT(pcg.getIterations(), plain.getIterations());
+    EXPECT_LE((b - A * x).L2norm(), 1e-9 * b.L2norm());
+}
+
+TEST(PreconditionedCGTest, AbsoluteAndEnergyNormCriteria) {
+    const int n = 200;
+    SparseMatrixCSC<double> A = testproblems::poisson1D(n, 1e-2);
+    VectorObj<double> b(n, 1.0);
+
+    ConjugateGrad<double, SparseMatrixCSC<double>, VectorObj<double>> absolute(A, b, 10000, 1e-6);
+    absolute.setStoppingCriterion(Krylov::StoppingCriterion::Absolute);
+    VectorObj<double> xa(n, 0.0);
+    EXPECT_TRUE(absolute.solve(xa));
+    EXPECT_LE(absolute.getResidualNorm(), 1e-6);
+
+    // Reference solution to measure the actual error in the A-norm
+    ConjugateGrad<double, SparseMatrixCSC<double>, VectorObj<double>> exact(A, b, 10000, 1e-14);
+    VectorObj<double> xs(n, 0.0);
+    exact.solve(xs);
+
+    ConjugateGrad<double, SparseMatrixCSC<double>, VectorObj<double>> energy(A, b, 10000, 1e-4);
+    energy.setStoppingCriterion(Krylov::StoppingCriterion::EnergyNorm, 10);
+    VectorObj<double> xe(n, 0.0);
+    EXPECT_TRUE(energy.solve(xe));
+    VectorObj<double> e = xe - xs;
+    const double errA = std::sqrt(e * (A * e));
+    const double solA = std::sqrt(xs * (A * xs));
+    EXPECT_LT(errA, 1e-3 * solA);
+    EXPECT_LT(energy.getIterations(), exact.getIterations());
+}
+
+TEST(PreconditionedCGTest, NotPositiveDefinite) {
+    SparseMatrixCSC<double> A = testproblems::poisson1D(10, 1e-2) * -1.0;
+    VectorObj<double> b(10, 1.0);
+    ConjugateGrad<double, SparseMatrixCSC<double>, VectorObj<double>> cg(A, b, 100, 1e-8);
+    VectorObj<double> x(10, 0.0);
+    EXPECT_THROW(cg.solve(x), std::runtime_error);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
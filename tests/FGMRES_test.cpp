@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+#include "FGMRES.hpp"
+#include "GMRES.hpp"
+#include "ILU.hpp"
+#include "MultiGrid.hpp"
+#include "Preconditioner.hpp"
+#include "SparseObj.hpp"
+#include "VectorObj.hpp"
+#include "TestProblems.hpp"
+#include <cmath>
+
+TEST(FGMRESTest, Unpreconditioned) {
+    SparseMatrixCSC<double> A = testproblems::convectionDiffusion(12, 0.3);
+    VectorObj<double> b = testproblems::rhs(A.getRows());
+    VectorObj<double> x(A.getRows(), 0.0);
+
+    FGMRES<double> solver;
+    EXPECT_TRUE(solver.solve(A, b, x, 200, 30, 1e-10));
+    EXPECT_LT((b - A * x).L2norm(), 1e-9);
+    EXPECT_LT(solver.getResidualNorm(), 1e-10);
+}
+
+TEST(FGMRESTest, ILURightPreconditioning) {
+    SparseMatrixCSC<double> A = testproblems::convectionDiffusion(8, 0.3);
+    VectorObj<double> b = testproblems::rhs(A.getRows());
+
+    FGMRES<double> plain;
+    VectorObj<double> x0(A.getRows(), 0.0);
+    plain.solve(A, b, x0, 200, 20, 1e-10);
+
+    ILUPreconditioner<double> ilu;
+    ilu.compute(A);
+    FGMRES<double> solver;
+    solver.setPreconditioner(ilu);
+    VectorObj<double> x(A.getRows(), 0.0);
+    EXPECT_TRUE(solver.solve(A, b, x, 200, 20, 1e-10));
+    EXPECT_LT((b - A * x).L2norm(), 1e-9);
+    EXPECT_LE(solver.getIterations(), plain.getIterations());
+}
+
+TEST(FGMRESTest, AMGVCyclePreconditioner) {
+    SparseMatrixCSC<double> A = testproblems::convectionDiffusion(10, 0.0);
+    VectorObj<double> b = testproblems::rhs(A.getRows());
+    VectorObj<double> x(A.getRows(), 0.0);
+
+    AMGPreconditioner<double, VectorObj<double>> amg(A, 2, 2, 0.25);
+    ASSERT_EQ(amg.getHierarchy().getNumLevels(), 2);
+    EXPECT_LT(amg.getHierarchy().getLevelSize(1), A.getRows() / 2 + 1);
+    FGMRES<double> solver;
+    solver.setPreconditioner(amg);
+    EXPECT_TRUE(solver.solve(A, b, x, 100, 30, 1e-10));
+    EXPECT_LT((b - A * x).L2norm(), 1e-9);
+
+    // The coarse-grid correction saves iterations over the smoother alone
+    AMGPreconditioner<double, VectorObj<double>> smootherOnly(A, 1, 2, 0.25);
+    FGMRES<double> reference;
+    reference.setPreconditioner(smootherOnly);
+    VectorObj<double> y(A.getRows(), 0.0);
+    EXPECT_TRUE(reference.solve(A, b, y, 100, 30, 1e-10));
+    EXPECT_LT(solver.getIterations(), reference.getIterations());
+}
+
+TEST(FGMRESTest, VariableInnerSolvePreconditioner) {
+    SparseMatrixCSC<double> A = testproblems::convectionDiffusion(10, 0.2);
+    VectorObj<double> b = testproblems::rhs(A.getRows());
+    VectorObj<double> x(A.getRows(), 0.0);
+
+    // A few inner FGMRES steps with a loose tolerance: a different operator on every call
+    int calls = 0;
+    FunctionPreconditioner<double> inner([&](const VectorObj<double>& r) {
+        ++calls;
+        VectorObj<double> z(r.size(), 0.0);
+        FGMRES<double> innerSolver;
+        innerSolver.solve(A, r, z, 1, 3 + calls % 4, 1e-2 * r.L2norm());
+        return z;
+    });
+    FGMRES<double> solver;
+    solver.setPreconditioner(inner);
+    EXPECT_TRUE(solver.solve(A, b, x, 50, 20, 1e-10));
+    EXPECT_LT((b - A * x).L2norm(), 1e-9);
+    EXPECT_EQ(calls, solver.getIterations());
+}
+
+TEST(FGMRESTest, DimensionMismatch) {
+    SparseMatrixCSC<double> A = testproblems::convectionDiffusion(4, 0.0);
+    VectorObj<double> b = testproblems::rhs(A.getRows());
+    VectorObj<double> x(3, 0.0);
+    FGMRES<double> solver;
+    EXPECT_THROW(solver.solve(A, b, x, 10, 5, 1e-10), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
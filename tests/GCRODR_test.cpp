@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+#include "GCRODR.hpp"
+#include "SparseObj.hpp"
+#include "VectorObj.hpp"
+#include "TestProblems.hpp"
+#include <cmath>
+
+TEST(GCRODRTest, SingleSystem) {
+    SparseMatrixCSC<double> A = testproblems::convectionDiffusion(12, 0.2, 0.0);
+    VectorObj<double> b = testproblems::rhs(A.getRows(), 0.3, 0.0);
+    VectorObj<double> x(A.getRows(), 0.0);
+
+    GCRODR<double> solver(20, 5);
+    EXPECT_TRUE(solver.solve(A, b, x, 200, 1e-10));
+    EXPECT_LT((b - A * x).L2norm(), 1e-9 * b.L2norm());
+    EXPECT_TRUE(solver.hasRecycleSpace());
+    EXPECT_EQ(solver.getRecycleDimension(), 5);
+}
+
+TEST(GCRODRTest, RecyclingReducesIterationsOverSequence) {
+    const int m = 14;
+    GCRODR<double> recycled(20, 6);
+    GCRODR<double> fresh(20, 6);
+    int recycledTotal = 0, freshTotal = 0;
+    for (int step = 0; step < 5; ++step) {
+        // Slowly changing operator and right-hand side, as in a time loop
+        SparseMatrixCSC<double> A = testproblems::convectionDiffusion(m, 0.2, 0.01 * step);
+        VectorObj<double> b = testproblems::rhs(A.getRows(), 0.3, 0.1 * step);
+
+        VectorObj<double> x1(A.getRows(), 0.0);
+        ASSERT_TRUE(recycled.solve(A, b, x1, 200, 1e-9));
+        EXPECT_LT((b - A * x1).L2norm(), 1e-8 * b.L2norm());
+
+        fresh.invalidate();
+        VectorObj<double> x2(A.getRows(), 0.0);
+        ASSERT_TRUE(fresh.solve(A, b, x2, 200, 1e-9));
+
+        if (step > 0) {
+            recycledTotal += recycled.getIterations();
+            freshTotal += fresh.getIterations();
+        }
+    }
+    EXPECT_LT(recycledTotal, freshTotal);
+}
+
+TEST(GCRODRTest, InvalidateDropsRecycleSpace) {
+    SparseMatrixCSC<double> A = testproblems::convectionDiffusion(10, 0.1, 0.0);
+    VectorObj<double> b = testproblems::rhs(A.getRows(), 0.3, 0.0);
+
+    GCRODR<double> solver(15, 4);
+    VectorObj<double> x(A.getRows(), 0.0);
+    solver.solve(A, b, x, 200, 1e-10);
+    const int first = solver.getIterations();
+    ASSERT_TRUE(solver.hasRecycleSpace());
+
+    solver.invalidate();
+    EXPECT_FALSE(solver.hasRecycleSpace());
+    VectorObj<double> x2(A.getRows(), 0.0);
+    solver.solve(A, b, x2, 200, 1e-10);
+    EXPECT_EQ(solver.getIterations(), first);
+}
+
+TEST(GCRODRTest, RecycleSpaceOfOtherSizeIsDiscarded) {
+    GCRODR<double> solver(10, 3);
+    SparseMatrixCSC<double> A1 = testproblems::convectionDiffusion(6, 0.1, 0.0);
+    VectorObj<double> x1(A1.getRows(), 0.0);
+    solver.solve(A1, testproblems::rhs(A1.getRows(), 0.3, 0.0), x1, 100, 1e-10);
+
+    SparseMatrixCSC<double> A2 = testproblems::convectionDiffusion(7, 0.1, 0.0);
+    VectorObj<double> b2 = testproblems::rhs(A2.getRows(), 0.3, 0.0);
+    VectorObj<double> x2(A2.getRows(), 0.0);
+    EXPECT_TRUE(solver.solve(A2, b2, x2, 100, 1e-10));
+    EXPECT_LT((b2 - A2 * x2).L2norm(), 1e-9 * b2.L2norm());
+}
+
+TEST(GCRODRTest, InvalidParameters) {
+    EXPECT_THROW(GCRODR<double>(5, 5), std::invalid_argument);
+    EXPECT_THROW(GCRODR<double>(5, 0), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
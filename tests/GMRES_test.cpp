@@ -91,6 +91,30 @@ TEST_F(GMRESTest, KrylovDimensionTest) {
     }
 }
 
+TEST_F(GMRESTest, OrthogonalizationVariants) {
+    // Nonsymmetric convection-diffusion matrix, restarted well below n
+    const int n = 200;
+    SparseMatrixCSC<double> A(n, n);
+    for (int i = 0; i < n; ++i) {
+        A.addValue(i, i, 4.0);
+        if (i > 0) A.addValue(i, i - 1, -1.5);
+        if (i < n - 1) A.addValue(i, i + 1, -0.5);
+        if (i + 10 < n) A.addValue(i, i + 10, -0.25);
+    }
+    A.finalize();
+    VectorObj<double> rhs(n);
+    for (int i = 0; i < n; ++i) rhs[i] = std::sin(0.1 * i) + 1.0;
+
+    for (auto method : {Krylov::Orthogonalization::MGS, Krylov::Orthogonalization::CGS2,
+                        Krylov::Orthogonalization::LowSync}) {
+        GMRES<double, SparseMatrixCSC<double>> sparseSolver;
+        sparseSolver.setOrthogonalization(method);
+        VectorObj<double> x_test(n, 0.0);
+        sparseSolver.solve(A, rhs, x_test, 100, 20, 1e-10);
+        EXPECT_LT((rhs - A * x_test).L2norm(), 1e-8);
+    }
+}
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "IC.hpp"
+#include "ILU.hpp"
+#include "ConjugateGradient.hpp"
+#include "SparseObj.hpp"
+#include "VectorObj.hpp"
+#include "TestProblems.hpp"
+#include <cmath>
+
+class ICTest : public ::testing::Test {
+protected:
+    int cgIterations(const SparseMatrixCSC<double>& A, Preconditioner<double>* M) {
+        VectorObj<double> b = testproblems::rhs(A.getRows());
+        ConjugateGrad<double, SparseMatrixCSC<double>, VectorObj<double>> cg(A, b, 1000, 1e-10);
+        if (M) cg.setPreconditioner(*M);
+        VectorObj<double> x;
+        EXPECT_TRUE(cg.solve(x));
+        EXPECT_LT((b - A * x).L2norm(), 1e-9 * b.L2norm());
+        return cg.getIterations();
+    }
+};
+
+// Without fill in the elimination (tridiagonal) IC(0) is the exact Cholesky factorization
+TEST_F(ICTest, ExactForTridiagonal) {
+    const int n = 50;
+    SparseMatrixCSC<double> A(n, n);
+    for (int i = 0; i < n; ++i) {
+        A.addValue(i, i, 2.5);
+        if (i > 0) A.addValue(i, i - 1, -1.0);
+        if (i < n - 1) A.addValue(i, i + 1, -1.0);
+    }
+    A.finalize();
+    ICPreconditioner<double> ic;
+    ic.compute(A);
+    VectorObj<double> b = testproblems::rhs(n);
+    EXPECT_LT((A * ic.solve(b) - b).L2norm(), 1e-12 * b.L2norm());
+}
+
+// IC(0) keeps the lower triangle of A and matches the symmetric ILU(0) with half the storage
+TEST_F(ICTest, MatchesILU0WithHalfTheStorage) {
+    SparseMatrixCSC<double> A = testproblems::poisson2D(20);
+    const int n = A.getRows();
+    ICPreconditioner<double> ic;
+    ic.compute(A);
+    ILUPreconditioner<double> ilu;
+    ilu.compute(A);
+
+    EXPECT_EQ(ic.getNonZeros(), (A.values.size() + n) / 2);
+    EXPECT_LT(ic.getNonZeros(), ilu.getNonZeros() / 2 + 1);
+    VectorObj<double> b = testproblems::rhs(n);
+    const VectorObj<double> reference = ilu.solve(b);
+    EXPECT_LT((ic.solve(b) - reference).L2norm(), 1e-12 * reference.L2norm());
+}
+
+// IC(0) and ICT accelerate CG; more fill means fewer iterations
+TEST_F(ICTest, PreconditionsCG) {
+    SparseMatrixCSC<double> A = testproblems::poisson2D(40, 0.1);
+    const int plain = cgIterations(A, nullptr);
+
+    ICPreconditioner<double> ic0;
+    ic0.compute(A);
+    const int ic0Iterations = cgIterations(A, &ic0);
+
+    ICPreconditioner<double> ict(1e-3, 20);
+    ict.compute(A);
+    const int ictIterations = cgIterations(A, &ict);
+
+    EXPECT_LT(ic0Iterations, plain / 2);
+    EXPECT_GT(ict.getNonZeros(), ic0.getNonZeros());
+    EXPECT_LT(ictIterations, ic0Iterations);
+}
+
+// The fill limit bounds the number of entries per column
+TEST_F(ICTest, FillLimit) {
+    SparseMatrixCSC<double> A = testproblems::poisson2D(30);
+    const int n = A.getRows();
+    ICPreconditioner<double> ict(1e-8, 4);
+    ict.compute(A);
+    EXPECT_LE(ict.getNonZeros(), static_cast<size_t>(n) * 5);
+}
+
+// A shifted factorization still preconditions CG; indefinite matrices are rejected
+TEST_F(ICTest, DiagonalShift) {
+    SparseMatrixCSC<double> A = testproblems::poisson2D(20);
+    ICPreconditioner<double> shifted(0.0, 0, 0.1);
+    shifted.compute(A);
+    EXPECT_DOUBLE_EQ(shifted.getShift(), 0.1);
+    cgIterations(A, &shifted);
+
+    SparseMatrixCSC<double> indefinite(2, 2);
+    indefinite.addValue(0, 0, 1.0);
+    indefinite.addValue(1, 1, -1.0);
+    indefinite.finalize();
+    ICPreconditioner<double> ic;
+    EXPECT_THROW(ic.compute(indefinite), std::runtime_error);
+}
+
+TEST_F(ICTest, InvalidArguments) {
+    EXPECT_THROW(ICPreconditioner<double>(-1.0), std::invalid_argument);
+    EXPECT_THROW(ICPreconditioner<double>(0.0, -1), std::invalid_argument);
+    EXPECT_THROW(ICPreconditioner<double>(0.0, 0, -0.5), std::invalid_argument);
+    ICPreconditioner<double> ic;
+    EXPECT_THROW(ic.solve(VectorObj<double>(3, 1.0)), std::runtime_error);
+}
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
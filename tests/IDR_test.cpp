@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include "IDR.hpp"
+#include "ILU.hpp"
+#include "SparseObj.hpp"
+#include "VectorObj.hpp"
+#include "TestProblems.hpp"
+#include <cmath>
+
+TEST(IDRTest, ConvergesForSeveralS) {
+    SparseMatrixCSC<double> A = testproblems::upwindConvectionDiffusion(20, 10.0, 10.0);
+    VectorObj<double> b = testproblems::rhs(A.getRows(), 0.2);
+    int previous = 1 << 30;
+    for (int s : {1, 4, 8}) {
+        IDR<double> solver(s);
+        VectorObj<double> x(A.getRows(), 0.0);
+        EXPECT_TRUE(solver.solve(A, b, x, 2000, 1e-10)) << "s = " << s;
+        EXPECT_LT((b - A * x).L2norm() / b.L2norm(), 1e-8) << "s = " << s;
+        // Larger shadow spaces need fewer SpMVs
+        EXPECT_LE(solver.getIterations(), previous + 10) << "s = " << s;
+        previous = solver.getIterations();
+    }
+}
+
+TEST(IDRTest, Preconditioned) {
+    SparseMatrixCSC<double> A = testproblems::upwindConvectionDiffusion(8, 50.0, 50.0);
+    VectorObj<double> b = testproblems::rhs(A.getRows(), 0.2);
+
+    IDR<double> plain(4);
+    VectorObj<double> x0(A.getRows(), 0.0);
+    EXPECT_TRUE(plain.solve(A, b, x0, 2000, 1e-10));
+
+    ILUPreconditioner<double> ilu;
+    ilu.compute(A);
+    IDR<double> solver(4);
+    solver.setPreconditioner(ilu);
+    VectorObj<double> x(A.getRows(), 0.0);
+    EXPECT_TRUE(solver.solve(A, b, x, 2000, 1e-10));
+    EXPECT_LT((b - A * x).L2norm() / b.L2norm(), 1e-8);
+    EXPECT_LE(solver.getIterations(), plain.getIterations());
+}
+
+TEST(IDRTest, InvalidArguments) {
+    EXPECT_THROW(IDR<double>(0), std::invalid_argument);
+    SparseMatrixCSC<double> A = testproblems::upwindConvectionDiffusion(2, 1.0, 1.0);
+    VectorObj<double> b = testproblems::rhs(4, 0.2);
+    VectorObj<double> x(4, 0.0);
+    IDR<double> solver(8);
+    EXPECT_THROW(solver.solve(A, b, x, 10, 1e-8), std::invalid_argument);
+}
+
+TEST(IDRTest, SkewSymmetricBreakdown) {
+    // Rotation blocks: t = A r is exactly orthogonal to r in the dimension reduction step
+    SparseMatrixCSC<double> A(4, 4);
+    A.addValue(0, 1, 1.0);
+    A.addValue(1, 0, -1.0);
+    A.addValue(2, 3, 2.0);
+    A.addValue(3, 2, -2.0);
+    A.finalize();
+    VectorObj<double> b = testproblems::rhs(4, 0.2);
+    VectorObj<double> x(4, 0.0);
+    IDR<double> solver(1);
+    EXPECT_THROW(solver.solve(A, b, x, 100, 1e-10), std::runtime_error);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
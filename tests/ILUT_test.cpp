@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include "ILUT.hpp"
+#include "ILU.hpp"
+#include "FGMRES.hpp"
+#include "SparseObj.hpp"
+#include "VectorObj.hpp"
+#include "TestProblems.hpp"
+#include <cmath>
+
+class ILUTTest : public ::testing::Test {
+protected:
+    int fgmresIterations(const SparseMatrixCSC<double>& A, Preconditioner<double>& M) {
+        VectorObj<double> b = testproblems::rhs(A.getRows());
+        VectorObj<double> x(A.getRows(), 0.0);
+        FGMRES<double> solver;
+        solver.setPreconditioner(M);
+        EXPECT_TRUE(solver.solve(A, b, x, 50, 30, 1e-10));
+        EXPECT_LT((b - A * x).L2norm(), 1e-8);
+        return solver.getIterations();
+    }
+};
+
+// A tiny drop tolerance with unlimited fill reproduces the exact LU factors
+TEST_F(ILUTTest, NoDroppingIsExact) {
+    SparseMatrixCSC<double> A = testproblems::upwindConvectionDiffusion(6, 2.0, 2.0);
+    ILUTPreconditioner<double> ilut(0.0, A.getRows());
+    ilut.compute(A);
+    VectorObj<double> b = testproblems::rhs(A.getRows());
+    EXPECT_LT((A * ilut.solve(b) - b).L2norm(), 1e-10 * b.L2norm());
+}
+
+// The fill limit bounds the memory footprint at n (2p + 1) entries
+TEST_F(ILUTTest, FillBoundsMemory) {
+    SparseMatrixCSC<double> A = testproblems::upwindConvectionDiffusion(30, 5.0, 5.0);
+    const int n = A.getRows();
+    for (int p : {1, 3, 8}) {
+        ILUTPreconditioner<double> ilut(0.0, p);
+        ilut.compute(A);
+        EXPECT_LE(ilut.getNonZeros(), static_cast<size_t>(n) * (2 * p + 1));
+    }
+}
+
+// More fill buys fewer iterations; ILUT beats ILU(0) on a convection-dominated problem
+TEST_F(ILUTTest, FillTradesAgainstIterations) {
+    SparseMatrixCSC<double> A = testproblems::upwindConvectionDiffusion(30, 10.0, 10.0);
+    ILUPreconditioner<double> ilu0;
+    ilu0.compute(A);
+    const int ilu0Iterations = fgmresIterations(A, ilu0);
+
+    ILUTPreconditioner<double> sparse(1e-2, 2), dense(1e-4, 15);
+    sparse.compute(A);
+    dense.compute(A);
+    const int sparseIterations = fgmresIterations(A, sparse);
+    const int denseIterations = fgmresIterations(A, dense);
+    EXPECT_GT(dense.getNonZeros(), sparse.getNonZeros());
+    EXPECT_LT(denseIterations, sparseIterations);
+    EXPECT_LT(denseIterations, ilu0Iterations);
+}
+
+// A zero diagonal breaks ILU(0) but column pivoting recovers
+TEST_F(ILUTTest, PivotingHandlesZeroDiagonal) {
+    // Cyclic shift of a diagonally dominant matrix: row i has its large entry in column i+1
+    const int n = 50;
+    SparseMatrixCSC<double> A(n, n);
+    for (int i = 0; i < n; ++i) {
+        A.addValue(i, (i + 1) % n, 4.0);
+        A.addValue(i, (i + 2) % n, -1.0);
+        A.addValue(i, i % n == 0 ? n - 1 : i - 1, 0.5);
+    }
+    A.finalize();
+
+    ILUPreconditioner<double> ilu0;
+    EXPECT_THROW(ilu0.compute(A), std::runtime_error);
+
+    ILUTPreconditioner<double> ilutp(1e-6, 20, 0.5);
+    ilutp.compute(A);
+    VectorObj<double> b = testproblems::rhs(n);
+    VectorObj<double> x = ilutp.solve(b);
+    EXPECT_LT((A * x - b).L2norm(), 1e-3 * b.L2norm());
+    const std::vector<int>& perm = ilutp.getPermutation();
+    EXPECT_NE(perm[0], 0);
+}
+
+TEST_F(ILUTTest, InvalidArguments) {
+    EXPECT_THROW(ILUTPreconditioner<double>(-1.0, 5), std::invalid_argument);
+    EXPECT_THROW(ILUTPreconditioner<double>(1e-3, -1), std::invalid_argument);
+    EXPECT_THROW(ILUTPreconditioner<double>(1e-3, 5, 2.0), std::invalid_argument);
+    ILUTPreconditioner<double> ilut;
+    EXPECT_THROW(ilut.solve(VectorObj<double>(3, 1.0)), std::runtime_error);
+    SparseMatrixCSC<double> nonsquare(3, 4);
+    EXPECT_THROW(ilut.compute(nonsquare), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
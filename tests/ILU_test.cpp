@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include "ILU.hpp"
+#include "DenseObj.hpp"
+#include "TestProblems.hpp"
 #include <cmath>
 
 class ILUTest : public ::testing::Test {
@@ -151,6 +153,65 @@ TEST_F(ILUTest, SolveWrongSize) {
     EXPECT_THROW(ilu.solve(b), std::invalid_argument);
 }
 
+// ILU(0) keeps exactly the pattern of A; higher levels add fill and approximate A better
+TEST_F(ILUTest, LevelOfFill) {
+    const int m = 20, n = m * m;
+    SparseMatrixCSC<double> A = testproblems::poisson2D(m);
+    VectorType b(n);
+    for (int i = 0; i < n; ++i) b[i] = std::sin(0.37 * i) + 1.0;
+
+    double previousError = 1e300;
+    size_t previousNnz = 0;
+    for (int level = 0; level <= 2; ++level) {
+        ILUPreconditioner<double> ilu(level);
+        ilu.compute(A);
+        if (level == 0) {
+            EXPECT_EQ(ilu.getNonZeros(), A.values.size() + static_cast<size_t>(n));  // + unit diagonal of L
+        } else {
+            EXPECT_GT(ilu.getNonZeros(), previousNnz);
+        }
+        const double error = (A * ilu.solve(b) - b).L2norm() / b.L2norm();
+        EXPECT_LT(error, previousError);
+        previousError = error;
+        previousNnz = ilu.getNonZeros();
+    }
+}
+
+// Only the pattern is touched, so large matrices factor quickly; refactoring reuses the symbolic phase
+TEST_F(ILUTest, LargeSparseMatrix) {
+    const int m = 300, n = m * m;
+    SparseMatrixCSC<double> A = testproblems::poisson2D(m);
+    ILUPreconditioner<double> ilu(1);
+    ilu.compute(A);
+    for (double& v : A.values) v *= 2.0;
+    ilu.compute(A);
+
+    VectorType b(n, 1.0);
+    VectorType x = ilu.solve(b);
+    // Factors of 2A: the preconditioned residual is that of A scaled by 1/2
+    ILUPreconditioner<double> reference(1);
+    SparseMatrixCSC<double> A1 = testproblems::poisson2D(m);
+    reference.compute(A1);
+    VectorType x1 = reference.solve(b);
+    for (int i = 0; i < n; i += 997) EXPECT_NEAR(2.0 * x[i], x1[i], 1e-12);
+}
+
+// Dense containers have a full pattern: ILU coincides with LU
+TEST_F(ILUTest, DenseMatrixIsExact) {
+    DenseObj<double> A(4, 4);
+    const double vals[4][4] = {{1, 1, 1, 1}, {1, -1, 1, 0}, {0, 1, -1, 1}, {0.5, -0.5, -0.5, 1}};
+    for (int i = 0; i < 4; ++i) for (int j = 0; j < 4; ++j) A(i, j) = vals[i][j];
+    ILUPreconditioner<double, DenseObj<double>> ilu;
+    ilu.compute(A);
+    VectorType b(4, 1.0);
+    VectorType x = ilu.solve(b);
+    EXPECT_LT((A * x - b).L2norm(), 1e-12);
+}
+
+TEST_F(ILUTest, NegativeFillLevel) {
+    EXPECT_THROW(ILUPreconditioner<double>(-1), std::invalid_argument);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+#include "Jacobi.hpp"
+#include "MultiGrid.hpp"
+#include "ConjugateGradient.hpp"
+#include "GMRES.hpp"
+#include "SparseObj.hpp"
+#include "VectorObj.hpp"
+#include "TestProblems.hpp"
+#include <cmath>
+
+class JacobiTest : public ::testing::Test {
+protected:
+    // 5-point Laplacian on an m x m grid, scaled symmetrically as S A S with s_i in [10^-decades, 10^decades]
+    SparseMatrixCSC<double> scaledPoisson(int m, double decades = 0.5) {
+        const int n = m * m;
+        std::vector<double> s(n);
+        for (int i = 0; i < n; ++i) s[i] = std::pow(10.0, decades * std::sin(0.7 * i));
+        SparseMatrixCSC<double> A(n, n);
+        for (int j = 0; j < m; ++j) {
+            for (int i = 0; i < m; ++i) {
+                const int row = i + m * j;
+                A.addValue(row, row, 4.0 * s[row] * s[row]);
+                if (i > 0) A.addValue(row, row - 1, -s[row] * s[row - 1]);
+                if (i < m - 1) A.addValue(row, row + 1, -s[row] * s[row + 1]);
+                if (j > 0) A.addValue(row, row - m, -s[row] * s[row - m]);
+                if (j < m - 1) A.addValue(row, row + m, -s[row] * s[row + m]);
+            }
+        }
+        A.finalize();
+        return A;
+    }
+
+    // Chain of nodes with 3 strongly coupled unknowns each, as in a vector-valued FE problem
+    SparseMatrixCSC<double> nodalChain(int nodes) {
+        const int n = 3 * nodes;
+        SparseMatrixCSC<double> A(n, n);
+        for (int k = 0; k < nodes; ++k) {
+            for (int a = 0; a < 3; ++a) {
+                const int row = 3 * k + a;
+                for (int b = 0; b < 3; ++b) {
+                    A.addValue(row, 3 * k + b, a == b ? 4.0 + 2.0 * a : 1.5);
+                    if (k > 0) A.addValue(row, 3 * (k - 1) + b, a == b ? -1.0 : -0.1);
+                    if (k < nodes - 1) A.addValue(row, 3 * (k + 1) + b, a == b ? -1.0 : -0.1);
+                }
+            }
+        }
+        A.finalize();
+        return A;
+    }
+
+    int cgIterations(const SparseMatrixCSC<double>& A, Preconditioner<double>* M) {
+        VectorObj<double> b = testproblems::rhs(A.getRows());
+        ConjugateGrad<double, SparseMatrixCSC<double>, VectorObj<double>> cg(A, b, 2000, 1e-10);
+        if (M) cg.setPreconditioner(*M);
+        VectorObj<double> x;
+        EXPECT_TRUE(cg.solve(x));
+        EXPECT_LT((b - A * x).L2norm(), 1e-8 * b.L2norm());
+        return cg.getIterations();
+    }
+};
+
+// Jacobi removes the bad scaling; GMRES accepts the same preconditioner
+TEST_F(JacobiTest, PointJacobiPreconditionsCGAndGMRES) {
+    SparseMatrixCSC<double> A = scaledPoisson(20);
+    JacobiPreconditioner<double> jacobi;
+    jacobi.compute(A);
+    EXPECT_LT(cgIterations(A, &jacobi), cgIterations(A, nullptr) / 2);
+
+    VectorObj<double> b = testproblems::rhs(A.getRows()), x(A.getRows(), 0.0);
+    GMRES<double> gmres;
+    gmres.setPreconditioner(jacobi);
+    EXPECT_TRUE(gmres.solve(A, b, x, 20, 50, 1e-10));
+    EXPECT_LT((b - A * x).L2norm(), 1e-6 * b.L2norm());
+}
+
+// Point Jacobi diverges as a smoother when D^(-1) A has eigenvalues above 2; l1-Jacobi does not
+TEST_F(JacobiTest, L1JacobiSmootherConverges) {
+    SparseMatrixCSC<double> A(3, 3);
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) A.addValue(i, j, i == j ? 1.0 : 0.9);
+    }
+    A.finalize();
+    VectorObj<double> b(3, 1.0);
+
+    JacobiPreconditioner<double> point, l1(JacobiType::L1);
+    point.compute(A);
+    l1.compute(A);
+    EXPECT_NEAR(l1.getInverseDiagonal()[0], 1.0 / 2.8, 1e-14);
+
+    VectorObj<double> xPoint(3, 0.0), xL1(3, 0.0);
+    point.smooth(A, b, xPoint, 30);
+    l1.smooth(A, b, xL1, 30);
+    EXPECT_GT((b - A * xPoint).L2norm(), b.L2norm());
+    EXPECT_LT((b - A * xL1).L2norm(), 1e-8 * b.L2norm());
+}
+
+// Blocks are found from the nodal pattern; block-Jacobi beats point Jacobi on coupled unknowns
+TEST_F(JacobiTest, BlockJacobiDetectsNodalBlocks) {
+    SparseMatrixCSC<double> A = nodalChain(100);
+    BlockJacobiPreconditioner<double> block;
+    block.compute(A);
+    EXPECT_EQ(block.getBlockCount(), 100);
+    for (int b = 0; b <= 100; ++b) EXPECT_EQ(block.getBlocks()[b], 3 * b);
+
+    JacobiPreconditioner<double> point;
+    point.compute(A);
+    EXPECT_LT(cgIterations(A, &block), cgIterations(A, &point));
+
+    // A block-diagonal matrix is inverted exactly, with fixed or user-defined blocks alike
+    SparseMatrixCSC<double> D = nodalChain(1);
+    BlockJacobiPreconditioner<double> fixed(3), user;
+    fixed.compute(D);
+    user.setBlocks({0, 3});
+    user.compute(D);
+    VectorObj<double> b = testproblems::rhs(3);
+    EXPECT_LT((D * fixed.apply(b) - b).L2norm(), 1e-13);
+    EXPECT_LT((D * user.apply(b) - b).L2norm(), 1e-13);
+}
+
+// Blocks of different sizes and l1 block-Jacobi
+TEST_F(JacobiTest, VariableBlocksAndL1) {
+    SparseMatrixCSC<double> A = scaledPoisson(10);
+    BlockJacobiPreconditioner<double> block;
+    block.setBlocks({0, 1, 5, 12, 40, 41, 100});
+    block.setL1(true);
+    block.compute(A);
+    EXPECT_EQ(block.getBlockCount(), 6);
+    VectorObj<double> x(A.getRows(), 0.0), b = testproblems::rhs(A.getRows());
+    block.smooth(A, b, x, 200);
+    EXPECT_LT((b - A * x).L2norm(), (b - A * VectorObj<double>(A.getRows(), 0.0)).L2norm());
+    cgIterations(A, &block);
+}
+
+// The coarse levels add to the l1-Jacobi smoothing
+TEST_F(JacobiTest, AMGWithL1JacobiSmoother) {
+    SparseMatrixCSC<double> A = scaledPoisson(16, 0.0);
+    VectorObj<double> b = testproblems::rhs(A.getRows());
+    AlgebraicMultiGrid<double, VectorObj<double>> amg;
+    amg.setSmoother(AMGSmoother::L1Jacobi);
+
+    auto residual = [&](int levels) {
+        VectorObj<double> x(A.getRows(), 0.0);
+        for (int cycle = 0; cycle < 10; ++cycle) amg.amgVCycle(A, b, x, levels, 2, 0.2);
+        return (b - A * x).L2norm() / b.L2norm();
+    };
+    const double smoothingOnly = residual(1);
+    const double threeLevels = residual(3);
+    EXPECT_LT(threeLevels, 0.2);
+    EXPECT_LT(threeLevels, 0.3 * smoothingOnly);
+}
+
+TEST_F(JacobiTest, InvalidArguments) {
+    EXPECT_THROW(JacobiPreconditioner<double>(JacobiType::Point, 0.0), std::invalid_argument);
+    EXPECT_THROW(BlockJacobiPreconditioner<double>(-1), std::invalid_argument);
+    JacobiPreconditioner<double> jacobi;
+    BlockJacobiPreconditioner<double> block;
+    EXPECT_THROW(jacobi.apply(VectorObj<double>(3, 1.0)), std::runtime_error);
+    EXPECT_THROW(block.apply(VectorObj<double>(3, 1.0)), std::runtime_error);
+    EXPECT_THROW(block.setBlocks({0}), std::invalid_argument);
+
+    SparseMatrixCSC<double> zeroDiagonal(2, 2);
+    zeroDiagonal.addValue(0, 1, 1.0);
+    zeroDiagonal.addValue(1, 0, 1.0);
+    zeroDiagonal.finalize();
+    EXPECT_THROW(jacobi.compute(zeroDiagonal), std::runtime_error);
+    block.setBlocks({0, 1, 2});
+    EXPECT_THROW(block.compute(zeroDiagonal), std::runtime_error);
+    block.setBlocks({0, 1, 3});
+    EXPECT_THROW(block.compute(zeroDiagonal), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,4 +1,5 @@
 #include <vector>
+#include <complex>
 #include "DenseObj.hpp"
 #include "KrylovSubspace.hpp" // Include the Arnoldi header file
 #include "basic.hpp"
@@ -124,6 +125,169 @@ TEST_F(ArnoldiTest, KnownExample) {
 }
 
 
+// Orthogonalization kernels used by GMRES
+TEST(OrthogonalizeTest, BasisStaysOrthonormal) {
+    const int n = 300, k = 30;
+    for (auto method : {Krylov::Orthogonalization::MGS, Krylov::Orthogonalization::CGS2,
+                        Krylov::Orthogonalization::LowSync}) {
+        // Build a basis from nearly dependent vectors, which breaks single-pass CGS
+        DenseObj<double> V(n, k);
+        std::vector<double> h(k);
+        for (int j = 0; j < k; ++j) {
+            double* w = V.data() + static_cast<size_t>(j) * n;
+            for (int i = 0; i < n; ++i) w[i] = 1.0 + 1e-7 * std::cos(i * (j + 1.0));
+            double norm = Krylov::orthogonalize(method, V.data(), n, j, n, w, h.data());
+            ASSERT_GT(norm, 0.0);
+            for (int i = 0; i < n; ++i) w[i] /= norm;
+        }
+        DenseObj<double> G = V.Transpose() * V;
+        for (int i = 0; i < k; ++i) {
+            for (int j = 0; j < k; ++j) {
+                EXPECT_NEAR(G(i, j), i == j ? 1.0 : 0.0, 1e-8);
+            }
+        }
+    }
+}
+
+TEST(OrthogonalizeTest, ProjectionCoefficients) {
+    const int n = 50, k = 3;
+    DenseObj<double> V(n, k);
+    for (int j = 0; j < k; ++j) V(j, j) = 1.0;
+    std::vector<double> w(n, 0.0);
+    w[0] = 2.0; w[1] = -3.0; w[2] = 0.5; w[10] = 4.0;
+    for (auto method : {Krylov::Orthogonalization::MGS, Krylov::Orthogonalization::CGS2,
+                        Krylov::Orthogonalization::LowSync}) {
+        std::vector<double> v = w;
+        std::vector<double> h(k);
+        double norm = Krylov::orthogonalize(method, V.data(), n, k, n, v.data(), h.data());
+        EXPECT_NEAR(h[0], 2.0, 1e-12);
+        EXPECT_NEAR(h[1], -3.0, 1e-12);
+        EXPECT_NEAR(h[2], 0.5, 1e-12);
+        EXPECT_NEAR(norm, 4.0, 1e-12);
+        EXPECT_NEAR(v[0], 0.0, 1e-12);
+    }
+}
+
+TEST(TSQRTest, FactorsTallSkinnyBlock) {
+    const int n = 5000, k = 6;
+    DenseObj<double> W(n, k);
+    for (int j = 0; j < k; ++j) {
+        for (int i = 0; i < n; ++i) W(i, j) = std::cos(0.01 * i * (j + 1)) + (i % (j + 2));
+    }
+    DenseObj<double> Q = W, R(k, k);
+    Krylov::tsqr(Q.data(), n, k, n, R.data(), k);
+
+    DenseObj<double> G = Q.Transpose() * Q;
+    DenseObj<double> QR = Q * R;
+    for (int i = 0; i < k; ++i) {
+        for (int j = 0; j < k; ++j) {
+            EXPECT_NEAR(G(i, j), i == j ? 1.0 : 0.0, 1e-12);
+            if (i > j) {
+                EXPECT_EQ(R(i, j), 0.0);
+            }
+        }
+    }
+    for (int j = 0; j < k; ++j) {
+        for (int i = 0; i < n; i += 97) EXPECT_NEAR(QR(i, j), W(i, j), 1e-10);
+    }
+}
+
+TEST(OrthonormalizeBlockTest, DropsDependentColumns) {
+    const int n = 300, k = 5;
+    DenseObj<double> W(n, k);
+    for (int j = 0; j < k; ++j) {
+        for (int i = 0; i < n; ++i) W(i, j) = std::sin(0.05 * i * (j + 1)) + 0.1 * (j + 1);
+    }
+    // Column 2 lies in the span of columns 0 and 1
+    for (int i = 0; i < n; ++i) W(i, 2) = 2.0 * W(i, 0) - W(i, 1);
+
+    DenseObj<double> Q = W, R(k, k);
+    const int rank = Krylov::orthonormalizeBlock(Q.data(), n, k, n, R.data(), k, 1e-12);
+    ASSERT_EQ(rank, 4);
+    for (int a = 0; a < rank; ++a) {
+        for (int b = 0; b < rank; ++b) {
+            double g = 0.0;
+            for (int i = 0; i < n; ++i) g += Q(i, a) * Q(i, b);
+            EXPECT_NEAR(g, a == b ? 1.0 : 0.0, 1e-12);
+        }
+    }
+    // W = Q(:, 0:rank) R(0:rank, :), upper staircase with a positive diagonal
+    const int diagCol[] = {0, 1, 3, 4};
+    for (int p = 0; p < rank; ++p) EXPECT_GT(R(p, diagCol[p]), 0.0);
+    for (int j = 0; j < k; ++j) {
+        for (int p = 0; p < k; ++p) {
+            if (p >= rank || (j < 2 && p > j) || (j >= 2 && p > j - 1)) {
+                EXPECT_EQ(R(p, j), 0.0);
+            }
+        }
+        for (int i = 0; i < n; i += 7) {
+            double w = 0.0;
+            for (int p = 0; p < rank; ++p) w += Q(i, p) * R(p, j);
+            EXPECT_NEAR(w, W(i, j), 1e-10);
+        }
+    }
+}
+
+TEST(HessenbergEigenvaluesTest, RealAndComplexPairs) {
+    // Block diagonal with a rotation-scaling block (eigenvalues 1 +- 2i), then
+    // made Hessenberg by a similarity with a bidiagonal matrix
+    const int k = 4;
+    DenseObj<double> H(k, k);
+    H(0, 0) = 1.0; H(0, 1) = -2.0;
+    H(1, 0) = 2.0; H(1, 1) = 1.0;
+    H(2, 2) = 3.0; H(2, 3) = 0.5;
+    H(3, 3) = -4.0;
+    H(1, 2) = 0.7; H(2, 1) = 0.0; H(0, 3) = 1.1;
+    std::vector<std::complex<double>> ev = Krylov::hessenbergEigenvalues(H.data(), k, k);
+    ASSERT_EQ(ev.size(), 4u);
+    std::vector<std::complex<double>> expected = {{1.0, 2.0}, {1.0, -2.0}, {3.0, 0.0}, {-4.0, 0.0}};
+    for (const auto& e : expected) {
+        double best = 1e300;
+        for (const auto& z : ev) best = std::min(best, std::abs(z - e));
+        EXPECT_LT(best, 1e-10);
+    }
+
+    // Full Hessenberg: the trace and determinant are preserved
+    DenseObj<double> G(6, 6);
+    for (int j = 0; j < 6; ++j) {
+        for (int i = 0; i <= std::min(j + 1, 5); ++i) G(i, j) = std::sin(1.0 + i + 3.0 * j);
+    }
+    ev = Krylov::hessenbergEigenvalues(G.data(), 6, 6);
+    std::complex<double> trace = 0.0;
+    for (const auto& z : ev) trace += z;
+    double diag = 0.0;
+    for (int i = 0; i < 6; ++i) diag += G(i, i);
+    EXPECT_NEAR(trace.real(), diag, 1e-10);
+    EXPECT_NEAR(trace.imag(), 0.0, 1e-10);
+}
+
+TEST(HessenbergEigenvaluesTest, TridiagonalToeplitz) {
+    // tridiag(c, a, b) has eigenvalues a + 2 sqrt(b c) cos(j pi / (n + 1)),
+    // a real spectrum for b c > 0 and conjugate pairs for b c < 0
+    const int n = 24;
+    const double pi = std::acos(-1.0);
+    for (double c : {0.5, -0.5}) {
+        const double a = 2.0, b = 1.5;
+        DenseObj<double> T(n, n);
+        for (int i = 0; i < n; ++i) {
+            T(i, i) = a;
+            if (i + 1 < n) {
+                T(i, i + 1) = b;
+                T(i + 1, i) = c;
+            }
+        }
+        std::vector<std::complex<double>> ev = Krylov::hessenbergEigenvalues(T.data(), n, n);
+        ASSERT_EQ(ev.size(), static_cast<size_t>(n));
+        const std::complex<double> root = std::sqrt(std::complex<double>(b * c, 0.0));
+        for (int j = 1; j <= n; ++j) {
+            const std::complex<double> e = a + 2.0 * root * std::cos(j * pi / (n + 1));
+            double best = 1e300;
+            for (const auto& z : ev) best = std::min(best, std::abs(z - e));
+            EXPECT_LT(best, 1e-8);
+        }
+    }
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -79,6 +79,50 @@ TEST(LUDecomposition, SquareMatrix) {
     }
 }
 
+// Test case: Blocked LU reproduces the unblocked factorization.
+TEST(LUDecomposition, BlockedMatchesUnblocked) {
+    const int n = 37;
+    DenseObj<double> A(n, n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            A(i, j) = std::sin(1.0 + i * n + j) + (i == j ? 2.0 : 0.0);
+        }
+    }
+    DenseObj<double> B = A;
+    std::vector<int> P, Pb;
+
+    basic::PivotLU<double, DenseObj<double>>(A, P);
+    basic::BlockedLU(B, Pb, 8);
+
+    EXPECT_EQ(P, Pb);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            EXPECT_NEAR(A(i, j), B(i, j), 1e-10) << "Mismatch at (" << i << ", " << j << ")";
+        }
+    }
+}
+
+// Test case: PivotLU factors a diagonal block of a larger matrix in place through a view.
+TEST(LUDecomposition, FactorizeView) {
+    DenseObj<double> big(5, 5);
+    DenseObj<double> A = initializeSquareMatrix(3);
+    big.view(1, 2, 3, 3).assign(A.view(0, 0, 3, 3));
+    big(0, 0) = 42.0;
+
+    std::vector<int> P, Pv;
+    basic::PivotLU<double, DenseObj<double>>(A, P);
+    DenseView<double> block = big.view(1, 2, 3, 3);
+    basic::PivotLU<double, DenseView<double>>(block, Pv);
+
+    EXPECT_EQ(P, Pv);
+    EXPECT_EQ(big(0, 0), 42.0);
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            EXPECT_NEAR(big(i + 1, j + 2), A(i, j), 1e-12);
+        }
+    }
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
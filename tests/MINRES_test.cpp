@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+#include "MINRES.hpp"
+#include "SYMMLQ.hpp"
+#include "ConjugateGradient.hpp"
+#include "Preconditioner.hpp"
+#include "SparseObj.hpp"
+#include "VectorObj.hpp"
+#include "TestProblems.hpp"
+#include <cmath>
+
+class SymmetricIndefiniteTest : public ::testing::Test {
+protected:
+    // Saddle-point system [K B^T; B 0] with K the 1D Laplacian and B a coarse averaging
+    SparseMatrixCSC<double> saddlePoint(int nu) {
+        const int np = nu / 2;
+        const int n = nu + np;
+        SparseMatrixCSC<double> A(n, n);
+        for (int i = 0; i < nu; ++i) {
+            A.addValue(i, i, 2.0);
+            if (i > 0) A.addValue(i, i - 1, -1.0);
+            if (i < nu - 1) A.addValue(i, i + 1, -1.0);
+        }
+        for (int k = 0; k < np; ++k) {
+            for (int i = 2 * k; i < 2 * k + 2; ++i) {
+                A.addValue(nu + k, i, 0.5 * (i - 2 * k + 1));
+                A.addValue(i, nu + k, 0.5 * (i - 2 * k + 1));
+            }
+        }
+        A.finalize();
+        return A;
+    }
+
+    VectorObj<double> rhs(int n) {
+        VectorObj<double> b(n);
+        for (int i = 0; i < n; ++i) b[i] = std::cos(0.7 * i) + 0.5;
+        return b;
+    }
+};
+
+TEST_F(SymmetricIndefiniteTest, MINRESShiftedOperator) {
+    SparseMatrixCSC<double> A = testproblems::poisson1D(100, -1.3);
+    VectorObj<double> b = rhs(100);
+    VectorObj<double> x(100, 0.0);
+
+    MINRES<double> solver;
+    EXPECT_TRUE(solver.solve(A, b, x, 1000, 1e-10));
+    const double trueResidual = (b - A * x).L2norm();
+    EXPECT_LT(trueResidual, 1e-8 * b.L2norm());
+    EXPECT_NEAR(solver.getResidualNorm(), trueResidual, 1e-8 * b.L2norm());
+}
+
+TEST_F(SymmetricIndefiniteTest, MINRESSaddlePointWithPreconditioner) {
+    SparseMatrixCSC<double> A = saddlePoint(60);
+    const int n = A.getRows();
+    VectorObj<double> b = rhs(n);
+
+    // Block-diagonal SPD preconditioner diag(|A_ii|), identity on the zero block
+    FunctionPreconditioner<double> diagonal([&](const VectorObj<double>& r) {
+        VectorObj<double> z(r.size());
+        for (int i = 0; i < n; ++i) z[i] = r[i] / (A(i, i) != 0.0 ? std::abs(A(i, i)) : 1.0);
+        return z;
+    });
+    MINRES<double> solver;
+    solver.setPreconditioner(diagonal);
+    VectorObj<double> x(n, 0.0);
+    EXPECT_TRUE(solver.solve(A, b, x, 1000, 1e-12));
+    EXPECT_LT((b - A * x).L2norm(), 1e-9 * b.L2norm());
+}
+
+TEST_F(SymmetricIndefiniteTest, SYMMLQShiftedOperator) {
+    SparseMatrixCSC<double> A = testproblems::poisson1D(100, -1.3);
+    VectorObj<double> b = rhs(100);
+
+    SYMMLQ<double> solver;
+    VectorObj<double> x(100, 1.0);
+    EXPECT_TRUE(solver.solve(A, b, x, 1000, 1e-10));
+    EXPECT_LT((b - A * x).L2norm(), 1e-8 * b.L2norm());
+}
+
+TEST_F(SymmetricIndefiniteTest, SYMMLQSaddlePoint) {
+    SparseMatrixCSC<double> A = saddlePoint(60);
+    const int n = A.getRows();
+    VectorObj<double> b = rhs(n);
+    SYMMLQ<double> solver;
+    VectorObj<double> x(n, 0.0);
+    EXPECT_TRUE(solver.solve(A, b, x, 1000, 1e-12));
+    EXPECT_LT((b - A * x).L2norm(), 1e-9 * b.L2norm());
+}
+
+TEST_F(SymmetricIndefiniteTest, CGRejectsIndefiniteOperator) {
+    SparseMatrixCSC<double> A = testproblems::poisson1D(100, -1.3);
+    VectorObj<double> b = rhs(100);
+    ConjugateGrad<double, SparseMatrixCSC<double>, VectorObj<double>> cg(A, b, 1000, 1e-10);
+    VectorObj<double> x(100, 0.0);
+    EXPECT_THROW(cg.solve(x), std::runtime_error);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include "MixedPrecision.hpp"
+#include "ILU.hpp"
+#include "MultiGrid.hpp"
+#include "basic.hpp"
+#include "DenseObj.hpp"
+#include "SparseObj.hpp"
+#include "VectorObj.hpp"
+#include "TestProblems.hpp"
+#include <cmath>
+
+TEST(MixedPrecisionTest, FloatBlasDispatch) {
+    DenseObj<double> A(7, 5), B(5, 3);
+    for (int j = 0; j < 5; ++j) {
+        for (int i = 0; i < 7; ++i) A(i, j) = std::cos(i + 2.0 * j);
+        for (int i = 0; i < 3; ++i) B(j, i) = std::sin(1.0 + i * j);
+    }
+    DenseObj<double> C = A * B;
+    DenseObj<float> Cf = A.cast<float>() * B.cast<float>();
+    for (int j = 0; j < 3; ++j) {
+        for (int i = 0; i < 7; ++i) EXPECT_NEAR(Cf(i, j), C(i, j), 1e-5);
+    }
+}
+
+TEST(MixedPrecisionTest, ILUReachesDoubleAccuracy) {
+    SparseMatrixCSC<double> A = testproblems::convectionDiffusion(10, 0.2);
+    VectorObj<double> b = testproblems::rhs(A.getRows());
+
+    MixedPrecisionRefinement<float, double> solver(A);
+    ILUPreconditioner<float> ilu;
+    ilu.compute(solver.lowPrecisionMatrix());
+    solver.setPreconditioner(ilu);
+
+    VectorObj<double> x(A.getRows(), 0.0);
+    EXPECT_TRUE(solver.solve(b, x, 30, 1e-13));
+    // Far below what a float solve can reach
+    EXPECT_LT((b - A * x).L2norm(), 1e-12 * b.L2norm());
+    EXPECT_GT(solver.getRefinements(), 1);
+}
+
+TEST(MixedPrecisionTest, AMGInFloat) {
+    SparseMatrixCSC<double> A = testproblems::convectionDiffusion(16, 0.0);
+    VectorObj<double> b = testproblems::rhs(A.getRows());
+
+    MixedPrecisionRefinement<float, double> solver(A);
+    AMGPreconditioner<float, VectorObj<float>> amg(solver.lowPrecisionMatrix(), 3, 2, 0.25f);
+    ASSERT_EQ(amg.getHierarchy().getNumLevels(), 3);
+    EXPECT_LT(amg.getHierarchy().getLevelSize(2), amg.getHierarchy().getLevelSize(1));
+    EXPECT_LT(amg.getHierarchy().getLevelSize(1), A.getRows());
+    solver.setPreconditioner(amg);
+    solver.setInnerSolver(20, 2, 1e-4);
+
+    VectorObj<double> x(A.getRows(), 0.0);
+    EXPECT_TRUE(solver.solve(b, x, 30, 1e-12));
+    EXPECT_LT((b - A * x).L2norm(), 1e-12 * b.L2norm());
+}
+
+TEST(MixedPrecisionTest, DenseFloatLU) {
+    SparseMatrixCSC<double> A = testproblems::convectionDiffusion(8, 0.4);
+    const int n = A.getRows();
+    VectorObj<double> b = testproblems::rhs(n);
+
+    MixedPrecisionRefinement<float, double> solver(A);
+    // Full LU of the float matrix through the blocked (BLAS-3) factorization
+    DenseObj<float> LU(n, n);
+    const SparseMatrixCSC<float>& Af = solver.lowPrecisionMatrix();
+    for (int j = 0; j < n; ++j) {
+        for (int k = Af.col_ptr[j]; k < Af.col_ptr[j + 1]; ++k) LU(Af.row_indices[k], j) = Af.values[k];
+    }
+    std::vector<int> P;
+    basic::BlockedLU<float>(LU, P, 16);
+    FunctionPreconditioner<float> lu([&](const VectorObj<float>& r) {
+        DenseObj<float> y(n, 1);
+        for (int i = 0; i < n; ++i) y(i, 0) = r[P[i]];
+        y = basic::TriangularSolve(LU, y, true, true);
+        y = basic::TriangularSolve(LU, y, false);
+        return VectorObj<float>(y.data(), n);
+    });
+    solver.setPreconditioner(lu);
+    solver.setInnerSolver(5, 1, 1e-5);
+
+    VectorObj<double> x(n, 0.0);
+    EXPECT_TRUE(solver.solve(b, x, 20, 1e-13));
+    EXPECT_LT((b - A * x).L2norm(), 1e-12 * b.L2norm());
+    EXPECT_LE(solver.getRefinements(), 6);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -2,7 +2,10 @@
 #include "MultiGrid.hpp"
 #include "SparseObj.hpp" // For SparseMatrixCSC
 #include "IterSolver.hpp" // For iterative solvers like Jacobi
+#include "CFD/VorticityStreamSolver.hpp"
+#include "TestProblems.hpp"
 #include <vector>
+#include <cmath>
 
 // Test fixture for MultiGrid
 class MultiGridTest : public ::testing::Test {
@@ -81,6 +84,76 @@ TEST_F(MultiGridTest, NonSquareMatrix) {
     EXPECT_THROW(mg_solver.amgVCycle(non_square_matrix, rhs_non_square, solution, 5, 100, 1.5), std::runtime_error);
 }
 
+// The hierarchy is built once and reused for several right-hand sides; amgVCycle on
+// the same matrix reuses it and gives the same iterates
+TEST(MultiGridHierarchyTest, SetupOnceSolveMany) {
+    SparseMatrixCSC<double> A = testproblems::poisson2D(16);
+    const int n = A.getRows();
+    AlgebraicMultiGrid<double, VectorObj<double>> amg;
+    amg.setSmoother(AMGSmoother::Chebyshev, 3);
+    amg.setup(A, 3, 0.2);
+    ASSERT_EQ(amg.getNumLevels(), 3);
+    EXPECT_LT(amg.getLevelSize(1), n);
+    EXPECT_GT(amg.getOperatorComplexity(), 1.0);
+
+    for (int k = 1; k <= 3; ++k) {
+        VectorObj<double> b(n);
+        for (int i = 0; i < n; ++i) b[i] = std::sin(0.1 * k * (i + 1));
+        VectorObj<double> x(n, 0.0), y(n, 0.0);
+        for (int cycle = 0; cycle < 8; ++cycle) {
+            amg.vcycle(b, x, 1);
+            amg.amgVCycle(A, b, y, 3, 1, 0.2);
+        }
+        EXPECT_LT((b - A * x).L2norm(), 1e-4 * b.L2norm());
+        EXPECT_LT((x - y).L2norm(), 1e-14 * x.L2norm());
+    }
+}
+
+// Every level must be clearly smaller than the one above it, also for the
+// thresholds (0.25, 0.3) that no 5-point connection passes relative to the diagonal
+TEST(MultiGridHierarchyTest, LevelsShrink) {
+    SparseMatrixCSC<double> A = testproblems::poisson2D(16);
+    for (double theta : {0.25, 0.3}) {
+        AlgebraicMultiGrid<double, VectorObj<double>> amg;
+        amg.setup(A, 7, theta);
+        ASSERT_GT(amg.getNumLevels(), 2);
+        for (int l = 1; l < amg.getNumLevels(); ++l) {
+            EXPECT_LT(amg.getLevelSize(l), amg.getLevelSize(l - 1));
+        }
+        EXPECT_LT(amg.getOperatorComplexity(), 3.0);
+    }
+
+    // A diagonal matrix has no strong connections: a single level
+    SparseMatrixCSC<double> D(10, 10);
+    for (int i = 0; i < 10; ++i) D.addValue(i, i, 1.0 + i);
+    D.finalize();
+    AlgebraicMultiGrid<double, VectorObj<double>> amg;
+    amg.setup(D, 4, 0.25);
+    EXPECT_EQ(amg.getNumLevels(), 1);
+}
+
+// The hierarchies VorticityStreamSolver builds for its Poisson and diffusion matrices
+TEST(MultiGridHierarchyTest, VorticityStreamSolverHierarchiesShrink) {
+    VorticityStreamSolver<double> solver(17, 17, 100.0);
+    for (const auto* amg : {&solver.getPoissonHierarchy(), &solver.getDiffusionHierarchy()}) {
+        ASSERT_GT(amg->getNumLevels(), 2);
+        for (int l = 1; l < amg->getNumLevels(); ++l) {
+            EXPECT_LT(amg->getLevelSize(l), amg->getLevelSize(l - 1));
+        }
+    }
+}
+
+TEST(MultiGridHierarchyTest, VCycleBeforeSetupThrows) {
+    AlgebraicMultiGrid<double, VectorObj<double>> amg;
+    VectorObj<double> b(4, 1.0), x(4, 0.0);
+    EXPECT_THROW(amg.vcycle(b, x, 1), std::runtime_error);
+    SparseMatrixCSC<double> A = testproblems::poisson2D(2);
+    EXPECT_THROW(amg.setup(A, 0, 0.2), std::invalid_argument);
+    amg.setup(A, 2, 0.2);
+    VectorObj<double> wrong(3, 1.0);
+    EXPECT_THROW(amg.vcycle(wrong, x, 1), std::invalid_argument);
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+#include "ParILU.hpp"
+#include "ILU.hpp"
+#include "FGMRES.hpp"
+#include "SparseObj.hpp"
+#include "VectorObj.hpp"
+#include "TestProblems.hpp"
+#include <cmath>
+
+// The residual of the fixed-point equations drops with every sweep, towards the exact ILU(0)
+TEST(ParILUTest, SweepsConvergeToILU) {
+    SparseMatrixCSC<double> A = testproblems::upwindConvectionDiffusion(20, 1.0);
+    VectorObj<double> b = testproblems::rhs(A.getRows());
+
+    // Synchronous sweeps show the fixed-point convergence independently of the thread count
+    double previous = 1e300;
+    for (int sweeps : {1, 2, 4}) {
+        ParILUPreconditioner<double> parilu(sweeps);
+        parilu.setAsynchronous(false);
+        parilu.compute(A);
+        EXPECT_LT(parilu.getResidual(), previous);
+        previous = parilu.getResidual();
+    }
+
+    ParILUPreconditioner<double> converged(40);
+    converged.compute(A);
+    EXPECT_LT(converged.getResidual(), 1e-12);
+    ILUPreconditioner<double> ilu;
+    ilu.compute(A);
+    const VectorObj<double> reference = ilu.solve(b);
+    EXPECT_LT((converged.solve(b) - reference).L2norm(), 1e-10 * reference.L2norm());
+}
+
+// A few sweeps already precondition almost as well as the exact ILU(0)
+TEST(ParILUTest, PreconditionsFGMRES) {
+    SparseMatrixCSC<double> A = testproblems::upwindConvectionDiffusion(30, 2.0);
+    VectorObj<double> b = testproblems::rhs(A.getRows());
+
+    ILUPreconditioner<double> ilu;
+    ilu.compute(A);
+    FGMRES<double> exact;
+    exact.setPreconditioner(ilu);
+    VectorObj<double> x0(A.getRows(), 0.0);
+    ASSERT_TRUE(exact.solve(A, b, x0, 50, 30, 1e-10));
+
+    ParILUPreconditioner<double> parilu(3);
+    parilu.setAsynchronous(false);
+    parilu.compute(A);
+    FGMRES<double> solver;
+    solver.setPreconditioner(parilu);
+    VectorObj<double> x(A.getRows(), 0.0);
+    EXPECT_TRUE(solver.solve(A, b, x, 50, 30, 1e-10));
+    EXPECT_LT((b - A * x).L2norm(), 1e-8);
+    EXPECT_LE(solver.getIterations(), exact.getIterations() + 5);
+}
+
+// For a slightly changed matrix, one sweep from the previous factors beats one sweep from scratch
+TEST(ParILUTest, WarmStartUpdate) {
+    SparseMatrixCSC<double> A = testproblems::upwindConvectionDiffusion(20, 1.0);
+    SparseMatrixCSC<double> A2 = testproblems::upwindConvectionDiffusion(20, 1.0, 0.0, 0.01);
+
+    ParILUPreconditioner<double> warm(30);
+    warm.setAsynchronous(false);
+    warm.compute(A);
+    warm.setSweeps(1);
+    warm.update(A2);
+
+    ParILUPreconditioner<double> cold(1);
+    cold.setAsynchronous(false);
+    cold.compute(A2);
+    EXPECT_LT(warm.getResidual(), 0.1 * cold.getResidual());
+}
+
+// Enough Jacobi iterations on the triangular systems reproduce the exact triangular solves
+TEST(ParILUTest, JacobiTriangularSolves) {
+    SparseMatrixCSC<double> A = testproblems::upwindConvectionDiffusion(16, 1.0);
+    VectorObj<double> b = testproblems::rhs(A.getRows());
+    ParILUPreconditioner<double> parilu(5);
+    parilu.compute(A);
+    const VectorObj<double> exact = parilu.solve(b);
+
+    double previous = 1e300;
+    for (int iterations : {2, 8, 60}) {
+        parilu.setJacobiSolves(iterations);
+        const double error = (parilu.solve(b) - exact).L2norm() / exact.L2norm();
+        EXPECT_LT(error, previous);
+        previous = error;
+    }
+    EXPECT_LT(previous, 1e-8);
+}
+
+TEST(ParILUTest, InvalidArguments) {
+    EXPECT_THROW(ParILUPreconditioner<double>(0), std::invalid_argument);
+    EXPECT_THROW(ParILUPreconditioner<double>(3, -1), std::invalid_argument);
+    ParILUPreconditioner<double> parilu;
+    EXPECT_THROW(parilu.setJacobiSolves(-1), std::invalid_argument);
+    EXPECT_THROW(parilu.solve(VectorObj<double>(3, 1.0)), std::runtime_error);
+
+    SparseMatrixCSC<double> zeroDiagonal(2, 2);
+    zeroDiagonal.addValue(0, 1, 1.0);
+    zeroDiagonal.addValue(1, 0, 1.0);
+    zeroDiagonal.finalize();
+    EXPECT_THROW(parilu.compute(zeroDiagonal), std::runtime_error);
+}
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
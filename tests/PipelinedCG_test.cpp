@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "PipelinedCG.hpp"
+#include "Preconditioner.hpp"
+#include "SparseObj.hpp"
+#include "VectorObj.hpp"
+#include "TestProblems.hpp"
+#include <cmath>
+
+class PipelinedCGTest : public ::testing::Test {
+protected:
+    // 2D Poisson on an m x m grid with a variable coefficient on the diagonal
+    SparseMatrixCSC<double> poisson2D(int m) {
+        SparseMatrixCSC<double> A = testproblems::poisson2D(m);
+        for (int idx = 0; idx < m * m; ++idx) A.addValue(idx, idx, 4.0 + 0.01 * (idx % 97));
+        return A;
+    }
+
+    VectorObj<double> rhs(int n) {
+        VectorObj<double> b(n);
+        for (int i = 0; i < n; ++i) b[i] = std::cos(0.05 * i);
+        return b;
+    }
+};
+
+TEST_F(PipelinedCGTest, Unpreconditioned) {
+    SparseMatrixCSC<double> A = poisson2D(20);
+    VectorObj<double> b = rhs(A.getRows());
+    VectorObj<double> x(A.getRows(), 0.0);
+
+    PipelinedCG<double> solver;
+    EXPECT_TRUE(solver.solve(A, b, x, 1000, 1e-10));
+    EXPECT_LT((b - A * x).L2norm() / b.L2norm(), 1e-9);
+    EXPECT_LT(solver.getIterations(), A.getRows());
+}
+
+TEST_F(PipelinedCGTest, JacobiPreconditionedWithReplacement) {
+    SparseMatrixCSC<double> A = poisson2D(20);
+    VectorObj<double> b = rhs(A.getRows());
+
+    FunctionPreconditioner<double> jacobi([&](const VectorObj<double>& r) {
+        VectorObj<double> z(r.size());
+        for (size_t i = 0; i < r.size(); ++i) z[i] = r[i] / A(i, i);
+        return z;
+    });
+
+    for (int period : {0, 25}) {
+        VectorObj<double> x(A.getRows(), 0.0);
+        PipelinedCG<double> solver;
+        solver.setPreconditioner(jacobi);
+        solver.setResidualReplacement(period);
+        EXPECT_TRUE(solver.solve(A, b, x, 1000, 1e-11));
+        EXPECT_LT((b - A * x).L2norm() / b.L2norm(), 1e-10) << "replacement period " << period;
+    }
+}
+
+TEST_F(PipelinedCGTest, ZeroRHS) {
+    SparseMatrixCSC<double> A = poisson2D(4);
+    VectorObj<double> b(A.getRows(), 0.0);
+    VectorObj<double> x(A.getRows(), 1.0);
+    PipelinedCG<double> solver;
+    EXPECT_TRUE(solver.solve(A, b, x, 10, 1e-10));
+    EXPECT_DOUBLE_EQ(x.L2norm(), 0.0);
+}
+
+TEST_F(PipelinedCGTest, NotPositiveDefinite) {
+    SparseMatrixCSC<double> A = poisson2D(4) * -1.0;
+    VectorObj<double> b = rhs(A.getRows());
+    VectorObj<double> x(A.getRows(), 0.0);
+    PipelinedCG<double> solver;
+    EXPECT_THROW(solver.solve(A, b, x, 10, 1e-10), std::runtime_error);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
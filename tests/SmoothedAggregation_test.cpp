@@ -0,0 +1,165 @@
+#include <gtest/gtest.h>
+#include "SmoothedAggregation.hpp"
+#include "MultiGrid.hpp"
+#include "Jacobi.hpp"
+#include "ConjugateGradient.hpp"
+#include "SparseObj.hpp"
+#include "VectorObj.hpp"
+#include "TestProblems.hpp"
+#include <cmath>
+
+class SmoothedAggregationTest : public ::testing::Test {
+protected:
+    // 2D truss on an m x m lattice: springs to the horizontal, vertical and diagonal
+    // neighbours, two displacements per node. clamped fixes the left edge by identity rows.
+    SparseMatrixCSC<double> springLattice(int m, bool clamped, std::vector<double>& coords) {
+        const int nodes = m * m;
+        const int n = 2 * nodes;
+        coords.assign(n, 0.0);
+        std::vector<bool> fixed(nodes, false);
+        for (int j = 0; j < m; ++j) {
+            for (int i = 0; i < m; ++i) {
+                const int k = i + m * j;
+                coords[2 * k] = i;
+                coords[2 * k + 1] = j;
+                fixed[k] = clamped && i == 0;
+            }
+        }
+        SparseMatrixCSC<double> K(n, n);
+        auto spring = [&](int a, int b, double stiffness) {
+            const double dx = coords[2 * b] - coords[2 * a], dy = coords[2 * b + 1] - coords[2 * a + 1];
+            const double length = std::sqrt(dx * dx + dy * dy);
+            const double d[2] = {dx / length, dy / length};
+            for (int r = 0; r < 2; ++r) {
+                for (int c = 0; c < 2; ++c) {
+                    const double k = stiffness * d[r] * d[c];
+                    if (!fixed[a]) K.addValue(2 * a + r, 2 * a + c, k);
+                    if (!fixed[b]) K.addValue(2 * b + r, 2 * b + c, k);
+                    if (!fixed[a] && !fixed[b]) {
+                        K.addValue(2 * a + r, 2 * b + c, -k);
+                        K.addValue(2 * b + r, 2 * a + c, -k);
+                    }
+                }
+            }
+        };
+        for (int j = 0; j < m; ++j) {
+            for (int i = 0; i < m; ++i) {
+                const int k = i + m * j;
+                if (i < m - 1) spring(k, k + 1, 1.0);
+                if (j < m - 1) spring(k, k + m, 1.0);
+                if (i < m - 1 && j < m - 1) spring(k, k + m + 1, 0.5);
+                if (i > 0 && j < m - 1) spring(k, k + m - 1, 0.5);
+            }
+        }
+        for (int k = 0; k < nodes; ++k) {
+            if (fixed[k]) {
+                K.addValue(2 * k, 2 * k, 1.0);
+                K.addValue(2 * k + 1, 2 * k + 1, 1.0);
+            }
+        }
+        K.finalize();
+        return K;
+    }
+
+    int cgIterations(const SparseMatrixCSC<double>& A, Preconditioner<double>* M) {
+        VectorObj<double> b = testproblems::rhs(A.getRows());
+        ConjugateGrad<double, SparseMatrixCSC<double>, VectorObj<double>> cg(A, b, 3000, 1e-10);
+        if (M) cg.setPreconditioner(*M);
+        VectorObj<double> x;
+        EXPECT_TRUE(cg.solve(x));
+        EXPECT_LT((b - A * x).L2norm(), 1e-5 * b.L2norm());
+        return cg.getIterations();
+    }
+};
+
+// Translations and the rotation are zero-energy modes of the free lattice
+TEST_F(SmoothedAggregationTest, RigidBodyModesSpanNullspace) {
+    std::vector<double> coords;
+    SparseMatrixCSC<double> K = springLattice(6, false, coords);
+    DenseObj<double> B = sa::rigidBodyModes(coords, 2);
+    ASSERT_EQ(B.getCols(), 3);
+    for (int c = 0; c < 3; ++c) {
+        VectorObj<double> v(K.getRows());
+        for (int i = 0; i < K.getRows(); ++i) v[i] = B(i, c);
+        EXPECT_LT((K * v).L2norm(), 1e-12 * v.L2norm());
+    }
+    EXPECT_EQ(sa::rigidBodyModes(std::vector<double>(9, 1.0), 3).getCols(), 6);
+}
+
+// The rotation in the near-nullspace pays off on elasticity, where point Jacobi struggles
+TEST_F(SmoothedAggregationTest, RigidBodyModesAccelerateElasticity) {
+    std::vector<double> coords;
+    SparseMatrixCSC<double> K = springLattice(32, true, coords);
+
+    SmoothedAggregationAMG<double> rigid, translations;
+    rigid.setNearNullspace(sa::rigidBodyModes(coords, 2), 2);
+    rigid.setup(K);
+    translations.setBlockSize(2);
+    translations.setup(K);
+    EXPECT_GT(rigid.getNumLevels(), 2);
+    EXPECT_LT(rigid.getOperatorComplexity(), 2.0);
+
+    JacobiPreconditioner<double> jacobi;
+    jacobi.compute(K);
+    const int withRigid = cgIterations(K, &rigid);
+    const int withTranslations = cgIterations(K, &translations);
+    EXPECT_LT(withRigid, withTranslations);
+    EXPECT_LT(4 * withRigid, cgIterations(K, &jacobi));
+}
+
+// Scalar problems coarsen with a low operator complexity; V-cycles converge as a solver
+TEST_F(SmoothedAggregationTest, PoissonVCycles) {
+    SparseMatrixCSC<double> A = testproblems::poisson2D(48);
+    VectorObj<double> b = testproblems::rhs(A.getRows());
+
+    SmoothedAggregationAMG<double> amg;
+    amg.setMaxCoarseSize(20);
+    amg.setup(A);
+    EXPECT_GT(amg.getNumLevels(), 2);
+    for (int l = 1; l < amg.getNumLevels(); ++l) EXPECT_LT(4 * amg.getLevelSize(l), amg.getLevelSize(l - 1));
+    EXPECT_LT(amg.getOperatorComplexity(), 1.5);
+
+    VectorObj<double> x(A.getRows(), 0.0);
+    amg.setSmoother(AMGSmoother::Chebyshev, 3);
+    for (int cycle = 0; cycle < 15; ++cycle) amg.vcycle(b, x);
+    EXPECT_LT((b - A * x).L2norm(), 1e-5 * b.L2norm());
+
+    // Smoothing the prolongator is what makes aggregation scale
+    SmoothedAggregationAMG<double> plain;
+    plain.setProlongatorSmoothing(false);
+    plain.setMaxCoarseSize(20);
+    plain.setup(A);
+    EXPECT_LT(cgIterations(A, &amg), cgIterations(A, &plain));
+
+    amg.setSmoother(AMGSmoother::L1Jacobi);
+    cgIterations(A, &amg);
+}
+
+TEST_F(SmoothedAggregationTest, InvalidArguments) {
+    EXPECT_THROW(SmoothedAggregationAMG<double>(-0.1), std::invalid_argument);
+    SmoothedAggregationAMG<double> amg;
+    EXPECT_THROW(amg.apply(VectorObj<double>(3, 1.0)), std::runtime_error);
+    EXPECT_THROW(amg.setMaxLevels(0), std::invalid_argument);
+    EXPECT_THROW(amg.setBlockSize(0), std::invalid_argument);
+    EXPECT_THROW(sa::rigidBodyModes(std::vector<double>(5, 0.0), 2), std::invalid_argument);
+
+    SparseMatrixCSC<double> rect(4, 3);
+    rect.addValue(0, 0, 1.0);
+    rect.finalize();
+    EXPECT_THROW(amg.setup(rect), std::invalid_argument);
+
+    SparseMatrixCSC<double> A = testproblems::poisson2D(3);
+    amg.setBlockSize(2);
+    EXPECT_THROW(amg.setup(A), std::invalid_argument);
+    amg.setNearNullspace(DenseObj<double>(8, 1), 1);
+    EXPECT_THROW(amg.setup(A), std::invalid_argument);
+
+    amg.setNearNullspace(DenseObj<double>(std::vector<double>(9, 1.0), 9, 1), 1);
+    amg.setup(A);
+    EXPECT_THROW(amg.apply(VectorObj<double>(4, 1.0)), std::invalid_argument);
+}
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
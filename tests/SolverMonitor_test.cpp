@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+#include "SolverMonitor.hpp"
+#include "GMRES.hpp"
+#include "ConjugateGradient.hpp"
+#include "NewtonMethod.hpp"
+#include "SparseObj.hpp"
+#include "DenseObj.hpp"
+#include "VectorObj.hpp"
+#include <cmath>
+#include <sstream>
+#include <string>
+
+// 1D Laplacian with a nonsymmetric first-order term for GMRES
+static SparseMatrixCSC<double> tridiagonal(int n, double lower, double upper) {
+    SparseMatrixCSC<double> A(n, n);
+    for (int i = 0; i < n; ++i) {
+        A.addValue(i, i, 2.0);
+        if (i > 0) A.addValue(i, i - 1, lower);
+        if (i < n - 1) A.addValue(i, i + 1, upper);
+    }
+    A.finalize();
+    return A;
+}
+
+TEST(SolverMonitorTest, GMRESRecordsIterationsAndRestarts) {
+    const int n = 60;
+    SparseMatrixCSC<double> A = tridiagonal(n, -1.2, -0.8);
+    VectorObj<double> b(n, 1.0), x(n, 0.0);
+
+    SolverMonitor monitor;
+    GMRES<double, SparseMatrixCSC<double>> solver;
+    solver.setMonitor(monitor);
+    EXPECT_TRUE(solver.solve(A, b, x, 100, 10, 1e-10));
+    EXPECT_LT((b - A * x).L2norm(), 1e-8);
+
+    const auto& history = monitor.getHistory();
+    ASSERT_FALSE(history.empty());
+    EXPECT_EQ(history.front().event, SolverMonitor::Event::Restart);
+    EXPECT_EQ(history.back().event, SolverMonitor::Event::Converged);
+    EXPECT_GT(monitor.count(SolverMonitor::Event::Restart), 2);
+    EXPECT_EQ(monitor.count(SolverMonitor::Event::Converged), 1);
+    // The GMRES residual estimate is non-increasing within a cycle and time moves forward
+    for (size_t i = 1; i < history.size(); ++i) {
+        EXPECT_GE(history[i].seconds, history[i - 1].seconds);
+        if (history[i].event == SolverMonitor::Event::Iteration && history[i - 1].event == SolverMonitor::Event::Iteration) {
+            EXPECT_LE(history[i].residual, history[i - 1].residual * (1.0 + 1e-12));
+        }
+    }
+}
+
+TEST(SolverMonitorTest, GMRESReportsMaxIterations) {
+    const int n = 60;
+    SparseMatrixCSC<double> A = tridiagonal(n, -1.0, -1.0);
+    VectorObj<double> b(n, 1.0), x(n, 0.0);
+
+    SolverMonitor monitor;
+    GMRES<double, SparseMatrixCSC<double>> solver;
+    solver.setMonitor(monitor);
+    EXPECT_FALSE(solver.solve(A, b, x, 1, 3, 1e-12));
+    EXPECT_EQ(monitor.getHistory().back().event, SolverMonitor::Event::MaxIterations);
+    EXPECT_EQ(monitor.count(SolverMonitor::Event::Iteration), 3);
+}
+
+TEST(SolverMonitorTest, ConjugateGradientHistoryAndCallback) {
+    const int n = 50;
+    SparseMatrixCSC<double> A = tridiagonal(n, -1.0, -1.0);
+    VectorObj<double> b(n, 1.0), x(n, 0.0);
+
+    SolverMonitor monitor;
+    int calls = 0;
+    monitor.addCallback([&calls](const SolverMonitor::Record&) { ++calls; });
+    ConjugateGrad<double, SparseMatrixCSC<double>, VectorObj<double>> cg(A, b, 200, 1e-10);
+    cg.setMonitor(monitor);
+    ASSERT_TRUE(cg.solve(x));
+
+    const auto& history = monitor.getHistory();
+    EXPECT_EQ(calls, static_cast<int>(history.size()));
+    // Initial residual, one record per iteration and the final event
+    EXPECT_EQ(monitor.count(SolverMonitor::Event::Iteration), cg.getIterations() + 1);
+    EXPECT_DOUBLE_EQ(history.front().residual, b.L2norm());
+    EXPECT_DOUBLE_EQ(history.back().residual, cg.getResidualNorm());
+
+    // A second solve starts a fresh history
+    cg.solve(x);
+    EXPECT_EQ(static_cast<int>(monitor.getHistory().size()), cg.getIterations() + 2);
+}
+
+TEST(SolverMonitorTest, NewtonRecordsOuterSteps) {
+    // F(x) = (x0^2 - 4, x1^3 - 8), root (2, 2)
+    auto F = [](const VectorObj<double>& x) {
+        VectorObj<double> f(2);
+        f[0] = x[0] * x[0] - 4.0;
+        f[1] = x[1] * x[1] * x[1] - 8.0;
+        return f;
+    };
+    auto J = [](const VectorObj<double>& x) {
+        DenseObj<double> Jx(2, 2);
+        Jx(0, 0) = 2.0 * x[0];
+        Jx(1, 1) = 3.0 * x[1] * x[1];
+        return Jx;
+    };
+    NewtonMethod<double, DenseObj<double>> newton(1e-10, 50);
+    SolverMonitor outer, inner;
+    newton.setMonitor(outer);
+    newton.setLinearSolverMonitor(inner);
+    VectorObj<double> x(2, 3.0);
+    EXPECT_TRUE(newton.solve(x, F, J));
+    EXPECT_NEAR(x[0], 2.0, 1e-8);
+    EXPECT_NEAR(x[1], 2.0, 1e-8);
+
+    const auto& history = outer.getHistory();
+    ASSERT_GE(history.size(), 3u);
+    EXPECT_EQ(history.back().event, SolverMonitor::Event::Converged);
+    EXPECT_LT(history.back().residual, 1e-10);
+    EXPECT_FALSE(inner.getHistory().empty());
+}
+
+TEST(SolverMonitorTest, CSVAndJSONSinks) {
+    SolverMonitor monitor;
+    monitor.start();
+    monitor.record(SolverMonitor::Event::Iteration, 1, 0.5);
+    monitor.record(SolverMonitor::Event::Restart, 1, 0.25);
+    monitor.record(SolverMonitor::Event::MaxIterations, 1, std::nan(""));
+
+    std::ostringstream csv;
+    monitor.writeCSV(csv);
+    const std::string csvText = csv.str();
+    EXPECT_EQ(csvText.rfind("event,iteration,residual,seconds\n", 0), 0u);
+    EXPECT_NE(csvText.find("iteration,1,0.5,"), std::string::npos);
+    EXPECT_NE(csvText.find("restart,1,0.25,"), std::string::npos);
+
+    std::ostringstream json;
+    monitor.writeJSON(json);
+    const std::string jsonText = json.str();
+    EXPECT_EQ(jsonText.front(), '[');
+    EXPECT_NE(jsonText.find("{\"event\":\"restart\",\"iteration\":1,\"residual\":0.25,"), std::string::npos);
+    EXPECT_NE(jsonText.find("\"residual\":null"), std::string::npos);
+}
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
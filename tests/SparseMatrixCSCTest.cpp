@@ -1,6 +1,10 @@
 #include <gtest/gtest.h>
 #include "VectorObj.hpp"
 #include "SparseObj.hpp"
+#include <cmath>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 // Helper function to initialize matrices
 template <typename T>
@@ -63,6 +67,43 @@ TEST(SparseMatrixTest, MatrixVectorMultiplication) {
     EXPECT_EQ(result[2], 28.0); // 0*1 + 5*2 + 6*3
 }
 
+TEST(SparseMatrixTest, MatrixVectorMultiplicationIsReproducible) {
+    // Irregular pattern with many entries per row
+    const int n = 2000;
+    SparseMatrixCSC<double> mat(n, n);
+    for (int j = 0; j < n; ++j) {
+        for (int i = j % 7; i < n; i += 37 + j % 5) mat.addValue(i, j, std::sin(0.1 * i + 0.7 * j));
+    }
+    mat.finalize();
+    VectorObj<double> vec(n);
+    for (int i = 0; i < n; ++i) vec[i] = std::cos(0.3 * i);
+
+    // Row sums in column order, independent of the thread count
+    VectorObj<double> expected(n, 0.0);
+    for (int j = 0; j < n; ++j) {
+        for (int idx = mat.col_ptr[j]; idx < mat.col_ptr[j + 1]; ++idx) {
+            expected[mat.row_indices[idx]] += mat.values[idx] * vec[j];
+        }
+    }
+#ifdef _OPENMP
+    const int threads = omp_get_max_threads();
+    for (int t : {1, 2, 3, 8}) {
+        omp_set_num_threads(t);
+        VectorObj<double> result = mat * vec;
+        for (int i = 0; i < n; ++i) ASSERT_EQ(result[i], expected[i]);
+    }
+    omp_set_num_threads(threads);
+#else
+    VectorObj<double> result = mat * vec;
+    for (int i = 0; i < n; ++i) ASSERT_EQ(result[i], expected[i]);
+#endif
+
+    // In-place value updates keep the row index valid
+    mat *= 2.0;
+    VectorObj<double> doubled = mat * vec;
+    for (int i = 0; i < n; ++i) EXPECT_EQ(doubled[i], 2.0 * expected[i]);
+}
+
 TEST(SparseMatrixTest, MatrixMatrixMultiplication) {
     SparseMatrixCSC<double> matA(2, 3);
     matA.addValue(0, 0, 1.0);
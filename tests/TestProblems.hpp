@@ -0,0 +1,69 @@
+#ifndef TEST_PROBLEMS_HPP
+#define TEST_PROBLEMS_HPP
+
+#include <cmath>
+#include "SparseObj.hpp"
+#include "VectorObj.hpp"
+
+// Model matrices and right-hand sides shared by the solver and preconditioner tests
+namespace testproblems {
+    // Coefficients of a 5-point stencil; west/east couple i -+ 1, south/north couple j -+ 1
+    struct Stencil {
+        double center, west, east, south, north;
+    };
+
+    // 5-point operator on an m x m grid, unknown i + m j
+    inline SparseMatrixCSC<double> stencil2D(int m, const Stencil& s) {
+        const int n = m * m;
+        SparseMatrixCSC<double> A(n, n);
+        for (int j = 0; j < m; ++j) {
+            for (int i = 0; i < m; ++i) {
+                const int row = i + m * j;
+                A.addValue(row, row, s.center);
+                if (i > 0) A.addValue(row, row - 1, s.west);
+                if (i < m - 1) A.addValue(row, row + 1, s.east);
+                if (j > 0) A.addValue(row, row - m, s.south);
+                if (j < m - 1) A.addValue(row, row + m, s.north);
+            }
+        }
+        A.finalize();
+        return A;
+    }
+
+    // 5-point Laplacian (SPD) with an optional anisotropy epsY in y
+    inline SparseMatrixCSC<double> poisson2D(int m, double epsY = 1.0) {
+        return stencil2D(m, {2.0 + 2.0 * epsY, -1.0, -1.0, -epsY, -epsY});
+    }
+
+    // Convection-diffusion with central differences in x; nonsymmetric for convection != 0
+    inline SparseMatrixCSC<double> convectionDiffusion(int m, double convection, double shift = 0.0) {
+        return stencil2D(m, {4.0 + shift, -1.0 - convection, -1.0 + convection, -1.0, -1.0});
+    }
+
+    // Upwinded convection-diffusion with convection cx in x and cy in y; an M-matrix for
+    // cx, cy >= 0 that becomes convection-dominated as they grow
+    inline SparseMatrixCSC<double> upwindConvectionDiffusion(int m, double cx, double cy = 0.0, double shift = 0.0) {
+        return stencil2D(m, {4.0 + cx + cy + shift, -1.0 - cx, -1.0, -1.0 - cy, -1.0});
+    }
+
+    // 1D Laplacian (tridiagonal) plus shift on the diagonal; indefinite for shift in (-4, 0)
+    inline SparseMatrixCSC<double> poisson1D(int n, double shift = 0.0) {
+        SparseMatrixCSC<double> A(n, n);
+        for (int i = 0; i < n; ++i) {
+            A.addValue(i, i, 2.0 + shift);
+            if (i > 0) A.addValue(i, i - 1, -1.0);
+            if (i < n - 1) A.addValue(i, i + 1, -1.0);
+        }
+        A.finalize();
+        return A;
+    }
+
+    // Smooth, nonzero-mean right-hand side b_i = 1 + sin(frequency i + phase)
+    inline VectorObj<double> rhs(int n, double frequency = 0.3, double phase = 0.0) {
+        VectorObj<double> b(n);
+        for (int i = 0; i < n; ++i) b[i] = 1.0 + std::sin(frequency * i + phase);
+        return b;
+    }
+}
+
+#endif // TEST_PROBLEMS_HPP
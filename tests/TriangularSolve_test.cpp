@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include "TriangularSolve.hpp"
+#include "ILU.hpp"
+#include "ILUT.hpp"
+#include "SparseObj.hpp"
+#include "VectorObj.hpp"
+#include "TestProblems.hpp"
+#include <cmath>
+#include <vector>
+
+// Level i of a bidiagonal factor is row i; a diagonal factor is a single level
+TEST(TriangularSolveTest, LevelSetsOfSimplePatterns) {
+    const int n = 6;
+    std::vector<int> ptr(n + 1), idx;
+    for (int i = 0; i < n; ++i) {
+        if (i > 0) idx.push_back(i - 1);
+        ptr[i + 1] = static_cast<int>(idx.size());
+    }
+    sptrsv::LevelSets chain = sptrsv::analyze(n, ptr, idx, true);
+    EXPECT_EQ(chain.numLevels(), n);
+    for (int l = 0; l < n; ++l) EXPECT_EQ(chain.rows[chain.levelPtr[l]], l);
+
+    std::vector<int> emptyPtr(n + 1, 0), emptyIdx;
+    EXPECT_EQ(sptrsv::analyze(n, emptyPtr, emptyIdx, false).numLevels(), 1);
+}
+
+// The 5-point ILU(0) factors of an m x m grid have 2m - 1 wavefronts (anti-diagonals)
+TEST(TriangularSolveTest, WavefrontsOfGridFactors) {
+    const int m = 40;
+    ILUPreconditioner<double> ilu;
+    ilu.compute(testproblems::upwindConvectionDiffusion(m, 1.0));
+    EXPECT_EQ(ilu.getFactors().lowerLevels.numLevels(), 2 * m - 1);
+    EXPECT_EQ(ilu.getFactors().upperLevels.numLevels(), 2 * m - 1);
+}
+
+// All schedules reproduce the sequential substitution, for ILU(k) and for ILUT
+TEST(TriangularSolveTest, SchedulesAgree) {
+    const int m = 160;
+    SparseMatrixCSC<double> A = testproblems::upwindConvectionDiffusion(m, 2.0);
+    VectorObj<double> b = testproblems::rhs(A.getRows());
+
+    ILUPreconditioner<double> ilu(1);
+    ilu.compute(A);
+    ilu.setTriangularSchedule(sptrsv::Schedule::Sequential);
+    const VectorObj<double> reference = ilu.solve(b);
+    for (auto schedule : {sptrsv::Schedule::LevelSet, sptrsv::Schedule::SyncFree}) {
+        ilu.setTriangularSchedule(schedule);
+        VectorObj<double> x = ilu.solve(b);
+        EXPECT_LT((x - reference).L2norm(), 1e-12 * reference.L2norm());
+    }
+
+    ILUTPreconditioner<double> ilut(1e-3, 8);
+    ilut.compute(A);
+    ilut.setTriangularSchedule(sptrsv::Schedule::Sequential);
+    const VectorObj<double> referenceT = ilut.solve(b);
+    for (auto schedule : {sptrsv::Schedule::LevelSet, sptrsv::Schedule::SyncFree}) {
+        ilut.setTriangularSchedule(schedule);
+        VectorObj<double> x = ilut.solve(b);
+        EXPECT_LT((x - referenceT).L2norm(), 1e-12 * referenceT.L2norm());
+    }
+}
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -107,6 +107,46 @@ TEST_F(MyTest, QrFactorizationTest) {
     }
 }
 
+TEST(TriangularSolveTest, MultipleRightHandSides) {
+    const int n = 6, k = 5;
+    DenseObj<double> L(n, n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j <= i; ++j) {
+            L(i, j) = (i == j) ? 2.0 + i : 0.1 * (i + j + 1);
+        }
+    }
+    DenseObj<double> U = L.Transpose();
+    DenseObj<double> B(n, k);
+    for (int r = 0; r < k; ++r) {
+        for (int i = 0; i < n; ++i) {
+            B(i, r) = std::sin(i + 3.0 * r);
+        }
+    }
+
+    DenseObj<double> X = basic::TriangularSolve(L, B, true);
+    DenseObj<double> Y = basic::TriangularSolve(U, B, false);
+
+    // Each column matches the single right-hand side substitution
+    for (int r = 0; r < k; ++r) {
+        VectorObj<double> x = basic::Substitution<double, DenseObj<double>>(B.getColumn(r), L, true);
+        VectorObj<double> y = basic::Substitution<double, DenseObj<double>>(B.getColumn(r), U, false);
+        for (int i = 0; i < n; ++i) {
+            ASSERT_NEAR(X(i, r), x[i], 1e-12);
+            ASSERT_NEAR(Y(i, r), y[i], 1e-12);
+        }
+    }
+
+    // Solve in place on a block of a larger matrix
+    DenseObj<double> big(n + 2, k);
+    big.view(2, 0, n, k).assign(B.view(0, 0, n, k));
+    const DenseObj<double>& cL = L;
+    basic::TriangularSolve(cL.view(0, 0, n, n), big.view(2, 0, n, k), true);
+    ASSERT_NEAR(big(2 + n - 1, k - 1), X(n - 1, k - 1), 1e-12);
+
+    L(3, 3) = 0.0;
+    ASSERT_THROW(basic::TriangularSolve(L, B, true), std::runtime_error);
+}
+
 } // namespace
 
 int main(int argc, char **argv) {
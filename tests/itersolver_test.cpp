@@ -68,6 +68,37 @@ TEST(StaticIterMethodTest, JacobiMethodConvergence) {
     EXPECT_NEAR(x[2], 0.375, 1e-5);
 }
 
+// A fixed sweep count that runs out is reported through the return value and the monitor, not stdout
+TEST(StaticIterMethodTest, SweepLimitIsSilent) {
+    SparseMatrixCSC<double> A(3, 3);
+    A.addValue(0, 0, 4);
+    A.addValue(1, 0, -1);
+    A.addValue(0, 1, -1);
+    A.addValue(1, 1, 4);
+    A.addValue(2, 1, -1);
+    A.addValue(1, 2, -1);
+    A.addValue(2, 2, 4);
+    A.finalize();
+
+    VectorObj<double> b(3);
+    b[0] = 1.0;
+    b[1] = 5.0;
+    b[2] = 0.0;
+    VectorObj<double> x(3, 0.0);
+
+    SolverMonitor monitor;
+    SOR<double, SparseMatrixCSC<double>, VectorObj<double>> solver(A, b, 2);
+    solver.setMonitor(monitor);
+
+    testing::internal::CaptureStdout();
+    const bool converged = solver.solve(x);
+    EXPECT_TRUE(testing::internal::GetCapturedStdout().empty());
+
+    EXPECT_FALSE(converged);
+    EXPECT_EQ(monitor.count(SolverMonitor::Event::Iteration), 2);
+    EXPECT_EQ(monitor.count(SolverMonitor::Event::MaxIterations), 1);
+}
+
 // Test for Early Stopping in GradientDescent due to convergence check
 TEST(GradientDescentSolverTest, ConvergenceCheckEarlyStopping) {
     // Setup: Create a mock sparse A.addValue and a vector b
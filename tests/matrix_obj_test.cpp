@@ -129,6 +129,59 @@ TEST_F(DenseObjTest, GetColumn) {
     }
 }
 
+// Test that a view refers to a block of the matrix without copying
+TEST_F(DenseObjTest, SubMatrixView) {
+    DenseView<double> block = matrix1.view(0, 1, 2, 2);
+    ASSERT_EQ(block.getRows(), 2);
+    ASSERT_EQ(block.getCols(), 2);
+    EXPECT_EQ(block.ld(), matrix1.getRows());
+    EXPECT_EQ(block(1, 1), matrix1(1, 2));
+
+    block(0, 0) = -7.0;
+    EXPECT_EQ(matrix1(0, 1), -7.0);
+    EXPECT_EQ(block.data(), &matrix1(0, 1));
+
+    DenseView<double> inner = block.view(1, 0, 1, 2);
+    EXPECT_EQ(inner(0, 1), matrix1(1, 2));
+
+    EXPECT_THROW(matrix1.view(1, 1, 2, 2), std::out_of_range);
+    EXPECT_THROW(block(2, 0), std::out_of_range);
+}
+
+// Test BLAS operations on views with a leading dimension larger than the row count
+TEST_F(DenseObjTest, ViewMultiplication) {
+    DenseObj<double> big(4, 4);
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            big(i, j) = i + 10 * j;
+        }
+    }
+    const DenseObj<double>& cbig = big;
+    DenseView<const double> A = cbig.view(1, 1, 2, 3);
+    DenseObj<double> Acopy = A.toDense();
+
+    DenseObj<double> B = A * matrix3;
+    DenseObj<double> expected = Acopy * matrix3;
+    for (int i = 0; i < 2; ++i) {
+        for (int j = 0; j < 2; ++j) {
+            EXPECT_DOUBLE_EQ(B(i, j), expected(i, j));
+        }
+    }
+
+    VectorObj<double> x(3, 1.0);
+    VectorObj<double> y = A * x;
+    EXPECT_DOUBLE_EQ(y[0], 11 + 21 + 31);
+    EXPECT_DOUBLE_EQ(y[1], 12 + 22 + 32);
+
+    DenseObj<double> At = A.Transpose();
+    EXPECT_EQ(At.getRows(), 3);
+    EXPECT_DOUBLE_EQ(At(2, 1), big(2, 3));
+
+    big.view(0, 0, 2, 3).assign(A);
+    EXPECT_DOUBLE_EQ(big(0, 0), Acopy(0, 0));
+    EXPECT_DOUBLE_EQ(big(1, 2), Acopy(1, 2));
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
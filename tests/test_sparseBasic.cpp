@@ -107,6 +107,49 @@ TEST_F(SparseBasicTest, SingleElementTest) {
     EXPECT_NEAR(b[0], 2.0, 1e-10);
 }
 
+TEST_F(SparseBasicTest, MultiRHSTriangularSolveTest) {
+    // Non-unit lower factor and its transpose
+    SparseMatrixCSC<double> Lnu(3, 3);
+    Lnu.values = {2.0, 4.0, 6.0, 3.0, 3.0, 5.0};
+    Lnu.row_indices = {0, 1, 2, 1, 2, 2};
+    Lnu.col_ptr = {0, 3, 5, 6};
+    SparseMatrixCSC<double> U = Lnu.Transpose();
+
+    const int k = 40;
+    DenseObj<double> B(3, k);
+    for (int r = 0; r < k; ++r) {
+        for (int i = 0; i < 3; ++i) {
+            B(i, r) = 1.0 + i + 0.5 * r;
+        }
+    }
+
+    DenseObj<double> X = B;
+    SparseLA::TriangularSolve(Lnu, X, true);
+    DenseObj<double> Y = B;
+    SparseLA::TriangularSolve(U, Y, false);
+
+    for (int r = 0; r < k; ++r) {
+        for (int i = 0; i < 3; ++i) {
+            double lx = 0.0, uy = 0.0;
+            for (int j = 0; j < 3; ++j) {
+                lx += Lnu(i, j) * X(j, r);
+                uy += U(i, j) * Y(j, r);
+            }
+            EXPECT_NEAR(lx, B(i, r), 1e-12);
+            EXPECT_NEAR(uy, B(i, r), 1e-12);
+        }
+    }
+
+    // Unit-diagonal variant agrees with the single right-hand side LSolve
+    DenseObj<double> Z = B;
+    SparseLA::TriangularSolve(L, Z, true, true);
+    VectorObj<double> z = B.getColumn(7);
+    SparseLA::LSolve(L, z);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_NEAR(Z(i, 7), z[i], 1e-12);
+    }
+}
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();